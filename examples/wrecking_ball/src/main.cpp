@@ -100,8 +100,8 @@ private:
         // Let's link the chain parts one after another.
         for (unsigned int i = 0; i < chain - 1; ++i)
         {
-            auto* cLink = m_crane->getChildren()[i].getComponent<jop::RigidBody>();
-            auto* nLink = m_crane->getChildren()[i + 1].getComponent<jop::RigidBody>();
+            auto* cLink = m_crane->getChildren()[i]->getComponent<jop::RigidBody>();
+            auto* nLink = m_crane->getChildren()[i + 1]->getComponent<jop::RigidBody>();
 
             cLink->link<jop::RopeJoint>(*nLink, false);
         }
@@ -113,10 +113,10 @@ private:
         wrBall->createComponent<jop::RigidBody>(getWorld<3>(), wrballInfo);
 
         // Connect the static body to the beginning of the chain.
-        m_crane->getComponent<jop::RigidBody>()->link<jop::RopeJoint>(*m_crane->getChildren().begin()->getComponent<jop::RigidBody>(), true);
+        m_crane->getComponent<jop::RigidBody>()->link<jop::RopeJoint>(*m_crane->getChildren().front()->getComponent<jop::RigidBody>(), true);
 
         // And finally connect the end of the chain to the wrecking ball.
-        m_crane->getChildren().back().getComponent<jop::RigidBody>()->link<jop::RopeJoint>(*wrBall->getComponent<jop::RigidBody>(), true);
+        m_crane->getChildren().back()->getComponent<jop::RigidBody>()->link<jop::RopeJoint>(*wrBall->getComponent<jop::RigidBody>(), true);
     }
 
 public:
@@ -156,9 +156,9 @@ public:
     void preUpdate(const float /* deltaTime */) override
     {
         // We'll delete all the pieces of wall that drop off from the ground plate
-        for (auto itr = m_house->getChildren().begin(); itr != m_house->getChildren().end(); ++itr)
-            if (itr->getGlobalPosition().y < -10.f)
-                itr->removeSelf();
+        for (auto child : m_house->getChildren())
+            if (child->getGlobalPosition().y < -10.f)
+                child->removeSelf();
     }
 };
 
@@ -23,10 +23,12 @@
 
 // Headers
 #include <Jopnal/Core/Component.hpp>
+#include <Jopnal/Core/ComponentRegistry.hpp>
 #include <Jopnal/Core/DebugHandler.hpp>
 #include <Jopnal/Core/Engine.hpp>
 #include <Jopnal/Core/FileLoader.hpp>
 #include <Jopnal/Core/Object.hpp>
+#include <Jopnal/Core/Profiler.hpp>
 #include <Jopnal/Core/Resource.hpp>
 #include <Jopnal/Core/ResourceManager.hpp>
 #include <Jopnal/Core/Scene.hpp>
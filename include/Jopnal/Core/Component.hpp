@@ -26,6 +26,7 @@
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Utility/SafeReferenceable.hpp>
 #include <Jopnal/Utility/Message.hpp>
+#include <vector>
 
 //////////////////////////////////////////////
 
@@ -33,6 +34,8 @@
 namespace jop
 {
     class Object;
+    class Scene;
+    class ComponentRegistry;
 
     class JOP_API Component
     {
@@ -41,6 +44,8 @@ namespace jop
         JOP_DISALLOW_COPY_MOVE(Component);
 
         friend class Object;
+        friend class Scene;
+        friend class ComponentRegistry;
 
         /// \brief Clone function
         ///
@@ -93,10 +98,28 @@ namespace jop
 
         /// \brief Update function
         ///
+        /// Components whose type doesn't override this are never updated.
+        ///
         /// \param deltaTime The delta time
         ///
         virtual void update(const float deltaTime);
 
+        /// \brief Enable/disable updating
+        ///
+        /// Components that only need updating occasionally, for example
+        /// when playing, can disable updates while idle. Updating is enabled
+        /// by default.
+        ///
+        /// \param enabled True to enable
+        ///
+        void setUpdateEnabled(const bool enabled);
+
+        /// \brief Check if updating is enabled
+        ///
+        /// \return True if enabled
+        ///
+        bool isUpdateEnabled() const;
+
         /// \brief Get the identifier
         ///
         /// \return The identifier
@@ -111,6 +134,14 @@ namespace jop
         ///
         void setID(const uint32 ID);
 
+        /// \brief Get the type identifier
+        ///
+        /// \return The type identifier. ComponentRegistry::InvalidType if the type is not known
+        ///
+        /// \see ComponentRegistry
+        ///
+        uint32 getTypeID() const;
+
         /// \brief Get the object this component is bound to
         ///
         /// \return Reference to the object
@@ -152,6 +183,11 @@ namespace jop
     private:
 
         uint32 m_ID;                        ///< Identifier
+        uint32 m_typeID;                    ///< Type identifier
+        uint32 m_typeIndex;                 ///< Index in the component list of the type
+        std::vector<Component*>* m_batch;   ///< Scene update list this component is in
+        uint32 m_batchIndex;                ///< Index in the scene update list
+        bool m_updateEnabled;               ///< Is updating enabled?
         WeakReference<Object> m_objectRef;  ///< Reference to the object this component is bound to
     };
 }
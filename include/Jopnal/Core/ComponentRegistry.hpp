@@ -0,0 +1,206 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_COMPONENTREGISTRY_HPP
+#define JOP_COMPONENTREGISTRY_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <Jopnal/Core/Component.hpp>
+#include <atomic>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    namespace detail
+    {
+        // Does T override Component::update()? If it can't be determined,
+        // for example because the override isn't public, assume that it does
+        template<typename T>
+        struct OverridesUpdate
+        {
+            template<typename U>
+            static std::integral_constant<bool, !std::is_same<decltype(&U::update), void (Component::*)(float)>::value> test(int);
+
+            template<typename U>
+            static std::true_type test(...);
+
+            static const bool value = decltype(test<T>(0))::value;
+        };
+    }
+
+    /// \brief Component type registry
+    ///
+    /// Every concrete component type is given a small integer identifier the
+    /// first time it's used. Components created with Object::createComponent(),
+    /// or cloned by Object, store the identifier of their type, so that typed
+    /// lookups don't need RTTI. The registry also keeps a dense list of the
+    /// live components of each type.
+    ///
+    class JOP_API ComponentRegistry
+    {
+    private:
+
+        JOP_DISALLOW_COPY_MOVE(ComponentRegistry);
+
+    public:
+
+        enum : uint32
+        {
+            InvalidType = 0,    ///< Type of components whose type is not known
+            MaxTypes    = 1024  ///< Maximum amount of component types
+        };
+
+    public:
+
+        /// \brief Get the identifier of a component type
+        ///
+        /// The type is registered the first time this is called.
+        ///
+        /// \param info Type info of the component type
+        ///
+        /// \return The type identifier. InvalidType if MaxTypes has been reached
+        ///
+        static uint32 getTypeID(const std::type_info& info);
+
+        /// \copydoc getTypeID(const std::type_info&)
+        ///
+        template<typename T>
+        static uint32 getTypeID()
+        {
+            static_assert(std::is_base_of<Component, T>::value, "ComponentRegistry::getTypeID(): T doesn't inherit from jop::Component");
+
+            typedef typename std::remove_cv<T>::type Type;
+
+            static const uint32 ID = registerType(typeid(Type), detail::OverridesUpdate<Type>::value);
+            return ID;
+        }
+
+        /// \brief Check if a component is of the given type, or derives from it
+        ///
+        /// Equivalent to a dynamic_cast, but the result for each pair of
+        /// types is only resolved once.
+        ///
+        /// \param component The component to check
+        ///
+        /// \return True if the component is a T
+        ///
+        template<typename T>
+        static bool isA(const Component& component)
+        {
+            typedef typename std::remove_cv<T>::type Type;
+
+            if (std::is_same<Type, Component>::value)
+                return true;
+
+            const uint32 target = getTypeID<Type>();
+            const uint32 type = component.getTypeID();
+
+            if (type == target)
+                return true;
+
+            if (type == InvalidType || target == InvalidType)
+                return dynamic_cast<const Type*>(&component) != nullptr;
+
+            uint8 relation = getRelation(target, type);
+
+            if (relation == Unresolved)
+            {
+                relation = dynamic_cast<const Type*>(&component) != nullptr ? Derived : Unrelated;
+                setRelation(target, type, relation);
+            }
+
+            return relation == Derived;
+        }
+
+        /// \brief Check if a component needs to be updated every frame
+        ///
+        /// A component is not updated if its type doesn't override Component::update(),
+        /// or if it has been disabled with Component::setUpdateEnabled().
+        ///
+        /// \param component The component to check
+        ///
+        /// \return True if the component needs updating
+        ///
+        static bool needsUpdate(const Component& component)
+        {
+            return component.isUpdateEnabled() && !ms_skipUpdate[component.getTypeID()].load(std::memory_order_relaxed);
+        }
+
+        /// \brief Get all the live components of a type
+        ///
+        /// The components are stored contiguously, in no particular order.
+        /// Only components of exactly this type are included. The list
+        /// covers all scenes.
+        ///
+        /// Must not be called while components are being created or destroyed
+        /// on other threads.
+        ///
+        /// \param type The type identifier
+        ///
+        /// \return Reference to the internal list
+        ///
+        static const std::vector<Component*>& getComponents(const uint32 type);
+
+        /// \copydoc getComponents(const uint32)
+        ///
+        template<typename T>
+        static const std::vector<Component*>& getComponents()
+        {
+            return getComponents(getTypeID<T>());
+        }
+
+    private:
+
+        friend class Component;
+        friend class Object;
+
+        enum : uint8
+        {
+            Unresolved,
+            Derived,
+            Unrelated
+        };
+
+        static uint32 registerType(const std::type_info& info, const bool overridesUpdate);
+
+        static void bind(Component& component, const uint32 type);
+
+        static void unbind(Component& component);
+
+        static uint8 getRelation(const uint32 target, const uint32 type);
+
+        static void setRelation(const uint32 target, const uint32 type, const uint8 relation);
+
+
+        static std::atomic<bool> ms_skipUpdate[MaxTypes];   ///< Types whose update() does nothing
+    };
+}
+
+/// \class jop::ComponentRegistry
+/// \ingroup core
+
+#endif
\ No newline at end of file
@@ -104,13 +104,24 @@ namespace jop
         ///
         /// The main loop will run until exit() is called.
         ///
+        /// The frame rate is limited to engine@DefaultWindow|uFrameLimit
+        /// (0 = unlimited), or to engine@Time|uRenderOnlyFrameLimit in the
+        /// RenderOnly state, if set. When frozen, engine@Time|uIdleFrameLimit
+        /// is used instead. engine@Time|uUnfocusedFrameLimit (0 = off) can be
+        /// set to also throttle while the main window doesn't have focus. This
+        /// never applies to a main window that was created invisible. If
+        /// engine@Time|bWaitEventsWhenIdle is set, throttled frames wait for
+        /// window events instead of sleeping.
+        ///
         /// \return An integer return value. To be used as the main() return value
         ///
         static int runMainLoop();
 
         /// \brief Advance a single frame
         ///
-        /// When state is Running, this function has no effect.
+        /// When state is Running, this function has no effect. With a fixed
+        /// time step, exactly one tick is simulated. Time doesn't accumulate
+        /// while not running, so there are no ticks to catch up with later.
         ///
         static void advanceFrame();
 
@@ -312,6 +323,72 @@ namespace jop
         ///
         static float getDeltaTimeUnscaled();
 
+        /// \brief Check if the simulation runs at a fixed time step
+        ///
+        /// When enabled (engine@Time|bFixedTimestep), the scenes are updated zero
+        /// or more times per frame, always with the same delta time. The rate is
+        /// set with engine@Time|uUpdateFrequency. The subsystem update stages are
+        /// still run once per frame, with the frame time. Object
+        /// transformations are interpolated between the last two updates for
+        /// drawing, unless engine@Time|bInterpolation is false.
+        ///
+        /// \return True if the fixed time step is used
+        ///
+        static bool fixedTimestepEnabled();
+
+        /// \brief Get the fixed time step
+        ///
+        /// \return The fixed time step in seconds. 0 if the fixed time step is not used
+        ///
+        static float getFixedTimestep();
+
+        /// \brief Get the interpolation factor of the current frame
+        ///
+        /// This is the fraction of the fixed time step that has accumulated
+        /// but not yet been simulated.
+        ///
+        /// \return The interpolation factor, between 0 and 1
+        ///
+        static float getInterpolationAlpha();
+
+        /// \brief Get the amount of skipped updates
+        ///
+        /// When a frame would need more than engine@Time|uMaxUpdatesPerFrame
+        /// updates to catch up, the rest of the accumulated time is dropped.
+        ///
+        /// \return The total amount of updates skipped
+        ///
+        static unsigned int getSkippedUpdates();
+
+        /// \brief Check if the simulation is run on its own thread
+        ///
+        /// When enabled (engine@Threading|bPipelinedSimulation), the next frame
+        /// is simulated on ThreadPool::getDefault() while the render thread
+        /// finishes the current one. The subsystem stages are run on the thread
+        /// given by their affinity, see Subsystem::Affinity.
+        ///
+        /// The scenes are only drawn while the simulation is stopped, so no
+        /// state needs to be copied. Only the stages with the Concurrent affinity,
+        /// which by default is just the buffer swap, overlap with the simulation.
+        /// The gain is therefore limited to the time spent presenting the frame.
+        ///
+        /// The simulation thread has no graphics context. Making OpenGL calls
+        /// during the update, directly or by creating or modifying graphics
+        /// resources (for example Text::setString() or loading a texture), is
+        /// not supported when this is enabled. Debug builds assert on them.
+        ///
+        /// \return True if the simulation is pipelined
+        ///
+        static bool pipelinedSimulationEnabled();
+
+        /// \brief Check if the calling thread is running the pipelined simulation
+        ///
+        /// \return True if called from the simulation thread
+        ///
+        /// \see pipelinedSimulationEnabled()
+        ///
+        static bool isSimulationThread();
+
     private:
 
         static Engine* m_engineObject;                          ///< The single Engine instance
@@ -319,6 +396,10 @@ namespace jop
         std::vector<std::unique_ptr<Subsystem>> m_subsystems;   ///< A vector containing the subsystems
         std::atomic<double> m_totalTime;                        ///< The total time
         std::atomic<float> m_deltaTimeUnscaled;                 ///< Current delta time
+        std::atomic<float> m_fixedTimestep;                     ///< Fixed time step, 0 if not used
+        std::atomic<float> m_interpolationAlpha;                ///< Interpolation factor of the current frame
+        std::atomic<unsigned int> m_skippedUpdates;             ///< Total amount of skipped updates
+        std::atomic<bool> m_pipelined;                          ///< Is the simulation run on its own thread?
         std::unique_ptr<Scene> m_currentScene;                  ///< The current scene
         std::atomic<Scene*> m_newScene;                         ///< Temporary new scene pointer
         std::atomic<bool> m_newSceneSignal;                     ///< Was the new scene signaled?
@@ -29,7 +29,7 @@ namespace detail
 
         for (auto& i : comps)
         {
-            if ((ID == nullptr || i->getID() == *ID) && dynamic_cast<T*>(i.get()) != nullptr)
+            if ((ID == nullptr || i->getID() == *ID) && ::jop::ComponentRegistry::isA<T>(*i))
                 return static_cast<T*>(i.get());
         }
 
@@ -71,6 +71,8 @@ T& Object::createComponent(Args&&... args)
     static_assert(std::is_base_of<Component, T>::value, "Object::createComponent(): Tried to create a component that doesn't inherit from jop::Component");
     
     m_components.emplace_back(std::make_unique<T>(*this, std::forward<Args>(args)...));
+    ComponentRegistry::bind(*m_components.back(), ComponentRegistry::getTypeID<T>());
+
     return static_cast<T&>(*m_components.back());
 }
 
@@ -102,7 +104,9 @@ Object& Object::removeComponent(const uint32 ID)
 {
     for (auto itr = m_components.begin(); itr != m_components.end(); ++itr)
     {
-        if (typeid(*(*itr)) == typeid(T) && itr->get()->getID() == ID)
+        const uint32 type = (*itr)->getTypeID();
+
+        if ((type == ComponentRegistry::InvalidType ? typeid(*(*itr)) == typeid(T) : type == ComponentRegistry::getTypeID<T>()) && itr->get()->getID() == ID)
         {
             m_components.erase(itr);
             break;
@@ -129,6 +129,8 @@ T& ResourceManager::getNamed(const std::string& name, Args&&... args)
         Clock clk;
     #endif
 
+        const detail::ResourceLoadScope scope(name);
+
         auto res = std::make_unique<T>(name);
 
         if (res->load(std::forward<Args>(args)...))
@@ -25,11 +25,14 @@
 // Headers
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Core/Component.hpp>
+#include <Jopnal/Core/ComponentRegistry.hpp>
 #include <Jopnal/Core/SerializeInfo.hpp>
 #include <Jopnal/Utility/SafeReferenceable.hpp>
 #include <Jopnal/Graphics/Transform.hpp>
 #include <Jopnal/STL.hpp>
-#include <unordered_set>
+#include <atomic>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -40,6 +43,11 @@ namespace jop
 {
     class Scene;
 
+    namespace detail
+    {
+        class TransformHierarchy;
+    }
+
     class JOP_API Object : public SafeReferenceable<Object>, public SerializeInfo
     {
     private:
@@ -48,10 +56,16 @@ namespace jop
 
         friend class SceneLoader;
         friend class Component;
+        friend class Scene;
+        friend class detail::TransformHierarchy;
+
+        struct PathCache;
+        struct ChildCursor;
 
         enum Flag : uint32
         {
             ActiveFlag          = 1,
+            TickStateFlag       = 1 << 1,
             RemoveFlag          = 1 << 2,
             ChildrenRemovedFlag = 1 << 3,
 
@@ -216,6 +230,10 @@ namespace jop
 
         /// \brief Create a new child
         ///
+        /// During a parallel update, if this object is outside of the subtree being
+        /// updated, the child is added at the end of the update. The returned reference
+        /// is valid immediately.
+        ///
         /// \param ID Id for the new child object
         ///
         /// \return Reference to the newly created child
@@ -226,12 +244,13 @@ namespace jop
 
         /// \brief Adopt a child
         ///
-        /// This will move the child onto this object and remove it from its old parent.
+        /// This will relink the child onto this object and remove it from its old parent.
+        /// The child is not moved in memory, so existing references to it stay valid.
         /// If the child's parent is equal to this, this function does nothing.
         ///
         /// \param child The child to adopt
         ///
-        /// \return Reference to the adopted child. The old reference will become invalid
+        /// \return Reference to the adopted child
         ///
         /// \comm adoptChild
         ///
@@ -239,13 +258,11 @@ namespace jop
 
         /// \brief Get all children
         ///
-        /// \return Reference to the internal vector with the children
+        /// The children have stable addresses.
         ///
-        std::vector<Object>& getChildren();
-
-        /// \copydoc getChildren()
+        /// \return Reference to the internal vector with pointers to the children
         ///
-        const std::vector<Object>& getChildren() const;
+        const std::vector<Object*>& getChildren() const;
 
         /// \brief Clone a child with the given id
         ///
@@ -314,6 +331,8 @@ namespace jop
         /// \brief Mark this to be removed
         ///
         /// The object will be actually removed at the beginning of the next update call.
+        /// During a parallel update, the object is only marked at the end of the update
+        /// if it or its parent is outside of the subtree being updated.
         ///
         /// \comm removeSelf
         ///
@@ -378,7 +397,7 @@ namespace jop
         ///
         /// \param newParent The new parent
         ///
-        /// \return Reference to this. The old reference will become invalid
+        /// \return Reference to this
         ///
         /// \comm setParent
         ///
@@ -401,6 +420,11 @@ namespace jop
         ///
         /// The message will be forwarded to children and components.
         ///
+        /// When the message has an exact id or tag filter, the objects it's
+        /// meant for are looked up from the identifier and tag indices, instead
+        /// of visiting the whole tree. In this case the objects receive the
+        /// message before any components do.
+        ///
         /// \param message The message
         ///
         /// \return The message result
@@ -409,6 +433,11 @@ namespace jop
 
         /// \brief Find a child
         ///
+        /// Object identifiers are interned, so strict searches only compare integers.
+        /// Recursive strict searches use the identifier index when it's enabled
+        /// (engine@Scene|bObjectIDIndex). Either way, the first matching descendant
+        /// in depth-first order is returned.
+        ///
         /// \param ID Object identifier
         /// \param recursive Search recursively?
         /// \param strict Does the ID have to match exactly?
@@ -420,6 +449,8 @@ namespace jop
         /// \brief Find all children matching the criteria
         ///
         /// When ID is empty and strict is false, all children will be returned.
+        /// Recursive strict searches use the identifier index when it's enabled,
+        /// in which case the children are returned in no particular order.
         /// 
         /// \param ID Object identifier
         /// \param recursive Search recursively?
@@ -431,7 +462,11 @@ namespace jop
 
         /// \brief Find children with a tag
         ///
-        /// \param tag Object identifier
+        /// Recursive searches are done using the tag index, so their cost depends
+        /// on the amount of objects with the tag rather than the size of the tree.
+        /// The children are then returned in no particular order.
+        ///
+        /// \param tag The tag to search with
         /// \param recursive Search recursively?
         ///
         /// \return Vector with all the found children, empty if none were found
@@ -439,6 +474,9 @@ namespace jop
         std::vector<WeakReference<Object>> findChildrenWithTag(const std::string& tag, const bool recursive) const;
 
         /// \brief Find child with a search path
+        ///
+        /// Resolved paths are cached. The cache is invalidated when any object
+        /// is reparented or has its identifier changed.
         /// 
         /// \param path Search path
         ///
@@ -534,6 +572,44 @@ namespace jop
         ///
         bool hasTag(const std::string& tag) const;
 
+        /// \brief Get the tags of this object
+        ///
+        /// \return Reference to the internal vector with the tag identifiers, in ascending order
+        ///
+        /// \see getTagID()
+        ///
+        const std::vector<uint32>& getTags() const;
+
+        /// \brief Get the identifier of a tag
+        ///
+        /// Tags are interned, so that objects only need to store and compare
+        /// integers. The tag is interned the first time this is called.
+        ///
+        /// \param tag The tag
+        ///
+        /// \return The tag identifier
+        ///
+        static uint32 getTagID(const std::string& tag);
+
+        /// \brief Get a tag by its identifier
+        ///
+        /// \param ID The tag identifier
+        ///
+        /// \return Reference to the tag. Empty string if the identifier is not valid
+        ///
+        static const std::string& getTagName(const uint32 ID);
+
+        /// \brief Get the key of an identifier
+        ///
+        /// Identifiers are interned like tags. The identifier is interned
+        /// the first time this is called.
+        ///
+        /// \param ID The identifier
+        ///
+        /// \return The identifier key
+        ///
+        static uint32 getIDKey(const std::string& ID);
+
         /// \brief Update
         ///
         /// This is for internal use.
@@ -542,6 +618,35 @@ namespace jop
         ///
         void update(const float deltaTime);
 
+        /// \brief Update the children in parallel
+        ///
+        /// This is for internal use.
+        ///
+        /// The components of this object are updated first. Then each child subtree
+        /// is updated as a task on ThreadPool::getDefault(). Structural changes
+        /// (createChild(), adoptChild(), removeSelf(), cloneSelf(), cloneChild(),
+        /// clearChildren() & reserveChildren()) targeting objects outside the subtree
+        /// being updated are recorded and applied in order after all the subtrees are
+        /// done, so the result doesn't depend on the thread timing. Objects and
+        /// components destroyed during the update are kept alive until then as well.
+        ///
+        /// \param deltaTime The delta time
+        ///
+        void updateParallel(const float deltaTime);
+
+        /// \brief Call a function once it's safe to modify systems shared by the scene
+        ///
+        /// During a parallel update (see updateParallel()) the function is called
+        /// in order with the other deferred changes. Otherwise it's called immediately.
+        /// Components use this to register themselves to the renderer, the physics
+        /// world and other systems that mustn't be modified from several threads.
+        ///
+        /// If this object is destroyed before then, the function is not called.
+        ///
+        /// \param func The function to call
+        ///
+        void runSerial(std::function<void()> func) const;
+
         /// \brief Print the tree of objects into the console, this object as root
         ///
         void printDebugTree() const;
@@ -550,6 +655,10 @@ namespace jop
 
         /// \brief Get the transform
         ///
+        /// The world matrices of the objects in a scene are recomputed in one
+        /// batched pass per frame, before drawing. If the matrix is needed
+        /// before that, it's computed here.
+        ///
         /// \return Reference to the internal transform
         ///
         const Transform& getTransform() const;
@@ -880,6 +989,18 @@ namespace jop
 
         void sweepRemoved();
 
+        static void destroyComponent(std::unique_ptr<Component> component);
+
+        void gatherUpdates(std::deque<std::vector<Component*>>& lists, std::vector<uint32>& order);
+
+        void storeTickState();
+
+        void interpolateTransforms(const float alpha, std::vector<std::pair<Object*, Transform::Variables>>& saved);
+
+        static void restoreTransforms(std::vector<std::pair<Object*, Transform::Variables>>& saved);
+
+        WeakReference<Object> stageChild(Object& staged);
+
         bool flagSet(const uint32 flag) const;
 
         void setFlags(const uint32 flags) const;
@@ -890,18 +1011,48 @@ namespace jop
 
         void propagateFlags(const uint32 flags);
 
+        void resolveTransform(const glm::mat4* parentMatrix) const;
+
+        void insertTag(const uint32 tag);
+
+        void unlinkTag(const std::size_t pos);
+
+        void linkID(const uint32 key);
+
+        void unlinkID();
+
+        Object* findChildByKey(const uint32 key, const bool recursive) const;
+
+        void findChildrenByKey(const uint32 key, const bool recursive, std::vector<WeakReference<Object>>& found) const;
+
+        bool passIDFilter(const Message& message) const;
+
+        Message::Result sendTreeMessage(const Message& message);
+
+        Message::Result sendIndexedMessage(const Message& message);
+
+        Message::Result sendComponentMessage(const Message& message);
+
 
         // Transformation
         mutable Transform m_transform;
         mutable Transform m_inverseTransform;
         mutable Transform::Variables m_locals;
         mutable Transform::Variables m_globals;
+        Transform::Variables m_tickLocals;                      ///< Local transformation at the start of the last fixed update
+        detail::TransformHierarchy* m_hierarchy;                ///< Transform layout of the scene this object is in
+        uint32 m_hierarchySlot;                                 ///< Position of this object in the layout
 
         // Object
-        std::vector<Object> m_children;                         ///< Container holding this object's children
+        std::vector<Object*> m_children;                        ///< Container holding this object's children. Allocated from detail::ObjectPool
         std::vector<std::unique_ptr<Component>> m_components;   ///< Container holding components
-        std::unordered_set<std::string> m_tags;                 ///< Container holding tags
+        std::vector<uint32> m_tags;                             ///< Tag identifiers, in ascending order
+        std::vector<uint32> m_tagSlots;                         ///< Positions of this object in the tag index, one per tag
         std::string m_ID;                                       ///< Unique object identifier
+        uint32 m_IDKey;                                         ///< Interned identifier
+        uint32 m_IDSlot;                                        ///< Position of this object in the identifier index
+        mutable std::atomic<PathCache*> m_pathCache;            ///< Resolved search paths. Created on first use
+        ChildCursor* m_childCursor;                             ///< Innermost loop over the children that may run user code
         WeakReference<Object> m_parent;                         ///< The parent
         mutable uint32 m_flags;                                 ///< Flags
     };
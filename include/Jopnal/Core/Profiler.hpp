@@ -0,0 +1,328 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_PROFILER_HPP
+#define JOP_PROFILER_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    class JOP_API Profiler
+    {
+    private:
+
+        JOP_DISALLOW_COPY_MOVE(Profiler);
+
+    public:
+
+        /// Sample type
+        ///
+        enum class Type
+        {
+            CPU,    ///< Time spent on the CPU
+            GPU     ///< Time spent on the GPU, measured with timer queries
+        };
+
+        /// A single timed scope
+        ///
+        struct Sample
+        {
+            uint32 name;            ///< Name id, see getName()
+            const char* category;   ///< Category
+            Type type;              ///< Sample type
+            uint32 depth;           ///< Nesting depth of the scope
+            uint64 start;           ///< Start time in nanoseconds. For GPU samples this is the CPU time when the query was issued
+            uint64 duration;        ///< Duration in nanoseconds
+            bool resolved;          ///< Is the duration valid? GPU samples are resolved two frames later
+            uint32 thread;          ///< Index of the recording thread. 0 is the main thread
+        };
+
+        /// A recorded frame
+        ///
+        struct Frame
+        {
+            uint64 index;                   ///< Frame number
+            uint64 start;                   ///< Start time in nanoseconds
+            uint64 duration;                ///< Duration in nanoseconds
+            std::vector<Sample> samples;    ///< Main thread samples in the order they were begun, followed by the samples of other threads
+        };
+
+        /// Statistics of a scope over the recorded frames
+        ///
+        struct Statistics
+        {
+            uint32 name;            ///< Name id, see getName()
+            Type type;              ///< Sample type
+            std::size_t frames;     ///< Amount of frames the scope was recorded in
+            uint64 calls;           ///< Total amount of calls
+            double minTime;         ///< Shortest time spent in the scope during a frame, in milliseconds
+            double averageTime;     ///< Average time spent in the scope per frame, in milliseconds
+            double maxTime;         ///< Longest time spent in the scope during a frame, in milliseconds
+        };
+
+        /// \brief RAII profiling scope
+        ///
+        /// Does nothing if the profiler is disabled. Scopes outside the main
+        /// thread are recorded into a lock-free per-thread ring buffer, which
+        /// is collected at the end of each frame. Each sample is put into the
+        /// frame it was begun in, even if it ended after that frame. If the
+        /// buffer fills up during a frame, the rest of the samples are dropped.
+        ///
+        /// Prefer the JOP_PROFILE_SCOPE macros, they compile to nothing
+        /// when JOP_PROFILING isn't defined.
+        ///
+        class JOP_API Scope
+        {
+        private:
+
+            JOP_DISALLOW_COPY_MOVE(Scope);
+
+        public:
+
+            /// \brief Constructor
+            ///
+            /// GPU scopes record a CPU sample as well. GPU scopes can't be nested,
+            /// an inner GPU scope only records the CPU sample. Outside the main
+            /// thread only the CPU sample is recorded.
+            ///
+            /// \param name Name of the scope
+            /// \param category Category of the scope. Must point to a string with static storage duration
+            /// \param type The scope type
+            ///
+            Scope(const std::string& name, const char* category, const Type type = Type::CPU);
+
+            /// \brief Constructor
+            ///
+            /// The scope is named after a type. This is meant for subsystems,
+            /// so that the name only needs to be looked up when profiling.
+            ///
+            /// \param type Type info of the object being timed
+            /// \param category Category of the scope. Must point to a string with static storage duration
+            ///
+            Scope(const std::type_info& type, const char* category);
+
+            /// \brief Constructor
+            ///
+            /// \param name Name id of the scope, see getNameID()
+            /// \param category Category of the scope. Must point to a string with static storage duration
+            ///
+            Scope(const uint32 name, const char* category);
+
+            /// \brief Destructor
+            ///
+            /// Ends the scope.
+            ///
+            ~Scope();
+
+        private:
+
+            void begin(const uint32 name, const char* category, const Type type);
+
+            void beginThread(const uint32 name, const char* category);
+
+            void endThread();
+
+
+            int64 m_cpuSample;      ///< Index of the CPU sample, -1 if not recording, -2 if recording into the thread buffer
+            int64 m_gpuSample;      ///< Index of the GPU sample, -1 if not recording
+            uint64 m_start;         ///< Start time, only used outside the main thread
+            uint32 m_name;          ///< Name id, only used outside the main thread
+            uint64 m_frame;         ///< Frame the scope was begun in, only used outside the main thread
+            const char* m_category; ///< Category, only used outside the main thread
+        };
+
+    public:
+
+        /// \brief Begin a frame
+        ///
+        /// Called by the engine. This also reads the GPU timings of
+        /// older frames, if they are available.
+        ///
+        static void beginFrame();
+
+        /// \brief End a frame
+        ///
+        /// Called by the engine.
+        ///
+        static void endFrame();
+
+        /// \brief Check if the profiler is enabled
+        ///
+        /// Controlled by the setting engine@Debug|bProfiler.
+        ///
+        /// \return True if enabled
+        ///
+        static bool isEnabled();
+
+        /// \brief Enable/disable the profiler
+        ///
+        /// \param enabled True to enable
+        ///
+        static void setEnabled(const bool enabled);
+
+        /// \brief Get the amount of recorded frames
+        ///
+        /// The history size is read from engine@Debug|Profiler|uHistorySize.
+        ///
+        /// \return The amount of recorded frames
+        ///
+        static std::size_t getFrameCount();
+
+        /// \brief Get a recorded frame
+        ///
+        /// The GPU samples of the two newest frames are usually not yet resolved.
+        ///
+        /// \param age Age of the frame. 0 is the last completed frame
+        ///
+        /// \return Reference to the frame
+        ///
+        static const Frame& getFrame(const std::size_t age);
+
+        /// \brief Get the name of a sample
+        ///
+        /// \param name The name id
+        ///
+        /// \return Reference to the name
+        ///
+        static const std::string& getName(const uint32 name);
+
+        /// \brief Get the id of a name
+        ///
+        /// The name is registered if it doesn't exist yet.
+        ///
+        /// \param name The name
+        ///
+        /// \return The name id
+        ///
+        static uint32 getNameID(const std::string& name);
+
+        /// \brief Get the average duration of a scope over the recorded frames
+        ///
+        /// Unresolved samples are not included.
+        ///
+        /// \param name Name of the scope
+        /// \param type The sample type
+        ///
+        /// \return The average duration per frame in milliseconds. 0 if the scope was never recorded
+        ///
+        static double getAverageTime(const std::string& name, const Type type);
+
+        /// \brief Get the statistics of every scope over the recorded frames
+        ///
+        /// Unresolved samples are not included. Times of nested scopes with
+        /// the same name are counted multiple times.
+        ///
+        /// \return Vector with the statistics, in the order the scopes were first found
+        ///
+        static std::vector<Statistics> getStatistics();
+
+        /// \brief Get the recorded frames in the Chrome trace event format
+        ///
+        /// The result can be loaded into chrome://tracing. GPU samples
+        /// are placed on their own track.
+        ///
+        /// \return The trace as a JSON string
+        ///
+        static std::string getChromeTrace();
+
+        /// \brief Write the recorded frames to a file in the Chrome trace event format
+        ///
+        /// The file is written to the user directory.
+        ///
+        /// \param path Path to the file
+        ///
+        /// \return True if successful
+        ///
+        static bool saveChromeTrace(const std::string& path);
+
+        /// \brief Get the recorded samples as comma separated values
+        ///
+        /// Each row is a single sample, the first row has the column names.
+        /// Times are in microseconds.
+        ///
+        /// \return The samples as a CSV string
+        ///
+        static std::string getCSV();
+
+        /// \brief Write the recorded samples to a CSV file
+        ///
+        /// The file is written to the user directory.
+        ///
+        /// \param path Path to the file
+        ///
+        /// \return True if successful
+        ///
+        /// \see getCSV()
+        ///
+        static bool saveCSV(const std::string& path);
+    };
+}
+
+#ifdef JOP_PROFILING
+
+    #define JOP_PROFILE_CONCAT_IMPL(a, b) a##b
+    #define JOP_PROFILE_CONCAT(a, b) JOP_PROFILE_CONCAT_IMPL(a, b)
+
+    /// \brief Profile the enclosing scope
+    ///
+    /// The name is only looked up once, so it must not change between calls.
+    ///
+    #define JOP_PROFILE_SCOPE(name) JOP_PROFILE_SCOPE_CATEGORY(name, "scope")
+
+    /// \brief Profile the enclosing scope with a category
+    ///
+    #define JOP_PROFILE_SCOPE_CATEGORY(name, category)                                                                           \
+        static const ::jop::uint32 JOP_PROFILE_CONCAT(jopProfileName_, __LINE__) = ::jop::Profiler::getNameID(name);             \
+        ::jop::Profiler::Scope JOP_PROFILE_CONCAT(jopProfileScope_, __LINE__)(JOP_PROFILE_CONCAT(jopProfileName_, __LINE__), category)
+
+    /// \brief Profile the enclosing scope, named after a type
+    ///
+    #define JOP_PROFILE_TYPE_SCOPE(type, category) \
+        ::jop::Profiler::Scope JOP_PROFILE_CONCAT(jopProfileScope_, __LINE__)(type, category)
+
+    /// \brief Profile the enclosing scope with a name that may change between calls
+    ///
+    /// The arguments are not evaluated when JOP_PROFILING isn't defined.
+    ///
+    #define JOP_PROFILE_DYNAMIC_SCOPE(name, category, type) \
+        ::jop::Profiler::Scope JOP_PROFILE_CONCAT(jopProfileScope_, __LINE__)(name, category, type)
+
+#else
+
+    #define JOP_PROFILE_SCOPE(name)
+    #define JOP_PROFILE_SCOPE_CATEGORY(name, category)
+    #define JOP_PROFILE_TYPE_SCOPE(type, category)
+    #define JOP_PROFILE_DYNAMIC_SCOPE(name, category, type)
+
+#endif
+
+/// \class jop::Profiler
+/// \ingroup core
+
+#endif
\ No newline at end of file
@@ -27,6 +27,7 @@
 #include <Jopnal/Core/Resource.hpp>
 #include <Jopnal/Core/Subsystem.hpp>
 #include <Jopnal/Core/DebugHandler.hpp>
+#include <Jopnal/Core/Profiler.hpp>
 #include <Jopnal/Utility/Clock.hpp>
 #include <Jopnal/STL.hpp>
 #include <unordered_map>
@@ -51,6 +52,28 @@ namespace jop
 {
     class Resource;
 
+    namespace detail
+    {
+        // Profiles loading a resource. Defined in the engine, so that the inline
+        // templates don't depend on whether JOP_PROFILING is defined
+        class JOP_API ResourceLoadScope
+        {
+        private:
+
+            JOP_DISALLOW_COPY_MOVE(ResourceLoadScope);
+
+        public:
+
+            explicit ResourceLoadScope(const std::string& name);
+
+            ~ResourceLoadScope();
+
+        private:
+
+            std::unique_ptr<Profiler::Scope> m_scope;
+        };
+    }
+
     class JOP_API ResourceManager : public Subsystem
     {
     public:
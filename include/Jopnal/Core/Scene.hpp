@@ -28,6 +28,7 @@
 #include <Jopnal/Utility/Message.hpp>
 #include <Jopnal/Physics/World.hpp>
 #include <vector>
+#include <deque>
 #include <tuple>
 #include <memory>
 
@@ -36,10 +37,6 @@
 
 namespace jop
 {
-    namespace detail
-    {
-        class CullingBroadphaseCallback;
-    }
     class Renderer;
     class World;
     class World2D;
@@ -48,6 +45,8 @@ namespace jop
 
     namespace detail
     {
+        class TransformHierarchy;
+
         template<int D>
         struct WorldType
         {
@@ -114,6 +113,7 @@ namespace jop
         friend class SceneLoader;
         friend class Object;
         friend class Renderer;
+        friend class Engine;
 
     public:
 
@@ -198,6 +198,58 @@ namespace jop
         ///
         float getDeltaScale() const;
 
+        /// \brief Enable/disable parallel updating
+        ///
+        /// When enabled, the top-level objects of this scene and their children
+        /// are updated in parallel, each top-level subtree as a single task.
+        /// Structural changes to objects outside the subtree being updated are
+        /// applied after all the subtrees have been updated, see Object::updateParallel().
+        ///
+        /// Components may then only modify their own subtree, and must not touch
+        /// shared state such as the renderer or the physics world in their update.
+        ///
+        /// The default value is read from engine@Scene|bParallelUpdate.
+        ///
+        /// \param parallel True to enable
+        ///
+        void setParallelUpdate(const bool parallel);
+
+        /// \brief Check if parallel updating is enabled
+        ///
+        /// \return True if enabled
+        ///
+        bool parallelUpdateEnabled() const;
+
+        /// \brief Enable/disable batched updating
+        ///
+        /// When enabled, the components to update are first gathered from the
+        /// active objects into one list per component type. The lists are then
+        /// updated one type at a time, in the order the types were first
+        /// encountered in the hierarchy. Components of the same type are
+        /// updated in hierarchy order. Note that this differs from the normal
+        /// depth-first order, where all the components of an object are
+        /// updated before its children.
+        ///
+        /// Components whose object is deactivated or removed during the
+        /// update are skipped.
+        ///
+        /// Components that don't need updating are skipped regardless of this
+        /// setting, see ComponentRegistry::needsUpdate(). Parallel updating
+        /// takes precedence over this.
+        ///
+        /// The default value is read from engine@Scene|bBatchedUpdate, which
+        /// defaults to false.
+        ///
+        /// \param batched True to enable
+        ///
+        void setBatchedUpdate(const bool batched);
+
+        /// \brief Check if batched updating is enabled
+        ///
+        /// \return True if enabled
+        ///
+        bool batchedUpdateEnabled() const;
+
         /// \brief Send a message to this scene
         ///
         /// The message will be forwarded to the objects, should it
@@ -248,16 +300,35 @@ namespace jop
 
     private:
 
+        using Object::storeTickState;
+        using Object::interpolateTransforms;
+        using Object::restoreTransforms;
+
         /// \copydoc Component::receiveMessage()
         ///
         virtual Message::Result receiveMessage(const Message& message);
 
+        /// \brief Update the components in per-type batches
+        ///
+        /// \param deltaTime The delta time
+        ///
+        void updateBatched(const float deltaTime);
+
+        /// \brief Recompute the world matrices of the objects moved since the last call
+        ///
+        /// Called by the engine once per frame, before drawing.
+        ///
+        void updateTransforms();
+
 
-        std::unique_ptr<Renderer> m_renderer;   ///< The renderer
-        float m_deltaScale;                     ///< Delta time scalar
-        std::tuple<World2D*, World*> m_worlds;  ///< 2D and 3D worlds
-        World m_cullingWorld;
-        std::unique_ptr<detail::CullingBroadphaseCallback> m_broadphaseCallback;
+        std::unique_ptr<Renderer> m_renderer;                       ///< The renderer
+        std::unique_ptr<detail::TransformHierarchy> m_transforms;   ///< Depth-ordered transform layout
+        std::tuple<World2D*, World*> m_worlds;                      ///< 2D and 3D worlds
+        float m_deltaScale;                                         ///< Delta time scalar
+        bool m_parallelUpdate;                                      ///< Update the top-level subtrees in parallel?
+        bool m_batchedUpdate;                                       ///< Update the components in per-type batches?
+        std::deque<std::vector<Component*>> m_updateLists;          ///< Components to update, per type
+        std::vector<uint32> m_updateOrder;                          ///< Types in the order they are updated
     };
 
     // Include the template implementation file
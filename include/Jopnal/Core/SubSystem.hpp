@@ -29,6 +29,7 @@
 #include <string>
 #include <memory>
 #include <atomic>
+#include <array>
 
 //////////////////////////////////////////////
 
@@ -41,10 +42,38 @@ namespace jop
 
         JOP_DISALLOW_COPY_MOVE(Subsystem);
 
+    public:
+
+        /// Subsystem stage
+        ///
+        enum class Stage
+        {
+            PreUpdate,  ///< preUpdate()
+            PostUpdate, ///< postUpdate()
+            Draw        ///< draw()
+        };
+
+        /// Thread a stage is run on
+        ///
+        /// Only has an effect when the simulation is run on its own thread,
+        /// see Engine::pipelinedSimulationEnabled(). Stages with the Simulation
+        /// affinity must not make OpenGL calls, as that thread has no graphics
+        /// context.
+        ///
+        enum class Affinity
+        {
+            Simulation, ///< The simulation thread, along with the scene update
+            Render,     ///< The render thread, while the simulation is stopped
+            Concurrent  ///< The render thread, while the next frame is being simulated. Must not access any scene state
+        };
+
     public:
 
         /// \brief Constructor
         ///
+        /// By default, the update stages have the Simulation affinity and
+        /// the draw stage has the Render affinity.
+        ///
         /// \param ID Identifier of this subsystem
         ///
         Subsystem(const uint32 ID);
@@ -56,7 +85,7 @@ namespace jop
 
         /// \brief Pre-update
         ///
-        /// This will be called before the engine calls the scene's update.
+        /// This will be called once per frame, before the engine calls the scene's update.
         ///
         /// \param deltaTime Delta time
         ///
@@ -64,7 +93,7 @@ namespace jop
 
         /// \brief Post-update
         ///
-        /// This will be called after the engine calls the scene's update.
+        /// This will be called once per frame, after the engine calls the scene's update.
         ///
         /// \param deltaTime Delta time
         ///
@@ -104,6 +133,26 @@ namespace jop
         ///
         uint32 getID() const;
 
+        /// \brief Set the thread affinity of a stage
+        ///
+        /// Stages that use the window or the graphics context must
+        /// not have the Simulation affinity.
+        ///
+        /// \param stage The stage
+        /// \param affinity The affinity
+        ///
+        /// \return Reference to self
+        ///
+        Subsystem& setAffinity(const Stage stage, const Affinity affinity);
+
+        /// \brief Get the thread affinity of a stage
+        ///
+        /// \param stage The stage
+        ///
+        /// \return The affinity
+        ///
+        Affinity getAffinity(const Stage stage) const;
+
     protected:
 
         /// \copydoc Component::receiveMessage()
@@ -112,8 +161,9 @@ namespace jop
 
     private:
 
-        const uint32 m_ID;          ///< This subsystem's identifier
-        std::atomic<bool> m_active; ///< Sets activity 
+        const uint32 m_ID;                      ///< This subsystem's identifier
+        std::atomic<bool> m_active;             ///< Sets activity 
+        std::array<Affinity, 3> m_affinities;   ///< Thread affinities of the stages
     };
 }
 
@@ -54,6 +54,7 @@
 #include <Jopnal/Graphics/Texture/Texture2D.hpp>
 #include <Jopnal/Graphics/Texture/TextureSampler.hpp>
 #include <Jopnal/Graphics/Transform.hpp>
+#include <Jopnal/Graphics/UniformBuffer.hpp>
 #include <Jopnal/Graphics/Vertex.hpp>
 #include <Jopnal/Graphics/VertexBuffer.hpp>
 #include <Jopnal/Graphics/ShaderProgram.hpp>
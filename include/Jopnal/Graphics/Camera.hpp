@@ -27,7 +27,7 @@
 #include <Jopnal/Core/Component.hpp>
 #include <Jopnal/Graphics/RenderTexture.hpp>
 #include <glm/vec3.hpp>
-#include <set>
+#include <vector>
 
 //////////////////////////////////////////////
 
@@ -36,13 +36,11 @@ namespace jop
 {
     namespace detail
     {
-        class CullerComponent;
+        class FrustumCuller;
     }
     class Renderer;
     class RenderTarget;
     class Drawable;
-    class LightSource;
-    class FrustumShape;
 
     class JOP_API Camera : public Component
     {
@@ -50,7 +48,7 @@ namespace jop
 
         JOP_GENERIC_COMPONENT_CLONE(Camera);
 
-        friend class detail::CullerComponent;
+        friend class detail::FrustumCuller;
 
     public:
 
@@ -97,8 +95,6 @@ namespace jop
         ~Camera() override;
 
 
-        void update(const float deltaTime) override;
-
         /// \brief Get the projection matrix
         ///
         /// \return The projection matrix
@@ -289,10 +285,20 @@ namespace jop
 
         /// \brief Check if a drawable is in view
         ///
+        /// Drawables that aren't culled are always in view.
+        ///
         /// \return True if in view
         ///
         bool inView(const Drawable& drawable) const;
 
+        /// \brief Get the drawables that were in view when this camera was last drawn
+        ///
+        /// Drawables that aren't culled are not included. Always empty if culling is disabled.
+        ///
+        /// \return Reference to the visible drawables
+        ///
+        const std::vector<const Drawable*>& getVisibleDrawables() const;
+
     protected:
 
         /// \copydoc Component::receiveMessage()
@@ -301,15 +307,10 @@ namespace jop
 
     private:
 
-        Camera& updateShape();
-
-
-        mutable glm::mat4 m_projectionMatrix;               ///< The projection matrix
-        RenderTexture m_renderTexture;                      ///< RenderTexture used for off-screen rendering
-        std::set<const Drawable*> m_drawables;              ///< Drawables currently in view
-        std::set<const LightSource*> m_lights;              ///< Lights currently in view
-        std::unique_ptr<FrustumShape> m_shape;              ///< CUlling shape
-        std::unique_ptr<detail::CullerComponent> m_culler;  ///< Culler
+        mutable glm::mat4 m_projectionMatrix;                   ///< The projection matrix
+        RenderTexture m_renderTexture;                          ///< RenderTexture used for off-screen rendering
+        mutable std::vector<const Drawable*> m_visibleDrawables;///< Drawables in view, filled by the culler
+        mutable std::vector<uint8> m_visibility;                ///< Visibility flags, indexed by culling slot
         ViewPort m_viewPort;                                ///< Viewport in relative coordinates
         ProjectionData m_projData;                          ///< Union with data for orthographic and perspective projections
         ClippingPlanes m_clippingPlanes;                    ///< The clipping planes
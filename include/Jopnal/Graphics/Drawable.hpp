@@ -28,10 +28,12 @@
 #include <Jopnal/Graphics/Color.hpp>
 #include <Jopnal/Graphics/RenderPass.hpp>
 #include <Jopnal/Utility/Json.hpp>
+#include <glm/mat3x3.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
 #include <memory>
 #include <utility>
+#include <vector>
 
 //////////////////////////////////////////////
 
@@ -40,7 +42,7 @@ namespace jop
 {
     namespace detail
     {
-        class CullerComponent;
+        class FrustumCuller;
     }
     class ShaderProgram;
     class LightSource;
@@ -48,6 +50,8 @@ namespace jop
     class Renderer;
     class Material;
     class Mesh;
+    class UniformBuffer;
+    class VertexBuffer;
 
     class JOP_API Drawable : public Component
     {
@@ -56,6 +60,7 @@ namespace jop
         JOP_GENERIC_COMPONENT_CLONE(Drawable);
 
         friend class ShaderAssembler;
+        friend class detail::FrustumCuller;
 
     public:
     
@@ -76,7 +81,8 @@ namespace jop
             enum : uint64
             {
                 __SkySphere = 1 << 10,
-                __SkyBox    = __SkySphere << 1
+                __SkyBox    = __SkySphere << 1,
+                __Instanced = __SkyBox << 1
             };
         };
 
@@ -90,15 +96,57 @@ namespace jop
 
             /// \brief Constructor
             ///
+            /// The inverse view matrix is calculated when it's first needed.
+            ///
             /// \param view The view matrix
             /// \param proj The projection matrix
             /// \param camPos The camera position
             ///
             ProjectionInfo(const glm::mat4& view, const glm::mat4& proj, const glm::vec3& camPos);
 
+            /// \brief Constructor
+            ///
+            /// \param view The view matrix
+            /// \param proj The projection matrix
+            /// \param camPos The camera position
+            /// \param invView The inverse of the view matrix
+            ///
+            ProjectionInfo(const glm::mat4& view, const glm::mat4& proj, const glm::vec3& camPos, const glm::mat4& invView);
+
+            /// \brief Write this projection info into a uniform buffer
+            ///
+            /// The data is laid out to match jop_CameraBlock.
+            ///
+            /// \param buffer The uniform buffer to write to
+            ///
+            void sendToBlock(UniformBuffer& buffer) const;
+
+            /// \brief Get the inverse view matrix
+            ///
+            /// If the matrix wasn't passed to the constructor, it's calculated
+            /// on the first call. That is not thread safe.
+            ///
+            /// \return Reference to the inverse view matrix
+            ///
+            const glm::mat4& getInverseViewMatrix() const;
+
             const glm::mat4& viewMatrix;        ///< View matrix
             const glm::mat4& projectionMatrix;  ///< Projection matrix
             const glm::vec3& cameraPosition;    ///< Camera position
+
+        private:
+
+            mutable const glm::mat4* m_inverseViewMatrix;   ///< Inverse view matrix, nullptr if not calculated yet
+            mutable glm::mat4 m_inverseViewCache;           ///< Calculated inverse view matrix
+        };
+
+        /// Per-draw matrices
+        ///
+        struct DrawMatrices
+        {
+            glm::mat4 viewModel;        ///< View-model matrix
+            glm::mat4 projViewModel;    ///< Projection-view-model matrix
+            glm::mat3 normal;           ///< Normal matrix. Only calculated if the material uses lighting
         };
 
     public:
@@ -123,8 +171,6 @@ namespace jop
         virtual ~Drawable() override;
 
 
-        void update(const float deltaTime) override;
-
         /// \brief Draw function
         /// 
         /// \param proj The projection info
@@ -132,6 +178,43 @@ namespace jop
         ///
         virtual void draw(const ProjectionInfo& proj, const LightContainer& lights) const;
 
+        /// \brief Calculate the matrices needed to draw this drawable
+        ///
+        /// This doesn't make any OpenGL calls, so it can be called from any thread,
+        /// as long as the object's transformation isn't being modified at the
+        /// same time and has already been evaluated.
+        ///
+        /// \param proj The projection info
+        /// \param matrices The calculated matrices
+        ///
+        void calculateMatrices(const ProjectionInfo& proj, DrawMatrices& matrices) const;
+
+        /// \brief Draw using precomputed matrices
+        ///
+        /// This is what the default draw() does after calculating the matrices.
+        /// Derived classes that override draw() must not be drawn using this.
+        ///
+        /// \param proj The projection info
+        /// \param lights The light container
+        /// \param matrices Matrices calculated with calculateMatrices()
+        ///
+        void drawPrepared(const ProjectionInfo& proj, const LightContainer& lights, const DrawMatrices& matrices) const;
+
+        /// \brief Draw a group of drawables using hardware instancing
+        ///
+        /// The drawables must share the same mesh, material and flags, and they
+        /// mustn't use override shaders. Only the transform and color are taken
+        /// from each drawable, everything else is taken from the first one.
+        ///
+        /// \param proj The projection info
+        /// \param lights The light container
+        /// \param drawables The drawables to draw
+        /// \param instanceBuffer Buffer to stream the per-instance data into
+        ///
+        /// \see Mesh::isInstancingSupported()
+        ///
+        static void drawInstanced(const ProjectionInfo& proj, const LightContainer& lights, const std::vector<const Drawable*>& drawables, VertexBuffer& instanceBuffer);
+
         /// \brief Get the renderer this drawable is bound to
         ///
         /// \return Reference to the renderer
@@ -312,12 +395,14 @@ namespace jop
 
         static std::string getShaderPreprocessorDef(const uint64 attributes);
 
+        static const uint32 NotCulled = 0xFFFFFFFF;
+
 
         Color m_color;                                      ///< Color specific to this drawable
         WeakReference<const Mesh> m_mesh;                   ///< The bound mesh
         WeakReference<const Material> m_material;           ///< The bound material
         mutable WeakReference<ShaderProgram> m_shader;      ///< The bound shader (override)
-        std::unique_ptr<detail::CullerComponent> m_culler;  ///< Culler
+        uint32 m_cullSlot;                                  ///< Slot in the frustum culler, NotCulled if not culled
         Renderer& m_rendererRef;                            ///< Reference to the renderer
         const RenderPass::Pass m_pass;                      ///< The render pass type
         const uint32 m_weight;                              ///< Render pass weight
@@ -26,10 +26,12 @@
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Core/Component.hpp>
 #include <Jopnal/Graphics/Color.hpp>
+#include <Jopnal/Graphics/Drawable.hpp>
 #include <Jopnal/Graphics/RenderPass.hpp>
 #include <Jopnal/Graphics/RenderTexture.hpp>
 #include <Jopnal/Graphics/Texture/Cubemap.hpp>
 #include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
 #include <vector>
 #include <array>
 #include <set>
@@ -44,6 +46,8 @@ namespace jop
     class Renderer;
     class RenderTexture;
     class Drawable;
+    class Camera;
+    class UniformBuffer;
 
     class JOP_API LightSource final : public Component
     {
@@ -119,6 +123,10 @@ namespace jop
         ///
         /// This can be an expensive function, do not call frequently.
         ///
+        /// Directional lights use cascaded shadow maps. The amount of cascades
+        /// is read from engine@Graphics|Shading|uShadowCascades when the shadow
+        /// map is created, and the resolution is per cascade.
+        ///
         /// \param castShadows True to cast shadows
         /// \param resolution The shadow map resolution, glm::uvec2(0) to use the default
         ///
@@ -135,8 +143,11 @@ namespace jop
         /// \brief Get a light space matrix
         ///
         /// Faces other than First are only available with point lights.
-        /// Trying to get these matrices when the light type is Spot or
-        /// Directional will result in overstepping the array
+        /// With directional lights, the face index is used as the cascade
+        /// index. Trying to get any other matrices will result in overstepping
+        /// the array.
+        ///
+        /// The matrices transform from world space to the light's clip space.
         /// 
         /// \param face The face whose matrix to fetch
         ///
@@ -144,6 +155,25 @@ namespace jop
         ///
         const glm::mat4& getLightspaceMatrix(const Cubemap::Face face = Cubemap::Face::First) const;
 
+        /// \brief Get the amount of shadow cascades
+        ///
+        /// \return The amount of shadow cascades. 0 if this is not a directional light casting shadows
+        ///
+        unsigned int getShadowCascades() const;
+
+        /// \brief Get the shadow cascade splits
+        ///
+        /// Each component is the far view space depth of the corresponding cascade.
+        /// Only valid for directional lights casting shadows.
+        ///
+        /// The cascades are fitted to a single camera, see Renderer::getShadowCamera().
+        /// Other cameras sample the same cascades, so their shadows may be missing
+        /// or of lower resolution.
+        ///
+        /// \return The cascade splits
+        ///
+        const glm::vec4& getCascadeSplits() const;
+
         /// \brief Get the shadow map
         ///
         /// \return Const reference to the shadow map. nullptr if no shadow map exists
@@ -283,6 +313,12 @@ namespace jop
         ///
         static unsigned int getMaximumLights(const Type type);
 
+        /// \brief Get the maximum amount of shadow cascades
+        ///
+        /// \return The maximum amount of shadow cascades
+        ///
+        static unsigned int getMaximumShadowCascades();
+
         /// \brief Calculate cube map view matrices
         ///
         /// \param projection The projection matrix
@@ -299,11 +335,27 @@ namespace jop
 
     private:
 
-        bool drawShadowMap() const;
+        /// \brief Render the shadow map
+        ///
+        /// The map is only re-rendered when the light space matrices, or the
+        /// shadow casters touching them have changed since the last call.
+        ///
+        /// \param drawables The drawables to consider as shadow casters
+        /// \param camera The camera to fit the shadow cascades to. Only used with directional lights
+        ///
+        /// \return True if the shadow map was rendered
+        ///
+        bool drawShadowMap(const std::set<const Drawable*>& drawables, const Camera* camera) const;
+
+        /// \brief Fit the shadow cascades to the view frustum of a camera
+        ///
+        void fitShadowCascades(const Camera& camera) const;
 
 
         mutable RenderTexture m_shadowMap;                      ///< The shadow map
         mutable std::vector<glm::mat4> m_lightSpaceMatrices;    ///< Light space matrices. Used when rendering the shadow map
+        mutable glm::vec4 m_cascadeSplits;                      ///< Far depths of the shadow cascades
+        mutable uint64 m_casterHash;                            ///< Hash of the last rendered light matrices & shadow casters
         const Type m_type;                                      ///< The light type
         std::array<Color, 3> m_intensities;                     ///< The intensities
         glm::vec3 m_attenuation;                                ///< The attenuation values    
@@ -340,11 +392,25 @@ namespace jop
 
         /// \brief Send the contained lights to shader
         ///
+        /// The inverse view matrix is only requested from the projection info
+        /// when there are shadows to draw.
+        ///
         /// \param shader The shader to send the lights to
         /// \param drawable The drawable
-        /// \param viewMatrix The current view matrix
+        /// \param proj The current projection info
+        ///
+        void sendToShader(ShaderProgram& shader, const Drawable& drawable, const Drawable::ProjectionInfo& proj) const;
+
+        /// \brief Pack the contained lights into a uniform buffer
+        ///
+        /// The data is laid out to match jop_LightBlock. After this has
+        /// been called, sendToShader() will only set the per-drawable
+        /// uniforms and shadow maps.
         ///
-        void sendToShader(ShaderProgram& shader, const Drawable& drawable, const glm::mat4& viewMatrix) const;
+        /// \param buffer The uniform buffer to write to
+        /// \param proj The current projection info
+        ///
+        void sendToBlock(UniformBuffer& buffer, const Drawable::ProjectionInfo& proj) const;
 
         /// \brief Access the individual containers for each light type
         ///
@@ -358,6 +424,15 @@ namespace jop
         ///
         const ContainerType& operator [](const LightSource::Type type) const;
 
+        /// \brief Check if lights are passed to shaders using a uniform block
+        ///
+        /// Controlled by the setting engine@Graphics|Shading|bUniformBlockLights.
+        /// Always false if uniform buffers aren't supported.
+        ///
+        /// \return True if the light uniform block is used
+        ///
+        static bool usesUniformBlock();
+
     private:
 
         std::array<ContainerType, 3> m_container;   ///< Containers for each type of light
@@ -91,6 +91,10 @@ namespace jop
         ///
         Mesh(const Mesh& other, const std::string& newName);
 
+        /// \brief Destructor
+        ///
+        ~Mesh() override;
+
 
         /// \brief Load mesh from memory
         ///
@@ -127,6 +131,21 @@ namespace jop
         ///
         void draw() const;
 
+        /// \brief Draw multiple instances of this mesh
+        ///
+        /// The instance buffer must contain a model matrix (mat4) followed by a color
+        /// (vec4) for each instance. The matrix is bound to VertexIndex::ModelMatrix.
+        /// The color is only used if this mesh doesn't have vertex colors.
+        ///
+        /// This function doesn't do anything if instancing isn't supported.
+        ///
+        /// \param instances Number of instances to draw
+        /// \param instanceBuffer Buffer holding the per-instance data
+        ///
+        /// \see isInstancingSupported()
+        ///
+        void drawInstanced(const unsigned int instances, const VertexBuffer& instanceBuffer) const;
+
         /// \brief Destroy this mesh
         ///
         /// After this call, this mesh won't be valid and cannot be used in drawing.
@@ -234,16 +253,30 @@ namespace jop
         ///
         static Mesh& getDefault();
 
+        /// \brief Check if instanced drawing is supported
+        ///
+        /// Instancing requires OpenGL 3.3 or GLES 3.0.
+        ///
+        /// \return True if supported
+        ///
+        static bool isInstancingSupported();
+
     private:
 
         bool updateVertexAttributes() const;
 
+        void setVertexAttributes() const;
+
+        void destroyVertexArray() const;
+
 
         VertexBuffer m_vertexbuffer;                ///< The vertex buffer
         VertexBuffer m_indexbuffer;                 ///< The index buffer
         mutable BoxShape m_shape;                   ///< Culling shape
         std::pair<glm::vec3, glm::vec3> m_bounds;   ///< Mesh bounds
         uint32 m_vertexComponents;                  ///< Vertex components this mesh has
+        mutable uint32 m_vertexArrayComponents;     ///< Vertex components the vertex array was built with
+        mutable unsigned int m_vertexArray;         ///< Vertex array object, built on first draw
         uint16 m_elementSize;                       ///< Element size
         uint16 m_vertexSize;                        ///< Vertex size
     };
@@ -168,6 +168,23 @@ namespace jop
         ///
         static void setVertexAttribute(const bool enable, const unsigned int index);
 
+        /// \brief Bind a vertex array object
+        ///
+        /// setVertexAttribute() always operates on the default vertex array, and will
+        /// bind it if another one is bound.
+        ///
+        /// \param array The vertex array handle. 0 to bind the default vertex array
+        ///
+        static void setVertexArray(const unsigned int array);
+
+        /// \brief Set the default vertex array
+        ///
+        /// This also binds the given vertex array.
+        ///
+        /// \param array The vertex array handle
+        ///
+        static void setDefaultVertexArray(const unsigned int array);
+
         /// \brief Enable/disable depth buffer writing
         ///
         /// \param enable Enable depth writes?
@@ -25,7 +25,10 @@
 // Headers
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Core/SubSystem.hpp>
-#include <set>
+#include <Jopnal/Graphics/VertexBuffer.hpp>
+#include <array>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 //////////////////////////////////////////////
@@ -36,6 +39,9 @@ namespace jop
     class Renderer;
     class Drawable;
     class RenderTarget;
+    class LightSource;
+    class LightContainer;
+    class ShaderProgram;
 
     class JOP_API RenderPass
     {
@@ -152,10 +158,32 @@ namespace jop
         bool m_active;                  ///< Is this render pass active?
     };
 
-    /// \brief Distance-sorted render pass
+    /// \brief State-sorted render pass
     ///
-    /// Sorts opaque drawables from nearest to farthest and translucent
-    /// drawables the other way around.
+    /// Each visible drawable is given a 64-bit sort key, which encodes
+    /// (from most to least significant bits):
+    /// - Bucket (opaque, sky box/sphere, translucent)
+    /// - Shader program, material & mesh
+    /// - Quantized camera distance
+    ///
+    /// Opaque drawables are grouped by state and then sorted from nearest to
+    /// farthest. Translucent drawables are sorted from farthest to nearest first,
+    /// using the state only to break ties. The keys are radix sorted.
+    ///
+    /// Drawing is split in two phases. The prepare phase does the visibility
+    /// tests, computes the sort keys & matrices and sorts the draw lists of all
+    /// cameras. It runs in chunks on ThreadPool::getDefault(). The submit phase
+    /// then replays the draw lists on the calling thread, which is the only one
+    /// making OpenGL calls.
+    ///
+    /// Consecutive opaque drawables that share the same mesh, material & flags
+    /// are drawn with a single instanced draw call, when supported. This is
+    /// controlled by the settings engine@Graphics|Instancing|bEnabled and
+    /// engine@Graphics|Instancing|uMinInstances.
+    ///
+    /// When clustered lighting is enabled (engine@Graphics|Shading|bClusteredLights),
+    /// point & spot lights that don't cast shadows are binned into light clusters
+    /// once per camera, instead of being limited to the first lights of each type.
     ///
     /// Draws its drawables in three different sets:
     /// 1. Opaque objects
@@ -167,10 +195,40 @@ namespace jop
     ///
     struct JOP_API SortedRenderPass : RenderPass
     {
+        /// State change statistics
+        ///
+        /// The values are accumulated over all the cameras drawn during
+        /// the last frame.
+        ///
+        struct Statistics
+        {
+            unsigned int drawCalls;         ///< Number of drawables drawn
+            unsigned int shaderChanges;     ///< Shader program switches
+            unsigned int materialChanges;   ///< Material switches
+            unsigned int meshChanges;       ///< Mesh switches
+            unsigned int avoidedChanges;    ///< State changes avoided compared to the unsorted order
+            unsigned int instancedDraws;    ///< Number of drawables drawn using instancing
+            unsigned int instanceBatches;   ///< Number of instanced draw calls
+            unsigned int clusteredLights;   ///< Number of lights binned into light clusters
+        };
+
+    public:
+
         /// \copydoc RenderPass::RenderPass()
         ///
         SortedRenderPass(Renderer& renderer, const RenderTarget& target, const Pass pass, const uint32 weight);
 
+        /// \brief Destructor
+        ///
+        ~SortedRenderPass() override;
+
+
+        /// \brief Get the state change statistics of the last frame
+        ///
+        /// \return Reference to the statistics
+        ///
+        const Statistics& getStatistics() const;
+
     protected:
 
         /// \copydoc RenderPass::draw()
@@ -187,7 +245,38 @@ namespace jop
 
     private:
 
-        std::set<const Drawable*> m_drawables; ///< Drawable set
+        struct DrawItem;
+        struct View;
+
+        /// \brief Get a compact id for a state object
+        ///
+        uint32 getStateId(const unsigned int type, const void* object);
+
+        /// \brief Gather the draw items of one chunk of drawables for a view
+        ///
+        void prepareChunk(View& view, const std::size_t chunk) const;
+
+        /// \brief Merge the chunks of a view and sort the draw items
+        ///
+        void sortView(View& view) const;
+
+        /// \brief Draw the sorted draw items of a view
+        ///
+        void submitView(View& view, const LightContainer& lights, const bool clustered);
+
+
+        std::vector<const Drawable*> m_drawables;                                   ///< Bound drawables
+        std::unordered_map<const Drawable*, std::size_t> m_indices;                 ///< Index of each bound drawable in m_drawables
+        std::vector<const ShaderProgram*> m_shaders;                                ///< Shader of each drawable, resolved before preparing
+        std::vector<uint64> m_stateKeys;                                            ///< State part of the sort key of each drawable
+        std::array<std::unordered_map<const void*, uint32>, 3> m_stateIds;          ///< Compact state ids, reset for every frame
+        std::vector<std::unique_ptr<View>> m_views;                                 ///< Per-camera draw lists, reused between frames
+        std::size_t m_chunkCount;                                                   ///< Amount of prepare chunks per view
+        std::vector<const Drawable*> m_instances;                                   ///< Current instance group
+        std::vector<const LightSource*> m_clusteredLights;                          ///< Lights to bin into the light clusters
+        std::unique_ptr<LightContainer> m_lights;                                   ///< Lights passed to the drawables, reused between frames
+        VertexBuffer m_instanceBuffer;                                              ///< Per-instance data buffer
+        Statistics m_stats;                                                         ///< State change statistics
     };
 
     /// \brief Orderer render pass
@@ -155,6 +155,27 @@ namespace jop
         ///
         bool bindCubeFace(const Slot slot, const Cubemap::Face face) const;
 
+        /// \brief Bind all the layers of a texture attachment
+        ///
+        /// With a cube map attachment, a geometry shader can then render into
+        /// all of the faces in a single pass by writing gl_Layer.
+        ///
+        /// \note This will also bind the frame buffer object as the draw frame buffer
+        ///
+        /// \param slot The attachment slot
+        ///
+        /// \return True if successful. Always false if layered rendering is not supported
+        ///
+        bool bindLayered(const Slot slot) const;
+
+        /// \brief Check if layered rendering is supported
+        ///
+        /// Requires GL 3.2.
+        ///
+        /// \return True if supported
+        ///
+        static bool isLayeredSupported();
+
         /// \brief Set the size for attachments
         ///
         /// Must be called before attempting to add attachments. Has no effect
@@ -26,9 +26,11 @@
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Core/Object.hpp>
 #include <Jopnal/Graphics/RenderPass.hpp>
+#include <Jopnal/Graphics/UniformBuffer.hpp>
 #include <Jopnal/Physics/World.hpp>
 #include <Jopnal/STL.hpp>
 #include <map>
+#include <set>
 #include <array>
 
 //////////////////////////////////////////////
@@ -36,6 +38,11 @@
 
 namespace jop
 {
+    namespace detail
+    {
+        class FrustumCuller;
+        class LightClusterer;
+    }
     class LightSource;
     class Camera;
     class EnvironmentRecorder;
@@ -51,11 +58,14 @@ namespace jop
         typedef std::array<std::map<uint32, std::unique_ptr<RenderPass>>, 2> PassContainer;
         typedef std::set<const Camera*> CameraSet;
         typedef std::set<const LightSource*> LightSet;
+        typedef std::set<const Drawable*> DrawableSet;
 
         friend class Camera;
         friend class LightSource;
         friend class EnvironmentRecorder;
         friend class Drawable;
+        friend struct SortedRenderPass;
+        friend struct OrderedRenderPass;
 
     public:
 
@@ -65,6 +75,10 @@ namespace jop
         ///
         Renderer(const RenderTarget& mainTarget, Scene& sceneRef);
 
+        /// \brief Destructor
+        ///
+        ~Renderer();
+
 
         /// \brief Get the bound render target
         ///
@@ -84,6 +98,24 @@ namespace jop
         ///
         const LightSet& getLights() const;
 
+        /// \brief Set the camera to fit the directional light shadow cascades to
+        ///
+        /// The cascades are only fitted to one camera per frame. Other cameras
+        /// use the same shadow maps.
+        ///
+        /// \param camera The camera. nullptr to use the first active camera
+        ///
+        void setShadowCamera(const Camera* camera);
+
+        /// \brief Get the camera the directional light shadow cascades are fitted to
+        ///
+        /// This is the camera set with setShadowCamera(), if it's active.
+        /// Otherwise the first active camera in the camera set is used.
+        ///
+        /// \return Pointer to the camera. nullptr if there are no active cameras
+        ///
+        const Camera* getShadowCamera() const;
+
         /// \brief Create a new render pass
         ///
         /// If a pass with the same type and weight already exists, it will be replaced.
@@ -122,10 +154,6 @@ namespace jop
         ///
         void draw(const RenderPass::Pass pass);
 
-        /// \brief Get the culling world
-        ///
-        World& getCullingWorld();
-
     private:
 
         void bind(const LightSource* light);
@@ -148,10 +176,16 @@ namespace jop
 
         LightSet m_lights;                                      ///< The bound lights
         CameraSet m_cameras;                                    ///< The bound cameras
+        const Camera* m_shadowCamera;                           ///< Camera to fit the shadow cascades to
+        DrawableSet m_drawables;                                ///< All the bound drawables, used for shadow casting
         PassContainer m_passes;                                 ///< Render passes
         std::set<const EnvironmentRecorder*> m_envRecorders;    ///< The bound environment recorders
         const RenderTarget& m_target;                           ///< Main render target reference
         Scene& m_sceneRef;
+        UniformBuffer m_cameraBlock;                            ///< Per-camera uniform block
+        UniformBuffer m_lightBlock;                             ///< Per-camera light uniform block
+        std::unique_ptr<detail::FrustumCuller> m_culler;        ///< Frustum culler
+        std::unique_ptr<detail::LightClusterer> m_clusterer;    ///< Clustered light binning
     };
 
     // Include template implementation file
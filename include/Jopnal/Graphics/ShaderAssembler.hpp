@@ -27,6 +27,7 @@
 #include <Jopnal/Core/SubSystem.hpp>
 #include <Jopnal/Graphics/Shader.hpp>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 #include <string>
 #include <array>
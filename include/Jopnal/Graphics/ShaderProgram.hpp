@@ -29,6 +29,7 @@
 #include <glm/vec4.hpp>
 #include <glm/mat4x4.hpp>
 #include <unordered_map>
+#include <vector>
 
 //////////////////////////////////////////////
 
@@ -37,6 +38,45 @@ namespace jop
 {
     class Texture;
 
+    /// \brief Pre-resolved uniform identifier
+    ///
+    /// Uniform names are interned into a global table once, after which
+    /// shader programs can look up the location by a plain index instead
+    /// of hashing the name on every call. The same handle is valid for
+    /// every shader program, the location is resolved separately for each
+    /// program the first time it's used.
+    ///
+    /// Handles are meant to be created once and stored, preferably as
+    /// static or member variables.
+    ///
+    class JOP_API UniformHandle
+    {
+    public:
+
+        /// \brief Constructor
+        ///
+        /// \param name Name of the uniform
+        ///
+        explicit UniformHandle(const std::string& name);
+
+
+        /// \brief Get the uniform name
+        ///
+        /// \return Reference to the name
+        ///
+        const std::string& getName() const;
+
+        /// \brief Get the internal index
+        ///
+        /// \return The index
+        ///
+        unsigned int getIndex() const;
+
+    private:
+
+        unsigned int m_index;   ///< Index into the global name table
+    };
+
     class JOP_API ShaderProgram : public Resource
     {
     private:
@@ -210,6 +250,66 @@ namespace jop
         ///
         bool setUniform(const std::string& name, const bool value);
 
+        /// \copydoc setUniform(const std::string&, const glm::mat4&)
+        ///
+        bool setUniform(const UniformHandle& handle, const glm::mat4& matrix);
+
+        /// \copydoc setUniform(const std::string&, const float*, const unsigned int)
+        ///
+        bool setUniform(const UniformHandle& handle, const float* matrices, const unsigned int amount);
+
+        /// \copydoc setUniform(const std::string&, const glm::mat3&)
+        ///
+        bool setUniform(const UniformHandle& handle, const glm::mat3& matrix);
+
+        /// \copydoc setUniform(const std::string&, const glm::vec2&)
+        ///
+        bool setUniform(const UniformHandle& handle, const glm::vec2& vector);
+
+        /// \copydoc setUniform(const std::string&, const glm::vec3&)
+        ///
+        bool setUniform(const UniformHandle& handle, const glm::vec3& vector);
+
+        /// \copydoc setUniform(const std::string&, const glm::vec4&)
+        ///
+        bool setUniform(const UniformHandle& handle, const glm::vec4& vector);
+
+        /// \copydoc setUniform(const std::string&, const Texture&, const unsigned int)
+        ///
+        bool setUniform(const UniformHandle& handle, const Texture& texture, const unsigned int unit);
+
+        /// \copydoc setUniform(const std::string&, const float)
+        ///
+        bool setUniform(const UniformHandle& handle, const float value);
+
+        /// \copydoc setUniform(const std::string&, const int)
+        ///
+        bool setUniform(const UniformHandle& handle, const int value);
+
+        /// \copydoc setUniform(const std::string&, const bool)
+        ///
+        bool setUniform(const UniformHandle& handle, const bool value);
+
+        /// \brief Check if this program has an active uniform
+        ///
+        /// \param handle The uniform handle
+        ///
+        /// \return True if the uniform exists and is active
+        ///
+        bool hasUniform(const UniformHandle& handle);
+
+        /// \brief Assign a binding point to a uniform block
+        ///
+        /// The engine reserved blocks (see UniformBuffer::Binding) are
+        /// bound automatically when the program is linked.
+        ///
+        /// \param blockName Name of the uniform block
+        /// \param binding The binding point
+        ///
+        /// \return True if the block was found
+        ///
+        bool setUniformBlockBinding(const std::string& blockName, const unsigned int binding);
+
         /// \brief Get the default shader program
         ///
         /// \return Reference to the default shader
@@ -236,9 +336,18 @@ namespace jop
         ///
         int getUniformLocation(const std::string& name);
 
+        /// \brief Get the location of a uniform by handle
+        ///
+        int getUniformLocation(const UniformHandle& handle);
+
+        /// \brief Query the active uniforms after linking
+        ///
+        void reflectUniforms();
+
 
         std::unordered_map<unsigned int, WeakReference<const Shader>> m_shaders;    ///< Map with shaders
         LocationMap m_unifMap;                                                      ///< Map with uniform locations
+        std::vector<int> m_handleLocations;                                         ///< Uniform locations indexed by handle
         unsigned int m_programID;                                                   ///< OpenGL program handle
     };
 
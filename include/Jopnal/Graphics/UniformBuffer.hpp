@@ -0,0 +1,101 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_UNIFORMBUFFER_HPP
+#define JOP_UNIFORMBUFFER_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <Jopnal/Graphics/Buffer.hpp>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    class JOP_API UniformBuffer : public Buffer
+    {
+    public:
+
+        /// Binding points reserved by the engine
+        ///
+        enum Binding : unsigned int
+        {
+            CameraBlock,        ///< Per-camera view & projection data (jop_CameraBlock)
+            LightBlock,         ///< Per-camera light data (jop_LightBlock)
+            ClusterLightBlock,  ///< Clustered light data (jop_ClusterLightBlock)
+            ClusterGridBlock,   ///< Light cluster grid (jop_ClusterGridBlock)
+            ClusterIndexBlock   ///< Clustered light indices (jop_ClusterIndexBlock)
+        };
+
+    public:
+
+        /// \brief Constructor
+        ///
+        /// \param usage Usage type
+        ///
+        UniformBuffer(const Usage usage = Buffer::StreamDraw);
+
+
+        /// \brief Set the buffer data
+        ///
+        /// The old storage will be orphaned, so this can be called
+        /// multiple times per frame without stalling the pipeline.
+        ///
+        /// \param data Pointer to the data
+        /// \param size Size of the buffer data in bytes
+        ///
+        void setData(const void* data, const std::size_t size);
+
+        /// \brief Set buffer sub data
+        ///
+        /// \param data Pointer to the data
+        /// \param offset The start position in the buffer
+        /// \param size Size of the sub data in bytes
+        ///
+        void setSubData(const void* data, const std::size_t offset, const std::size_t size);
+
+        /// \brief Bind this buffer to an indexed binding point
+        ///
+        /// \param binding The binding point
+        ///
+        void bindBase(const unsigned int binding) const;
+
+        /// \brief Check if uniform buffers are supported
+        ///
+        /// Uniform buffers require OpenGL 3.1 or GLES 3.0.
+        ///
+        /// \return True if supported
+        ///
+        static bool isSupported();
+
+        /// \brief Get the maximum size of a uniform block on this system
+        ///
+        /// \return The maximum size in bytes. 0 if uniform buffers aren't supported
+        ///
+        static unsigned int getMaximumSize();
+    };
+}
+
+/// \class jop::UniformBuffer
+/// \ingroup graphics
+
+#endif
\ No newline at end of file
@@ -27,7 +27,10 @@
 #include <Jopnal/Utility/CommandHandler.hpp>
 #include <Jopnal/Utility/DateTime.hpp>
 #include <Jopnal/Utility/DirectoryWatcher.hpp>
+#include <Jopnal/Utility/FrameArena.hpp>
+#include <Jopnal/Utility/Interner.hpp>
 #include <Jopnal/Utility/Json.hpp>
 #include <Jopnal/Utility/Randomizer.hpp>
 #include <Jopnal/Utility/SafeReferenceable.hpp>
-#include <Jopnal/Utility/Thread.hpp>
\ No newline at end of file
+#include <Jopnal/Utility/Thread.hpp>
+#include <Jopnal/Utility/ThreadPool.hpp>
\ No newline at end of file
@@ -40,6 +40,8 @@ namespace jop
     {
         JOP_API std::tuple<std::string, std::string> splitFirstArguments(const std::string& args);
 
+        JOP_API void splitCommand(const std::string& orig, std::string& command, std::string& args);
+
         // Include the helper inl file
         #include <Jopnal/Utility/Inl/CommandParser.inl>
     }
@@ -124,10 +126,49 @@ namespace jop
         ///
         Message::Result execute(const std::string& command, void* instance);
 
+        /// \brief Execute a message
+        ///
+        /// The command of the message is only parsed once, no matter how
+        /// many handlers it's passed to. If the message has typed arguments,
+        /// they're passed to the bound function without any conversion.
+        ///
+        /// \param message The message
+        /// \param instance The class instance to call the command on. Can be nullptr to only consider free functions
+        ///
+        /// \return The message result
+        ///
+        Message::Result execute(const Message& message, void* instance);
+
+        /// \brief Get the identifier of a command
+        ///
+        /// The command is interned the first time this is called.
+        ///
+        /// \param command The command name
+        ///
+        /// \return The command identifier
+        ///
+        static uint32 getCommandID(const std::string& command);
+
+        /// \brief Find the identifier of a command
+        ///
+        /// \param command The command name
+        ///
+        /// \return The command identifier. 0 if no handler has bound the command
+        ///
+        static uint32 findCommandID(const std::string& command);
+
     private:
 
-        std::unordered_map<std::string, std::pair<std::function<void(const std::string&, void*)>, Message::Result>> m_memberParsers;    ///< Parsers for member functions
-        std::unordered_map<std::string, std::pair<std::function<void(const std::string&)>, Message::Result>> m_funcParsers;             ///< Parsers for free functions
+        template<typename ... Args>
+        struct Command
+        {
+            std::function<void(const std::string&, Args...)> parser;    ///< Parses the arguments from a string
+            std::function<bool(const Message&, Args...)> invoker;       ///< Calls the function with typed arguments. Empty if using a custom parser
+            Message::Result result;                                     ///< The result to return
+        };
+
+        std::unordered_map<uint32, Command<void*>> m_memberParsers; ///< Parsers for member functions
+        std::unordered_map<uint32, Command<>> m_funcParsers;        ///< Parsers for free functions
 
     };
 
@@ -167,7 +208,7 @@ namespace jop
 /// \brief Execute a command
 ///
 /// This will search for both free and member functions. This will need to be placed in the
-/// same namespace as the command handler.
+/// same namespace as the command handler. The command can either be a jop::Message or a string.
 ///
 #define JOP_EXECUTE_COMMAND(handlerName, command, instance) ns_##handlerName##_commandHandler.execute(command, instance)
 
@@ -0,0 +1,153 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_FRAMEARENA_HPP
+#define JOP_FRAMEARENA_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <cstddef>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    /// \brief Linear allocator for memory that only lives until the end of the frame
+    ///
+    /// Allocating bumps a pointer and deallocating does nothing. All the memory
+    /// is released at once by reset(), which Engine calls once per frame, after
+    /// everything from the previous frame has finished. When an allocation
+    /// doesn't fit, another block is taken from the heap. On reset, the blocks
+    /// are merged into a single one large enough for the whole frame, so frames
+    /// with a steady workload don't touch the heap.
+    ///
+    /// Use FrameAllocator or FrameVector to back standard containers with the
+    /// arena. Such containers must not outlive the frame.
+    ///
+    /// Allocating is thread safe, resetting is not.
+    ///
+    class JOP_API FrameArena
+    {
+    private:
+
+        JOP_DISALLOW_COPY_MOVE(FrameArena);
+
+    public:
+
+        /// \brief Allocate memory
+        ///
+        /// The memory is aligned for any fundamental type.
+        ///
+        /// \param size Size of the allocation in bytes
+        ///
+        /// \return Pointer to the memory. Valid until the next reset()
+        ///
+        static void* allocate(const std::size_t size);
+
+        /// \brief Release all the memory allocated since the last reset
+        ///
+        /// No memory from the arena may be in use when this is called.
+        ///
+        static void reset();
+
+        /// \brief Get the amount of memory allocated since the last reset
+        ///
+        /// \return The size in bytes
+        ///
+        static std::size_t getUsedSize();
+
+        /// \brief Get the amount of memory reserved by the arena
+        ///
+        /// \return The size in bytes
+        ///
+        static std::size_t getCapacity();
+
+        /// \brief Get the amount of heap allocations made during the last frame
+        ///
+        /// Allocations are only counted if the engine was built with
+        /// JOP_TRACK_HEAP_ALLOCATIONS, which replaces the global operator new.
+        /// Otherwise this always returns 0.
+        ///
+        /// \return The amount of heap allocations between the last two resets
+        ///
+        static uint64 getHeapAllocations();
+    };
+
+    /// \brief Standard allocator using the frame arena
+    ///
+    template<typename T>
+    class FrameAllocator
+    {
+    public:
+
+        typedef T value_type;
+
+    public:
+
+        /// \brief Default constructor
+        ///
+        FrameAllocator() = default;
+
+        /// \brief Converting constructor
+        ///
+        template<typename U>
+        FrameAllocator(const FrameAllocator<U>&);
+
+
+        /// \brief Allocate memory for objects
+        ///
+        /// \param count Amount of objects
+        ///
+        /// \return Pointer to the memory
+        ///
+        T* allocate(const std::size_t count);
+
+        /// \brief Deallocate memory
+        ///
+        /// Does nothing, the memory is released by FrameArena::reset().
+        ///
+        void deallocate(T*, const std::size_t);
+    };
+
+    template<typename T, typename U>
+    bool operator ==(const FrameAllocator<T>&, const FrameAllocator<U>&);
+
+    template<typename T, typename U>
+    bool operator !=(const FrameAllocator<T>&, const FrameAllocator<U>&);
+
+    /// Vector using the frame arena
+    ///
+    template<typename T>
+    using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+    // Include the template implementation file
+    #include <Jopnal/Utility/Inl/FrameArena.inl>
+}
+
+/// \class jop::FrameArena
+/// \ingroup utility
+///
+/// \class jop::FrameAllocator
+/// \ingroup utility
+
+#endif
\ No newline at end of file
@@ -24,7 +24,11 @@ template<typename Func, typename Parser>
 void CommandHandler::bind(const std::string& command, const Func& func, const Parser& parser, const Message::Result result)
 {
     JOP_ASSERT(!command.empty(), "Tried to register an empty command!");
-    m_funcParsers[command] = std::make_pair(std::bind(parser, func, std::placeholders::_1), result);
+
+    auto& comm = m_funcParsers[getCommandID(command)];
+    comm.parser = std::bind(parser, func, std::placeholders::_1);
+    comm.invoker = nullptr;
+    comm.result = result;
 }
 
 //////////////////////////////////////////////
@@ -33,6 +37,7 @@ template<typename Ret, typename ... FuncArgs>
 void CommandHandler::bind(const std::string& command, const std::function<Ret(FuncArgs...)>& func, const Message::Result result)
 {
     bind(command, func, &detail::DefaultParser::parse<Ret, FuncArgs...>, result);
+    m_funcParsers[getCommandID(command)].invoker = detail::TypedInvoker::make<Ret, FuncArgs...>(func);
 }
 
 //////////////////////////////////////////////
@@ -41,6 +46,7 @@ template<typename Ret, typename ... FuncArgs>
 void CommandHandler::bind(const std::string& command, Ret(*func)(FuncArgs...), const Message::Result result)
 {
     bind(command, func, &detail::DefaultParser::parse<Ret, FuncArgs...>, result);
+    m_funcParsers[getCommandID(command)].invoker = detail::TypedInvoker::make<Ret, FuncArgs...>(func);
 }
 
 //////////////////////////////////////////////
@@ -49,7 +55,11 @@ template<typename Func, typename Parser>
 void CommandHandler::bindMember(const std::string& command, const Func& func, const Parser& parser, const Message::Result result)
 {
     JOP_ASSERT(!command.empty(), "Tried to register an empty member command!");
-    m_memberParsers[command] = std::make_pair(std::bind(parser, func, std::placeholders::_1, std::placeholders::_2), result);
+
+    auto& comm = m_memberParsers[getCommandID(command)];
+    comm.parser = std::bind(parser, func, std::placeholders::_1, std::placeholders::_2);
+    comm.invoker = nullptr;
+    comm.result = result;
 }
 
 //////////////////////////////////////////////
@@ -58,6 +68,7 @@ template<typename Ret, typename Class, typename ... FuncArgs>
 void CommandHandler::bindMember(const std::string& command, const std::function<Ret(Class&, FuncArgs...)>& func, const Message::Result result)
 {
     bindMember(command, func, &detail::DefaultParser::parseMember<Ret, Class, FuncArgs...>, result);
+    m_memberParsers[getCommandID(command)].invoker = detail::TypedInvoker::makeMember<Ret, Class, FuncArgs...>(func);
 }
 
 //////////////////////////////////////////////
@@ -67,10 +78,12 @@ void CommandHandler::bindMember(const std::string& command, Ret(Class::*func)(Fu
 {
     // Have to use mem_fn due to a bug in VS
     bindMember(command, std::mem_fn(func), &detail::DefaultParser::parseMember<Ret, Class, FuncArgs...>, result);
+    m_memberParsers[getCommandID(command)].invoker = detail::TypedInvoker::makeMember<Ret, Class, FuncArgs...>(std::mem_fn(func));
 }
 
 template<typename Ret, typename Class, typename ... FuncArgs>
 void CommandHandler::bindMember(const std::string& command, Ret(Class::*func)(FuncArgs...) const, const Message::Result result)
 {
     bindMember(command, std::mem_fn(func), &detail::DefaultParser::parseMember<Ret, const Class, FuncArgs...>, result);
+    m_memberParsers[getCommandID(command)].invoker = detail::TypedInvoker::makeMember<Ret, const Class, FuncArgs...>(std::mem_fn(func));
 }
\ No newline at end of file
@@ -334,4 +334,48 @@ namespace DefaultParser
             MemberHelper<Ret, T, Args...>::parse(func, args, *static_cast<T*>(instance));
         }
     }
+}
+
+//////////////////////////////////////////////
+
+namespace TypedInvoker
+{
+    // The type of the typed message arguments that can be passed to a function
+    template<typename ... Args>
+    struct Arguments
+    {
+        typedef std::tuple<typename std::remove_cv<typename RealType<Args>::type>::type...> type;
+    };
+
+    template<typename Ret, typename ... Args, typename Func>
+    std::function<bool(const Message&)> make(const Func& func)
+    {
+        return [func](const Message& message) -> bool
+        {
+            auto args = message.getTypedArguments<typename Arguments<Args...>::type>();
+
+            if (!args)
+                return false;
+
+            ArgumentApplier::apply(func, *args);
+            return true;
+        };
+    }
+
+    template<typename Ret, typename T, typename ... Args, typename Func>
+    std::function<bool(const Message&, void*)> makeMember(const Func& func)
+    {
+        return [func](const Message& message, void* instance) -> bool
+        {
+            auto args = message.getTypedArguments<typename Arguments<Args...>::type>();
+
+            if (!args)
+                return false;
+
+            if (instance)
+                ArgumentApplier::applyMember(func, *static_cast<T*>(instance), *args);
+
+            return true;
+        };
+    }
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+
+template<typename T>
+template<typename U>
+FrameAllocator<T>::FrameAllocator(const FrameAllocator<U>&)
+{}
+
+//////////////////////////////////////////////
+
+template<typename T>
+T* FrameAllocator<T>::allocate(const std::size_t count)
+{
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types can't be allocated from the frame arena");
+
+    return static_cast<T*>(FrameArena::allocate(count * sizeof(T)));
+}
+
+//////////////////////////////////////////////
+
+template<typename T>
+void FrameAllocator<T>::deallocate(T*, const std::size_t)
+{}
+
+//////////////////////////////////////////////
+
+template<typename T, typename U>
+bool operator ==(const FrameAllocator<T>&, const FrameAllocator<U>&)
+{
+    return true;
+}
+
+//////////////////////////////////////////////
+
+template<typename T, typename U>
+bool operator !=(const FrameAllocator<T>&, const FrameAllocator<U>&)
+{
+    return false;
+}
\ No newline at end of file
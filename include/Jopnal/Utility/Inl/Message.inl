@@ -34,4 +34,28 @@ Message& Message::pushReference(const T& ref)
 {
     m_command << ' ' << std::hex << reinterpret_cast<const void*>(&ref);
     return *this;
+}
+
+//////////////////////////////////////////////
+
+template<typename ... Args>
+Message& Message::setArguments(const Args&... args)
+{
+    typedef std::tuple<typename std::decay<Args>::type...> Tuple;
+
+    m_typedArgs = std::make_shared<Tuple>(args...);
+    m_typedArgsType = &typeid(Tuple);
+
+    return *this;
+}
+
+//////////////////////////////////////////////
+
+template<typename Tuple>
+const Tuple* Message::getTypedArguments() const
+{
+    if (m_typedArgsType && *m_typedArgsType == typeid(Tuple))
+        return static_cast<const Tuple*>(m_typedArgs.get());
+
+    return nullptr;
 }
\ No newline at end of file
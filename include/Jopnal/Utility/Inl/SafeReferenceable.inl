@@ -30,7 +30,7 @@ inline WeakReference<To> static_ref_cast(const WeakReference<From>& from)
 template<typename To, typename From>
 inline WeakReference<To> dynamic_ref_cast(const WeakReference<From>& from)
 {
-    if (!from.expired() && dynamic_cast<To*>(*from.m_ref.lock()))
+    if (dynamic_cast<const To*>(from.get()))
         return static_ref_cast<To>(from);
 
     return WeakReference<To>();
@@ -40,33 +40,43 @@ inline WeakReference<To> dynamic_ref_cast(const WeakReference<From>& from)
 
 template<typename T>
 SafeReferenceable<T>::SafeReferenceable(T* ref)
-    : m_ref(std::make_shared<T*>(nullptr))
-{
-    *m_ref = ref;
-}
+    : m_index(detail::HandleTable::allocate(ref))
+{}
 
 template<typename T>
 SafeReferenceable<T>::SafeReferenceable(SafeReferenceable<T>&& other)
-    : m_ref(std::move(other.m_ref))
+    : m_index(other.m_index)
 {
-    if (m_ref)
-        *m_ref = static_cast<T*>(this);
+    other.m_index = detail::HandleTable::InvalidIndex;
+
+    if (auto slot = detail::HandleTable::find(m_index))
+        slot->object.store(static_cast<T*>(this), std::memory_order_release);
 }
 
 template<typename T>
 SafeReferenceable<T>& SafeReferenceable<T>::operator =(SafeReferenceable<T>&& other)
 {
-    m_ref = std::move(other.m_ref);
+    if (&other != this)
+    {
+        if (m_index != detail::HandleTable::InvalidIndex)
+            detail::HandleTable::release(m_index);
 
-    if (m_ref)
-        *m_ref = static_cast<T*>(this);
+        m_index = other.m_index;
+        other.m_index = detail::HandleTable::InvalidIndex;
+
+        if (auto slot = detail::HandleTable::find(m_index))
+            slot->object.store(static_cast<T*>(this), std::memory_order_release);
+    }
 
     return *this;
 }
 
 template<typename T>
 SafeReferenceable<T>::~SafeReferenceable()
-{}
+{
+    if (m_index != detail::HandleTable::InvalidIndex)
+        detail::HandleTable::release(m_index);
+}
 
 //////////////////////////////////////////////
 
@@ -82,15 +92,16 @@ inline WeakReference<T> SafeReferenceable<T>::getReference() const
 
 template<typename T>
 inline WeakReference<T>::WeakReference(const SafeReferenceable<T>& ref)
-    : m_ref(ref.m_ref)
-{}
+{
+    *this = ref;
+}
 
 //////////////////////////////////////////////
 
 template<typename T>
 inline bool WeakReference<T>::expired() const
 {
-    return m_ref.expired();
+    return get() == nullptr;
 }
 
 //////////////////////////////////////////////
@@ -98,7 +109,8 @@ inline bool WeakReference<T>::expired() const
 template<typename T>
 inline void WeakReference<T>::reset()
 {
-    m_ref.reset();
+    m_index = detail::HandleTable::InvalidIndex;
+    m_generation = 0;
 }
 
 //////////////////////////////////////////////
@@ -106,7 +118,7 @@ inline void WeakReference<T>::reset()
 template<typename T>
 inline T* WeakReference<T>::get()
 {
-    return m_ref.expired() ? nullptr : *m_ref.lock();
+    return static_cast<T*>(detail::HandleTable::get(m_index, m_generation));
 }
 
 //////////////////////////////////////////////
@@ -114,7 +126,7 @@ inline T* WeakReference<T>::get()
 template<typename T>
 inline const T* WeakReference<T>::get() const
 {
-    return m_ref.expired() ? nullptr : *m_ref.lock();
+    return static_cast<const T*>(detail::HandleTable::get(m_index, m_generation));
 }
 
 //////////////////////////////////////////////
@@ -122,7 +134,7 @@ inline const T* WeakReference<T>::get() const
 template<typename T>
 inline T& WeakReference<T>::operator *()
 {
-    return **m_ref.lock();
+    return *get();
 }
 
 //////////////////////////////////////////////
@@ -130,7 +142,7 @@ inline T& WeakReference<T>::operator *()
 template<typename T>
 inline const T& WeakReference<T>::operator *() const
 {
-    return **m_ref.lock();
+    return *get();
 }
 
 //////////////////////////////////////////////
@@ -178,6 +190,10 @@ inline WeakReference<T>::operator bool() const
 template<typename T>
 inline WeakReference<T>& WeakReference<T>::operator =(const SafeReferenceable<T>& other)
 {
-    m_ref = other.m_ref;
+    auto slot = detail::HandleTable::find(other.m_index);
+
+    m_index = slot ? other.m_index : detail::HandleTable::InvalidIndex;
+    m_generation = slot ? slot->generation.load(std::memory_order_acquire) : 0;
+
     return *this;
 }    
\ No newline at end of file
@@ -0,0 +1,31 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+
+template<typename Func>
+void ThreadPool::parallelFor(const std::size_t count, const std::size_t grain, const Func& func)
+{
+    // The function outlives the chunks, so it can be called through a plain pointer
+    parallelForImpl(count, grain, &func, [](const void* f, const std::size_t begin, const std::size_t end)
+    {
+        (*static_cast<const Func*>(f))(begin, end);
+    });
+}
\ No newline at end of file
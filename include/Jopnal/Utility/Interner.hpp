@@ -0,0 +1,117 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_INTERNER_HPP
+#define JOP_INTERNER_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    /// \brief String interner
+    ///
+    /// Maps strings to small integer identifiers, so that they can be stored
+    /// and compared as integers. Identifiers are given in the order the strings
+    /// are first interned, starting from 1. They stay valid for the lifetime of
+    /// the interner.
+    ///
+    /// All the functions are thread safe.
+    ///
+    class JOP_API Interner
+    {
+    private:
+
+        JOP_DISALLOW_COPY_MOVE(Interner);
+
+    public:
+
+        /// \brief Constructor
+        ///
+        Interner();
+
+
+        /// \brief Intern a string
+        ///
+        /// \param str The string to intern
+        ///
+        /// \return The identifier of the string
+        ///
+        uint32 intern(const std::string& str);
+
+        /// \brief Find the identifier of a string
+        ///
+        /// \param str The string to find
+        ///
+        /// \return The identifier. 0 if the string hasn't been interned
+        ///
+        uint32 find(const std::string& str) const;
+
+        /// \brief Get an interned string
+        ///
+        /// \param ID The identifier
+        ///
+        /// \return Reference to the string. Empty string if the identifier is not valid
+        ///
+        const std::string& getString(const uint32 ID) const;
+
+        /// \brief Get the amount of interned strings
+        ///
+        /// \return The amount of strings
+        ///
+        uint32 getSize() const;
+
+
+        /// \brief Get the interner for object tags
+        ///
+        /// \return Reference to the interner
+        ///
+        /// \see Object::getTagID()
+        ///
+        static Interner& getTags();
+
+        /// \brief Get the interner for object identifiers
+        ///
+        /// \return Reference to the interner
+        ///
+        /// \see Object::getIDKey()
+        ///
+        static Interner& getIDs();
+
+    private:
+
+        mutable std::mutex m_mutex;                     ///< Mutex
+        std::unordered_map<std::string, uint32> m_IDs;  ///< Identifiers of the strings
+        std::deque<const std::string*> m_strings;       ///< The strings, by identifier - 1. Point to the keys of m_IDs
+    };
+}
+
+/// \class jop::Interner
+/// \ingroup utility
+
+#endif
\ No newline at end of file
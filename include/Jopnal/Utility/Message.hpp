@@ -25,10 +25,13 @@
 // Headers
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Utility/Assert.hpp>
+#include <memory>
 #include <string>
+#include <tuple>
 #include <typeinfo>
 #include <sstream>
-#include <unordered_set>
+#include <type_traits>
+#include <vector>
 
 //////////////////////////////////////////////
 
@@ -118,12 +121,59 @@ namespace jop
         template<typename T>
         Message& pushReference(const T& ref);
 
+        /// \brief Set typed arguments
+        ///
+        /// Typed arguments are passed to the bound command function as is,
+        /// instead of being converted to and from a string. Their types must
+        /// match the function's parameter types exactly, after removing top-level
+        /// const. Reference parameters must be passed using std::ref() or std::cref(),
+        /// except for const std::string&, which is passed as std::string.
+        ///
+        /// When typed arguments are set, arguments pushed as strings are ignored.
+        ///
+        /// \param args The arguments
+        ///
+        /// \return Reference to self
+        ///
+        template<typename ... Args>
+        Message& setArguments(const Args&... args);
+
+        /// \brief Get the typed arguments
+        ///
+        /// \return Pointer to the arguments. nullptr if there are no typed arguments or their type doesn't match
+        ///
+        template<typename Tuple>
+        const Tuple* getTypedArguments() const;
+
+        /// \brief Check if this message has typed arguments
+        ///
+        /// \return True if typed arguments have been set
+        ///
+        bool hasTypedArguments() const;
+
         /// \brief Get a string with the command and arguments
         ///
         /// \return A new string with the internal buffer's contents
         ///
         const std::string& getString() const;
 
+        /// \brief Get the command identifier
+        ///
+        /// The command is parsed and looked up the first time this is called.
+        /// Arguments pushed after that are ignored.
+        ///
+        /// \return The command identifier. 0 if no command handler has bound the command
+        ///
+        /// \see CommandHandler::findCommandID()
+        ///
+        uint32 getCommandID() const;
+
+        /// \brief Get the string arguments
+        ///
+        /// \return String with the arguments, without the command
+        ///
+        const std::string& getArguments() const;
+
         /// \brief Check if the given bit field should pass the filter
         ///
         /// \param filter The bits to check. Only one match is required for a pass
@@ -142,11 +192,33 @@ namespace jop
 
         /// \brief Check if the given tags should pass the filter
         ///
-        /// \param tags The tags to check
+        /// \param tags The tag identifiers to check, in ascending order
         ///
         /// \return True if the filter was passed
         ///
-        bool passFilter(const std::unordered_set<std::string>& tags) const;
+        /// \see Object::getTags()
+        ///
+        bool passFilter(const std::vector<uint32>& tags) const;
+
+        /// \brief Get the key of the exact id filter
+        ///
+        /// \return The interned id. 0 if there's no exact id filter
+        ///
+        /// \see Object::getIDKey()
+        ///
+        uint32 getIDKey() const;
+
+        /// \brief Get the tag filter
+        ///
+        /// \return The tag identifiers in ascending order. Empty if there's no tag filter
+        ///
+        const std::vector<uint32>& getTagFilter() const;
+
+        /// \brief Check if all the tags in the filter are required
+        ///
+        /// \return True if all the tags are required, false if any one of them is enough
+        ///
+        bool requiresAllTags() const;
 
         /// \brief Set the filter
         ///
@@ -164,13 +236,25 @@ namespace jop
 
     private:
 
+        /// \brief Split the command and arguments, if not done yet
+        ///
+        void parseCommand() const;
+
+
         mutable std::ostringstream m_command;                                       ///< Buffer containing the command and arguments in string form
         mutable std::string m_commandStr;                                           ///< String with the command & arguments
         std::string m_idPattern;                                                    ///< The id filter to compare any passed ids against
-        std::unordered_set<std::string> m_tags;                                     ///< Tags to compare against
+        std::vector<uint32> m_tags;                                                 ///< Tag identifiers to compare against, in ascending order
+        uint32 m_idKey;                                                             ///< Interned id of an exact id filter
+        bool m_allTags;                                                             ///< Are all the tags required?
         unsigned short m_filterBits;                                                ///< Bit field with the system filter bits
         bool (*m_idMatchMethod)(const std::string&, const std::string&);            ///< Function to use in comparing the filter id and the passed id
         bool (*m_tagMatchMethod)(const decltype(m_tags)&, const decltype(m_tags)&); ///< Function to use in comparing the filter tags and the passed tags
+        std::shared_ptr<const void> m_typedArgs;                                    ///< Typed arguments
+        const std::type_info* m_typedArgsType;                                      ///< Type of the typed argument tuple
+        mutable std::string m_args;                                                 ///< String arguments, without the command
+        mutable uint32 m_commandID;                                                 ///< Command identifier
+        mutable bool m_parsed;                                                      ///< Have the command & arguments been split?
     };
 
     // Include the template implementation file
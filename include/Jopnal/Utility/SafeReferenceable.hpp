@@ -25,7 +25,7 @@
 // Headers
 #include <Jopnal/Header.hpp>
 #include <Jopnal/Utility/Assert.hpp>
-#include <memory>
+#include <atomic>
 
 //////////////////////////////////////////////
 
@@ -59,6 +59,104 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    namespace detail
+    {
+        /// \brief Slot table backing SafeReferenceable & WeakReference
+        ///
+        /// Every referenceable object owns a slot, which holds a pointer to the
+        /// object and a generation counter. A weak reference stores the slot index
+        /// and the generation it was created with. When the object is destroyed
+        /// the generation is incremented, which expires all the references at once.
+        ///
+        /// Slots are allocated in pages that never move, so looking up a slot
+        /// doesn't require locking. References may be resolved while other threads
+        /// create and destroy objects: a reader checks the generation both before
+        /// and after reading the object pointer, see get().
+        ///
+        class JOP_API HandleTable
+        {
+        public:
+
+            struct Slot
+            {
+                std::atomic<void*> object;          ///< The bound object
+                std::atomic<uint32> generation;     ///< Incremented when the object is released
+                uint32 nextFree;                    ///< Next free slot
+            };
+
+            static const uint32 InvalidIndex = 0xFFFFFFFF;
+
+        public:
+
+            /// \brief Allocate a slot
+            ///
+            /// \param object The object to bind
+            ///
+            /// \return Index of the slot. InvalidIndex if the table is full
+            ///
+            static uint32 allocate(void* object);
+
+            /// \brief Release a slot
+            ///
+            /// This expires every reference to the slot.
+            ///
+            /// \param index Index of the slot
+            ///
+            static void release(const uint32 index);
+
+            /// \brief Get the object bound to a slot
+            ///
+            /// \param index Index of the slot
+            /// \param generation Generation the reference was created with
+            ///
+            /// \return Pointer to the object. nullptr if the index is not valid or the object was released
+            ///
+            static void* get(const uint32 index, const uint32 generation)
+            {
+                auto slot = find(index);
+
+                if (!slot || slot->generation.load(std::memory_order_acquire) != generation)
+                    return nullptr;
+
+                void* object = slot->object.load(std::memory_order_relaxed);
+
+                // The slot may have been released & reused while reading the object
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                return slot->generation.load(std::memory_order_relaxed) == generation ? object : nullptr;
+            }
+
+            /// \brief Find a slot
+            ///
+            /// \param index Index of the slot
+            ///
+            /// \return Pointer to the slot. nullptr if the index is not valid
+            ///
+            static Slot* find(const uint32 index)
+            {
+                if ((index >> PageShift) >= PageCount)
+                    return nullptr;
+
+                Slot* page = ms_pages[index >> PageShift].load(std::memory_order_acquire);
+
+                return page ? page + (index & (PageSize - 1)) : nullptr;
+            }
+
+        private:
+
+            enum : uint32
+            {
+                PageShift = 12,
+                PageSize = 1 << PageShift,
+                PageCount = 4096
+            };
+
+            static std::atomic<Slot*> ms_pages[PageCount];  ///< Slot pages
+        };
+    }
+
+    //////////////////////////////////////////////
+
     template<typename T>
     class SafeReferenceable
     {
@@ -102,7 +200,7 @@ namespace jop
 
     private:
 
-        std::shared_ptr<T*> m_ref;  ///< The bound reference
+        uint32 m_index; ///< Slot index
     };
 
     //////////////////////////////////////////////
@@ -202,7 +300,8 @@ namespace jop
 
     private:
 
-        std::weak_ptr<T*> m_ref;    ///< The bound reference
+        uint32 m_index = detail::HandleTable::InvalidIndex; ///< Slot index
+        uint32 m_generation = 0;                            ///< Generation of the slot when this reference was bound
     };
 
     // Include the template implementation file
@@ -109,12 +109,27 @@ namespace jop
 
         /// \brief Set thread priority
         ///
+        /// On Linux, the priorities below Normal use the SCHED_BATCH & SCHED_IDLE
+        /// policies, and the ones above it SCHED_RR, which usually requires elevated
+        /// privileges.
+        ///
         /// \param priority The priority to set
         ///
         /// \return True if priority was set successfully
         ///
         bool setPriority(const Priority priority);
 
+        /// \brief Set the processor affinity
+        ///
+        /// Each set bit allows the thread to run on the processor with the
+        /// corresponding index. Not supported on OS X.
+        ///
+        /// \param mask The affinity mask
+        ///
+        /// \return True if the affinity was set successfully
+        ///
+        bool setAffinity(const uint64 mask);
+
         /// \brief Terminate this thread
         ///
         /// This method is unsafe. You should always attempt to make
@@ -0,0 +1,194 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_THREADPOOL_HPP
+#define JOP_THREADPOOL_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <Jopnal/Utility/Thread.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    /// \brief Work-stealing task scheduler
+    ///
+    /// Every worker thread owns a task deque. Workers push and pop tasks at the
+    /// back of their own deque, and steal from the front of the other deques when
+    /// their own runs dry. Tasks submitted from outside the pool go to a shared
+    /// queue, which is also checked before stealing.
+    ///
+    /// A thread waiting for a task (wait(), parallelFor()) runs other tasks in
+    /// the meantime, so tasks may freely submit and wait for more tasks.
+    ///
+    /// The memory of finished tasks is recycled and parallelFor() doesn't wrap
+    /// the function into a std::function, so scheduling doesn't allocate once
+    /// the pool has warmed up.
+    ///
+    class JOP_API ThreadPool
+    {
+    private:
+
+        JOP_DISALLOW_COPY_MOVE(ThreadPool);
+
+        struct Worker;
+        struct TaskQueue;
+
+        typedef void (*RangeInvoker)(const void*, const std::size_t, const std::size_t);
+
+    public:
+
+        struct Task;
+
+        /// Task function
+        ///
+        typedef std::function<void()> TaskFunc;
+
+        /// Function to run over a range
+        ///
+        /// The parameters are the first and one-past-last index of the range.
+        ///
+        typedef std::function<void(const std::size_t, const std::size_t)> RangeFunc;
+
+        /// Handle to a submitted task
+        ///
+        typedef std::shared_ptr<Task> TaskHandle;
+
+    public:
+
+        /// \brief Constructor
+        ///
+        /// Starts the worker threads immediately.
+        ///
+        /// \param threads Amount of worker threads. The calling thread always
+        ///                takes part in the work, so 0 means no parallelism
+        /// \param priority Priority of the worker threads
+        /// \param pinThreads Pin each worker thread to its own processor?
+        ///
+        explicit ThreadPool(const unsigned int threads, const Thread::Priority priority = Thread::Priority::Normal, const bool pinThreads = false);
+
+        /// \brief Destructor
+        ///
+        /// Waits for the worker threads to return. Tasks that haven't been
+        /// started yet are discarded.
+        ///
+        ~ThreadPool();
+
+
+        /// \brief Submit a task
+        ///
+        /// The task is run once all of its dependencies have finished.
+        ///
+        /// \param func The task function
+        /// \param dependencies Tasks that need to finish before this one is started
+        ///
+        /// \return Handle to the task
+        ///
+        TaskHandle submit(TaskFunc func, const std::vector<TaskHandle>& dependencies = std::vector<TaskHandle>());
+
+        /// \brief Wait for a task to finish
+        ///
+        /// The calling thread runs other tasks while waiting.
+        ///
+        /// \param task The task to wait for
+        ///
+        void wait(const TaskHandle& task);
+
+        /// \brief Check if a task has finished
+        ///
+        /// \param task The task to check
+        ///
+        /// \return True if finished
+        ///
+        static bool isDone(const TaskHandle& task);
+
+        /// \brief Run a function over a range in parallel
+        ///
+        /// The range is split into chunks, which are submitted as tasks. The
+        /// calling thread takes part in the work and this function returns once
+        /// every chunk has been processed. Nested calls are allowed.
+        ///
+        /// \param count Size of the range
+        /// \param grain Minimum chunk size
+        /// \param func The function to run for each chunk. Must be callable as func(begin, end), see RangeFunc
+        ///
+        template<typename Func>
+        void parallelFor(const std::size_t count, const std::size_t grain, const Func& func);
+
+        /// \brief Get the amount of worker threads
+        ///
+        /// \return The amount of worker threads
+        ///
+        unsigned int getThreadCount() const;
+
+        /// \brief Get the engine's shared thread pool
+        ///
+        /// The amount of worker threads is read from engine@Threading|uWorkerThreads.
+        /// 0 means one less than the amount of hardware threads. The worker priority
+        /// (0 - 4, lowest to highest) is read from engine@Threading|uWorkerPriority and
+        /// processor pinning from engine@Threading|bPinWorkerThreads.
+        ///
+        /// \return Reference to the thread pool
+        ///
+        static ThreadPool& getDefault();
+
+    private:
+
+        void work(const std::size_t index);
+
+        void schedule(TaskHandle task);
+
+        bool runOne();
+
+        TaskHandle findTask();
+
+        void run(const TaskHandle& task);
+
+        void parallelForImpl(const std::size_t count, const std::size_t grain, const void* func, RangeInvoker invoker);
+
+
+        std::vector<std::unique_ptr<Worker>> m_workers; ///< Worker states, one per thread
+        std::vector<Thread> m_threads;                  ///< Worker threads
+        std::unique_ptr<TaskQueue> m_shared;            ///< Tasks submitted from outside the pool
+        std::mutex m_sharedMutex;                       ///< Mutex for the shared queue
+        std::mutex m_sleepMutex;                        ///< Mutex for sleeping workers
+        std::condition_variable m_wakeCond;             ///< Signaled when a task is queued, or when quitting
+        std::atomic<std::size_t> m_queued;              ///< Amount of queued tasks
+        std::atomic<bool> m_quit;                       ///< Should the worker threads return?
+    };
+
+    // Include the template implementation file
+    #include <Jopnal/Utility/Inl/ThreadPool.inl>
+}
+
+/// \class jop::ThreadPool
+/// \ingroup utility
+
+#endif
\ No newline at end of file
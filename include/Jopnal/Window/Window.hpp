@@ -60,7 +60,6 @@ namespace jop
 
         private:
 
-            Clock m_frameClock;
             Window& m_windowRef;
         };
     }
@@ -171,6 +170,14 @@ namespace jop
         ///
         bool isOpen() const;
 
+        /// \brief Check if this window has input focus
+        ///
+        /// A minimized window is never considered to have focus.
+        ///
+        /// \return True if the window is open and has focus
+        ///
+        bool hasFocus() const;
+
         /// \brief Set the event handler
         ///
         /// This function will automatically pass a reference of this
@@ -227,6 +234,16 @@ namespace jop
         ///
         static void pollEvents();
 
+        /// \brief Wait for events of all open windows
+        ///
+        /// This blocks until at least one event is received or the time out
+        /// expires, and then invokes the appropriate callbacks. Where waiting
+        /// isn't supported, this sleeps for the whole duration before polling.
+        ///
+        /// \param timeout Maximum time to wait in seconds
+        ///
+        static void waitEvents(const float timeout);
+
         /// \brief Set the mouse mode
         ///
         /// \param mode The mouse mode
@@ -26,6 +26,7 @@
 
     #include <Jopnal/Core/Component.hpp>
 
+    #include <Jopnal/Core/ComponentRegistry.hpp>
     #include <Jopnal/Utility/CommandHandler.hpp>
     #include <Jopnal/Core/Serializer.hpp>
     #include <Jopnal/Core/DebugHandler.hpp>
@@ -72,17 +73,33 @@ namespace jop
     //////////////////////////////////////////////
 
     Component::Component(Object& object, const uint32 ID)
-        : m_objectRef   (object),
-          m_ID          (ID)
+        : m_ID            (ID),
+          m_typeID        (ComponentRegistry::InvalidType),
+          m_typeIndex     (0),
+          m_batch         (nullptr),
+          m_batchIndex    (0),
+          m_updateEnabled (true),
+          m_objectRef     (object)
     {}
 
     Component::Component(const Component& other, Object& newObj)
-        : m_objectRef   (newObj),
-          m_ID          (other.m_ID)
+        : m_ID            (other.m_ID),
+          m_typeID        (ComponentRegistry::InvalidType),
+          m_typeIndex     (0),
+          m_batch         (nullptr),
+          m_batchIndex    (0),
+          m_updateEnabled (other.m_updateEnabled),
+          m_objectRef     (newObj)
     {}
 
     Component::~Component()
-    {}
+    {
+        // Destroyed during a batched scene update, before getting updated
+        if (m_batch)
+            (*m_batch)[m_batchIndex] = nullptr;
+
+        ComponentRegistry::unbind(*this);
+    }
 
     //////////////////////////////////////////////
 
@@ -101,6 +118,20 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    void Component::setUpdateEnabled(const bool enabled)
+    {
+        m_updateEnabled = enabled;
+    }
+
+    //////////////////////////////////////////////
+
+    bool Component::isUpdateEnabled() const
+    {
+        return m_updateEnabled;
+    }
+
+    //////////////////////////////////////////////
+
     uint32 Component::getID() const
     {
         return m_ID;
@@ -115,6 +146,13 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    uint32 Component::getTypeID() const
+    {
+        return m_typeID;
+    }
+
+    //////////////////////////////////////////////
+
     WeakReference<Object> Component::getObject()
     {
         return m_objectRef;
@@ -143,7 +181,10 @@ namespace jop
         {
             if (itr->get() == this)
             {
+                auto self = std::move(*itr);
                 comps.erase(itr);
+
+                Object::destroyComponent(std::move(self));
                 break;
             }
         }
@@ -153,6 +194,6 @@ namespace jop
 
     Message::Result Component::receiveMessage(const Message& message)
     {
-        return JOP_EXECUTE_COMMAND(Component, message.getString(), this);
+        return JOP_EXECUTE_COMMAND(Component, message, this);
     }
 }
\ No newline at end of file
@@ -0,0 +1,180 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Core/ComponentRegistry.hpp>
+
+    #include <Jopnal/Core/DebugHandler.hpp>
+    #include <atomic>
+    #include <mutex>
+    #include <typeindex>
+    #include <unordered_map>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    struct RegistryState
+    {
+        std::mutex mutex;
+        std::unordered_map<std::type_index, jop::uint32> types;
+        std::vector<jop::Component*> components[jop::ComponentRegistry::MaxTypes];
+    };
+
+    RegistryState& getState()
+    {
+        // Leaked on purpose, components may be destroyed during static destruction
+        static RegistryState* state = new RegistryState;
+        return *state;
+    }
+
+    // Cached relations, one row per target type. Rows are allocated when first needed
+    std::atomic<std::atomic<jop::uint8>*> ns_relations[jop::ComponentRegistry::MaxTypes];
+}
+
+namespace jop
+{
+    std::atomic<bool> ComponentRegistry::ms_skipUpdate[ComponentRegistry::MaxTypes];
+
+    //////////////////////////////////////////////
+
+    uint32 ComponentRegistry::getTypeID(const std::type_info& info)
+    {
+        auto& state = getState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        auto itr = state.types.find(std::type_index(info));
+
+        if (itr != state.types.end())
+            return itr->second;
+
+        // Identifier 0 is reserved for InvalidType
+        const uint32 ID = static_cast<uint32>(state.types.size() + 1);
+
+        if (ID >= MaxTypes)
+        {
+            JOP_DEBUG_WARNING("Maximum amount of component types reached, \"" << info.name() << "\" will use slower lookups");
+            return InvalidType;
+        }
+
+        state.types[std::type_index(info)] = ID;
+
+        return ID;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 ComponentRegistry::registerType(const std::type_info& info, const bool overridesUpdate)
+    {
+        const uint32 ID = getTypeID(info);
+
+        // Types registered by type info alone are always updated, as it's not known
+        // whether they override update()
+        if (ID != InvalidType)
+            ms_skipUpdate[ID].store(!overridesUpdate, std::memory_order_relaxed);
+
+        return ID;
+    }
+
+    //////////////////////////////////////////////
+
+    const std::vector<Component*>& ComponentRegistry::getComponents(const uint32 type)
+    {
+        return getState().components[type < MaxTypes ? type : InvalidType];
+    }
+
+    //////////////////////////////////////////////
+
+    void ComponentRegistry::bind(Component& component, const uint32 type)
+    {
+        auto& state = getState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        JOP_ASSERT(component.m_typeID == InvalidType, "Component type was already bound!");
+
+        if (type == InvalidType || type >= MaxTypes)
+            return;
+
+        auto& list = state.components[type];
+
+        component.m_typeID = type;
+        component.m_typeIndex = static_cast<uint32>(list.size());
+        list.push_back(&component);
+    }
+
+    //////////////////////////////////////////////
+
+    void ComponentRegistry::unbind(Component& component)
+    {
+        if (component.m_typeID == InvalidType)
+            return;
+
+        auto& state = getState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        auto& list = state.components[component.m_typeID];
+
+        // Swap & pop to keep the list dense
+        list[component.m_typeIndex] = list.back();
+        list[component.m_typeIndex]->m_typeIndex = component.m_typeIndex;
+        list.pop_back();
+
+        component.m_typeID = InvalidType;
+    }
+
+    //////////////////////////////////////////////
+
+    uint8 ComponentRegistry::getRelation(const uint32 target, const uint32 type)
+    {
+        auto row = ns_relations[target].load(std::memory_order_acquire);
+
+        return row ? row[type].load(std::memory_order_relaxed) : static_cast<uint8>(Unresolved);
+    }
+
+    //////////////////////////////////////////////
+
+    void ComponentRegistry::setRelation(const uint32 target, const uint32 type, const uint8 relation)
+    {
+        auto row = ns_relations[target].load(std::memory_order_acquire);
+
+        if (!row)
+        {
+            std::lock_guard<std::mutex> lock(getState().mutex);
+
+            row = ns_relations[target].load(std::memory_order_acquire);
+
+            if (!row)
+            {
+                row = new std::atomic<uint8>[MaxTypes]();
+                ns_relations[target].store(row, std::memory_order_release);
+            }
+        }
+
+        row[type].store(relation, std::memory_order_relaxed);
+    }
+}
\ No newline at end of file
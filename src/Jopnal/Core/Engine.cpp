@@ -29,6 +29,7 @@
     #include <Jopnal/Audio/AudioDevice.hpp>
     #include <Jopnal/Core/Scene.hpp>
     #include <Jopnal/Core/FileLoader.hpp>
+    #include <Jopnal/Core/Profiler.hpp>
     #include <Jopnal/Core/SettingManager.hpp>
     #include <Jopnal/Core/ResourceManager.hpp>
     #include <Jopnal/Graphics/MainRenderTarget.hpp>
@@ -39,11 +40,15 @@
     #include <Jopnal/Graphics/PostProcessor.hpp>
     #include <Jopnal/Graphics/RenderPass.hpp>
     #include <Jopnal/Utility/CommandHandler.hpp>
+    #include <Jopnal/Utility/FrameArena.hpp>
+    #include <Jopnal/Utility/ThreadPool.hpp>
     #include <Jopnal/Window/Window.hpp>
     #include <Jopnal/STL.hpp>
     #include <Jopnal/Core/Win32/Win32.hpp>
     #include <Jopnal/Core/Android/ActivityState.hpp>
 
+    #include <thread>
+
     #ifndef JOP_OS_WINDOWS
         #include <unistd.h>
     #endif
@@ -60,6 +65,29 @@ namespace
     int ns_argc;
     char** ns_argv;
 
+    // Was the main window created visible? Hidden windows never get focus
+    bool ns_mainWindowVisible = false;
+
+    // Is this thread running the pipelined simulation?
+    thread_local bool ns_simulationThread = false;
+
+    // Wait until the clock shows the target time. Sleeps tend to overshoot,
+    // so when precision is needed, the last bit is spun instead
+    void waitUntil(const jop::Clock& clock, const double target, const bool precise)
+    {
+        const double spinTime = precise ? 0.002 : 0.0;
+        const double remaining = target - clock.getElapsedTime().asSeconds();
+
+        if (remaining > spinTime)
+            std::this_thread::sleep_for(std::chrono::duration<double>(remaining - spinTime));
+
+        if (precise)
+        {
+            while (clock.getElapsedTime().asSeconds() < target)
+                std::this_thread::yield();
+        }
+    }
+
     void printOpenGLInfo()
     {
         using namespace jop;
@@ -136,6 +164,10 @@ namespace jop
         : m_sharedScene         (),
           m_totalTime           (0.0),
           m_deltaTimeUnscaled   (0.f),
+          m_fixedTimestep       (0.f),
+          m_interpolationAlpha  (0.f),
+          m_skippedUpdates      (0),
+          m_pipelined           (false),
           m_subsystems          (),
           m_currentScene        (),
           m_newScene            (nullptr),
@@ -202,6 +234,7 @@ namespace jop
             }
 
             m_mainWindow = &createSubsystem<Window>(winSettings);
+            ns_mainWindowVisible = winSettings.visible;
             printOpenGLInfo();
         }
 
@@ -254,10 +287,154 @@ namespace jop
         if (!eng.m_currentScene)
             JOP_DEBUG_WARNING("No scene was loaded before entering main loop");
 
+        const bool fixedStep = SettingManager::get<bool>("engine@Time|bFixedTimestep", true);
+        const bool interpolate = fixedStep && SettingManager::get<bool>("engine@Time|bInterpolation", true);
+        const float timeStep = 1.f / static_cast<float>(std::max(1u, SettingManager::get<unsigned int>("engine@Time|uUpdateFrequency", 60)));
+        const unsigned int maxUpdates = std::max(1u, SettingManager::get<unsigned int>("engine@Time|uMaxUpdatesPerFrame", 5));
+
+        eng.m_fixedTimestep.store(fixedStep ? timeStep : 0.f);
+
+        const bool pipelined = SettingManager::get<bool>("engine@Threading|bPipelinedSimulation", false);
+
+        eng.m_pipelined.store(pipelined);
+
+        // Run a subsystem stage. When pipelined, only the subsystems with
+        // a matching affinity are included
+        auto runStage = [&eng, pipelined](const Subsystem::Stage stage, const Subsystem::Affinity affinity, const float deltaTime)
+        {
+        #ifdef JOP_PROFILING
+            static const char* const stageNames[] =
+            {
+                "preUpdate",
+                "postUpdate",
+                "draw"
+            };
+        #endif
+
+            for (auto& i : eng.m_subsystems)
+            {
+                if (!i->isActive() || (pipelined && i->getAffinity(stage) != affinity))
+                    continue;
+
+                JOP_PROFILE_TYPE_SCOPE(typeid(*i), stageNames[static_cast<int>(stage)]);
+
+                switch (stage)
+                {
+                    case Subsystem::Stage::PreUpdate:
+                        i->preUpdate(deltaTime);
+                        break;
+
+                    case Subsystem::Stage::PostUpdate:
+                        i->postUpdate(deltaTime);
+                        break;
+
+                    case Subsystem::Stage::Draw:
+                        i->draw();
+                }
+            }
+        };
+
+        auto updateScenes = [&eng](const float deltaTime)
+        {
+            JOP_PROFILE_SCOPE_CATEGORY("Scene update", "update");
+
+            if (hasCurrentScene())
+                eng.m_currentScene->updateBase(deltaTime);
+
+            if (hasSharedScene())
+                eng.m_sharedScene->updateBase(deltaTime);
+        };
+
+        float accumulator = 0.f;
+
+        // The subsystems are updated once per frame, only the scenes are updated per tick
+        auto simulate = [&eng, &runStage, &updateScenes, &accumulator, fixedStep, interpolate, timeStep, maxUpdates](float frameTime)
+        {
+            const float subsystemDelta = std::min(0.1f, frameTime);
+
+            runStage(Subsystem::Stage::PreUpdate, Subsystem::Affinity::Simulation, subsystemDelta);
+
+            if (fixedStep)
+            {
+                auto tick = [&eng, &updateScenes, interpolate, timeStep]()
+                {
+                    if (interpolate)
+                    {
+                        if (hasCurrentScene())
+                            eng.m_currentScene->storeTickState();
+
+                        if (hasSharedScene())
+                            eng.m_sharedScene->storeTickState();
+                    }
+
+                    updateScenes(timeStep);
+                };
+
+                eng.m_deltaTimeUnscaled.store(timeStep);
+
+                // The scenes aren't updated when not running, don't build up ticks
+                // to be caught up with later. Stepping a single frame runs one tick
+                if (eng.m_advanceFrame.load() && eng.m_state.load() != State::Running)
+                    tick();
+                else if (getState() == State::Running)
+                    accumulator += frameTime;
+
+                for (unsigned int updates = 0; accumulator >= timeStep; ++updates)
+                {
+                    // Drop the time we can't catch up with, instead of
+                    // spending even longer on the next frame
+                    if (updates == maxUpdates)
+                    {
+                        const unsigned int skipped = static_cast<unsigned int>(accumulator / timeStep);
+
+                        eng.m_skippedUpdates.fetch_add(skipped);
+                        accumulator -= skipped * timeStep;
+
+                        break;
+                    }
+
+                    tick();
+                    accumulator -= timeStep;
+                }
+
+                eng.m_interpolationAlpha.store(std::min(1.f, accumulator / timeStep));
+            }
+            else
+            {
+                eng.m_deltaTimeUnscaled.store(subsystemDelta);
+
+                updateScenes(subsystemDelta);
+            }
+
+            runStage(Subsystem::Stage::PostUpdate, Subsystem::Affinity::Simulation, subsystemDelta);
+        };
+
+        static const DynamicSetting<unsigned int> frameLimit("engine@DefaultWindow|uFrameLimit", 0);
+        static const DynamicSetting<unsigned int> renderOnlyLimit("engine@Time|uRenderOnlyFrameLimit", 0);
+        static const DynamicSetting<unsigned int> idleLimit("engine@Time|uIdleFrameLimit", 10);
+        static const DynamicSetting<unsigned int> unfocusedLimit("engine@Time|uUnfocusedFrameLimit", 0);
+        static const DynamicSetting<bool> waitEvents("engine@Time|bWaitEventsWhenIdle", false);
+
+        auto& pool = ThreadPool::getDefault();
+        ThreadPool::TaskHandle simulation;
+
         Clock frameClock;
+        std::vector<std::pair<Object*, Transform::Variables>> interpolated;
 
         while (!eng.m_exit)
         {
+            // Finish simulating this frame before touching the scenes
+            if (simulation)
+            {
+                JOP_PROFILE_SCOPE_CATEGORY("Simulation wait", "update");
+
+                pool.wait(simulation);
+                simulation.reset();
+            }
+
+            // Nothing from the previous frame is running anymore, release its temporaries
+            FrameArena::reset();
+
             if (eng.m_newScene.load() && eng.m_newSceneSignal.load())
             {
                 eng.m_currentScene.reset(eng.m_newScene.load());
@@ -266,43 +443,105 @@ namespace jop
                 eng.m_newScene.store(nullptr);
             }
 
-            float frameTime = static_cast<float>(frameClock.reset().asSeconds());
+            const float frameTime = static_cast<float>(frameClock.reset().asSeconds());
             eng.m_totalTime.store(eng.m_totalTime.load() + static_cast<double>(frameTime));
 
-            frameTime = std::min(0.1f, frameTime);
-            eng.m_deltaTimeUnscaled.store(frameTime);
+            Profiler::beginFrame();
 
             // Update
+            if (pipelined)
             {
-                for (auto& i : eng.m_subsystems)
+                const float deltaTime = std::min(0.1f, frameTime);
+
+                runStage(Subsystem::Stage::PreUpdate, Subsystem::Affinity::Render, deltaTime);
+                runStage(Subsystem::Stage::PostUpdate, Subsystem::Affinity::Render, deltaTime);
+            }
+            else
+                simulate(frameTime);
+
+            // Draw
+            {
+                if (interpolate)
                 {
-                    if (i->isActive())
-                        i->preUpdate(frameTime);
+                    const float alpha = eng.m_interpolationAlpha.load();
+
+                    if (hasCurrentScene())
+                        eng.m_currentScene->interpolateTransforms(alpha, interpolated);
+
+                    if (hasSharedScene())
+                        eng.m_sharedScene->interpolateTransforms(alpha, interpolated);
                 }
 
+                // Resolve the moved objects in one pass, instead of one by one while drawing
                 if (hasCurrentScene())
-                    eng.m_currentScene->updateBase(frameTime);
+                    eng.m_currentScene->updateTransforms();
 
                 if (hasSharedScene())
-                    eng.m_sharedScene->updateBase(frameTime);
+                    eng.m_sharedScene->updateTransforms();
 
-                for (auto& i : eng.m_subsystems)
-                {
-                    if (i->isActive())
-                        i->postUpdate(frameTime);
-                }
+                runStage(Subsystem::Stage::Draw, Subsystem::Affinity::Render, 0.f);
+
+                // The simulation continues from the actual transformations
+                Scene::restoreTransforms(interpolated);
             }
 
-            // Draw
-            for (auto& i : eng.m_subsystems)
+            if (pipelined)
             {
-                if (i->isActive())
-                    i->draw();
+                // Simulate the next frame while the rest of this one is finished
+                // Small enough to be stored inside the std::function without allocating
+                simulation = pool.submit([&simulate, frameTime]()
+                {
+                    ns_simulationThread = true;
+                    simulate(frameTime);
+                    ns_simulationThread = false;
+
+                    m_engineObject->m_advanceFrame.store(false);
+                });
+
+                runStage(Subsystem::Stage::Draw, Subsystem::Affinity::Concurrent, 0.f);
             }
+            else
+                eng.m_advanceFrame.store(false);
+
+            Profiler::endFrame();
 
-            eng.m_advanceFrame.store(false);
+            // Limit the frame rate. Frozen instances are throttled much harder, unfocused ones only when asked to
+            {
+                const State state = getState();
+                const bool unfocused = unfocusedLimit.value > 0 && ns_mainWindowVisible && eng.m_mainWindow && !eng.m_mainWindow->hasFocus();
+                const bool idle = state == State::Frozen || unfocused;
+
+                const unsigned int limit = state == State::Frozen ? idleLimit.value
+                                         : unfocused ? unfocusedLimit.value
+                                         : (state == State::RenderOnly && renderOnlyLimit.value > 0 ? renderOnlyLimit.value : frameLimit.value);
+
+                if (limit > 0)
+                {
+                    const double target = 1.0 / static_cast<double>(limit);
+
+                    if (idle && waitEvents.value && eng.m_mainWindow)
+                    {
+                        // Event callbacks may touch the scenes
+                        if (simulation)
+                        {
+                            pool.wait(simulation);
+                            simulation.reset();
+                        }
+
+                        const double remaining = target - frameClock.getElapsedTime().asSeconds();
+
+                        if (remaining > 0.0)
+                            Window::waitEvents(static_cast<float>(remaining));
+                    }
+                    else
+                        waitUntil(frameClock, target, !idle);
+                }
+            }
         }
 
+        if (simulation)
+            pool.wait(simulation);
+
         return EXIT_SUCCESS;
     }
 
@@ -529,6 +768,60 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    bool Engine::fixedTimestepEnabled()
+    {
+        return getFixedTimestep() > 0.f;
+    }
+
+    //////////////////////////////////////////////
+
+    float Engine::getFixedTimestep()
+    {
+        if (m_engineObject)
+            return m_engineObject->m_fixedTimestep.load();
+
+        return 0.f;
+    }
+
+    //////////////////////////////////////////////
+
+    float Engine::getInterpolationAlpha()
+    {
+        if (m_engineObject)
+            return m_engineObject->m_interpolationAlpha.load();
+
+        return 0.f;
+    }
+
+    //////////////////////////////////////////////
+
+    unsigned int Engine::getSkippedUpdates()
+    {
+        if (m_engineObject)
+            return m_engineObject->m_skippedUpdates.load();
+
+        return 0;
+    }
+
+    //////////////////////////////////////////////
+
+    bool Engine::pipelinedSimulationEnabled()
+    {
+        if (m_engineObject)
+            return m_engineObject->m_pipelined.load();
+
+        return false;
+    }
+
+    //////////////////////////////////////////////
+
+    bool Engine::isSimulationThread()
+    {
+        return ns_simulationThread;
+    }
+
+    //////////////////////////////////////////////
+
     Engine* Engine::m_engineObject = nullptr;
 
     //////////////////////////////////////////////
@@ -27,14 +27,145 @@
     #include <Jopnal/Core/Object.hpp>
 
     #include <Jopnal/Core/DebugHandler.hpp>
+    #include <Jopnal/Core/ObjectPool.hpp>
+    #include <Jopnal/Core/Profiler.hpp>
     #include <Jopnal/Core/Scene.hpp>
+    #include <Jopnal/Core/SettingManager.hpp>
+    #include <Jopnal/Core/TransformHierarchy.hpp>
     #include <Jopnal/Utility/CommandHandler.hpp>
+    #include <Jopnal/Utility/FrameArena.hpp>
+    #include <Jopnal/Utility/Interner.hpp>
+    #include <Jopnal/Utility/ThreadPool.hpp>
+    #include <functional>
+    #include <mutex>
+    #include <unordered_map>
+    #include <unordered_set>
 
 #endif
 
 //////////////////////////////////////////////
 
 
+namespace
+{
+    // Structural changes made during a parallel update, for a range of subtrees
+    struct DeferredChanges
+    {
+        typedef std::unordered_set<const jop::Object*, std::hash<const jop::Object*>, std::equal_to<const jop::Object*>, jop::FrameAllocator<const jop::Object*>> ObjectSet;
+
+        const jop::Object* root;                            // Root of the subtree being updated
+        ObjectSet owned;                                    // Staged objects, which may be modified directly
+        jop::FrameVector<std::function<void()>> commands;   // Changes to apply after the update
+    };
+
+    thread_local DeferredChanges* ns_deferred = nullptr;
+
+    // The objects that have each interned name
+    struct NameIndex
+    {
+        std::mutex mutex;
+        std::vector<std::vector<jop::Object*>> objects; // Indexed by name identifier
+    };
+
+    // Leaked on purpose, objects may be destroyed during static destruction
+    NameIndex& getTagIndex()
+    {
+        static NameIndex* index = new NameIndex;
+        return *index;
+    }
+
+    NameIndex& getIDIndex()
+    {
+        static NameIndex* index = new NameIndex;
+        return *index;
+    }
+
+    bool idIndexEnabled()
+    {
+        static const bool enabled = jop::SettingManager::get<bool>("engine@Scene|bObjectIDIndex", true);
+        return enabled;
+    }
+
+    // Incremented whenever cached search paths might have become invalid
+    std::atomic<jop::uint32> ns_pathGeneration(0);
+
+    bool isDescendantOf(const jop::Object& object, const jop::Object& ancestor)
+    {
+        for (auto parent = object.getParent().get(); parent != nullptr; parent = parent->getParent().get())
+        {
+            if (parent == &ancestor)
+                return true;
+        }
+
+        return false;
+    }
+
+    // Positions of the object and its parents among their siblings, starting below the ancestor.
+    // Comparing these lexicographically gives the depth-first order
+    std::vector<std::size_t> getTreePosition(const jop::Object& object, const jop::Object& ancestor)
+    {
+        std::vector<std::size_t> position;
+
+        for (const jop::Object* obj = &object; obj != &ancestor; obj = obj->getParent().get())
+        {
+            auto& siblings = obj->getParent()->getChildren();
+            position.push_back(std::find(siblings.begin(), siblings.end(), obj) - siblings.begin());
+        }
+
+        std::reverse(position.begin(), position.end());
+
+        return position;
+    }
+
+    // Translation * rotation * scale, composed directly
+    void composeLocalMatrix(glm::mat4& matrix, const jop::Transform::Variables& locals)
+    {
+        const glm::mat3 rot = glm::mat3_cast(locals.rotation);
+
+        matrix[0] = glm::vec4(rot[0] * locals.scale.x, 0.f);
+        matrix[1] = glm::vec4(rot[1] * locals.scale.y, 0.f);
+        matrix[2] = glm::vec4(rot[2] * locals.scale.z, 0.f);
+        matrix[3] = glm::vec4(locals.position, 1.f);
+    }
+
+    // Does a change to this object need to wait until the end of the parallel update?
+    bool needsDeferring(const jop::Object& object)
+    {
+        if (!ns_deferred)
+            return false;
+
+        for (const jop::Object* obj = &object; obj != nullptr; obj = obj->getParent().get())
+        {
+            if (obj == ns_deferred->root || ns_deferred->owned.find(obj) != ns_deferred->owned.end())
+                return false;
+        }
+
+        return true;
+    }
+
+    template<typename Func>
+    void defer(const jop::Object& object, Func func)
+    {
+        auto ref = object.getReference();
+
+        ns_deferred->commands.emplace_back([ref, func]() mutable
+        {
+            if (!ref.expired())
+                func(*ref);
+        });
+    }
+
+    // Destroying objects unregisters their components from the shared systems,
+    // so during a parallel update it must wait until the changes are applied
+    void destroyObject(jop::Object* obj)
+    {
+        if (ns_deferred)
+            ns_deferred->commands.emplace_back([obj]() { jop::detail::ObjectPool::destroy(obj); });
+        else
+            jop::detail::ObjectPool::destroy(obj);
+    }
+}
+
 namespace jop
 {
     JOP_REGISTER_COMMAND_HANDLER(Object)
@@ -82,16 +213,56 @@ namespace jop
 
 namespace jop
 {
+    struct Object::PathCache
+    {
+        static const std::size_t MaxPaths = 256;
+
+        std::mutex mutex;
+        std::unordered_map<std::string, std::pair<uint32, WeakReference<Object>>> paths;
+    };
+
+    // A loop over the children, which may adopt them elsewhere. The children
+    // after an adopted one shift down, so adoptChild() adjusts the index
+    struct Object::ChildCursor
+    {
+        explicit ChildCursor(Object& obj)
+            : object(obj),
+              index (0),
+              outer (obj.m_childCursor)
+        {
+            obj.m_childCursor = this;
+        }
+
+        ~ChildCursor()
+        {
+            object.m_childCursor = outer;
+        }
+
+        Object& object;
+        std::size_t index;  // Index of the child being visited
+        ChildCursor* outer; // Enclosing loop over the same children
+    };
+
+    //////////////////////////////////////////////
+
     Object::Object(const std::string& ID)
         : SafeReferenceable<Object> (this),
           m_transform               (),
           m_inverseTransform        (),
           m_locals                  (),
           m_globals                 (),
+          m_tickLocals              (),
+          m_hierarchy               (nullptr),
+          m_hierarchySlot           (0),
           m_children                (),
           m_components              (),
           m_tags                    (),
+          m_tagSlots                (),
           m_ID                      (),
+          m_IDKey                   (0),
+          m_IDSlot                  (0),
+          m_pathCache               (nullptr),
+          m_childCursor             (nullptr),
           m_parent                  (),
           m_flags                   (ActiveFlag | MatrixDirty | InverseMatrixDirty | GlobalPositionDirty | GlobalRotationDirty | GlobalScaleDirty)
     {
@@ -108,66 +279,171 @@ namespace jop
           m_inverseTransform        (),
           m_locals                  (newTransform),
           m_globals                 (),
+          m_tickLocals              (newTransform),
+          m_hierarchy               (nullptr),
+          m_hierarchySlot           (0),
           m_children                (),
           m_components              (),
-          m_tags                    (other.m_tags),
+          m_tags                    (),
+          m_tagSlots                (),
           m_ID                      (),
+          m_IDKey                   (0),
+          m_IDSlot                  (0),
+          m_pathCache               (nullptr),
+          m_childCursor             (nullptr),
           m_parent                  (other.m_parent),
-          m_flags                   (other.m_flags | MatrixDirty | InverseMatrixDirty | GlobalPositionDirty | GlobalRotationDirty | GlobalScaleDirty)
+          m_flags                   ((other.m_flags & ~TickStateFlag) | MatrixDirty | InverseMatrixDirty | GlobalPositionDirty | GlobalRotationDirty | GlobalScaleDirty)
     {
         setID(newID);
 
+        for (auto i : other.m_tags)
+            insertTag(i);
+
         m_components.reserve(other.m_components.size());
         for (auto& i : other.m_components)
         {
             auto ptr = std::unique_ptr<Component>(i->clone(*this));
 
             if (ptr)
+            {
+                // The clone isn't necessarily of the same type, if clone() wasn't overridden
+                ComponentRegistry::bind(*ptr, ComponentRegistry::getTypeID(typeid(*ptr)));
                 m_components.emplace_back(std::move(ptr));
+            }
         }
 
         m_children.reserve(other.m_children.size());
-        for (auto& i : other.m_children)
+        for (auto i : other.m_children)
         {
-            m_children.emplace_back(i, i.getID(), i.m_locals);
-            m_children.back().m_parent = *this;
+            m_children.push_back(detail::ObjectPool::create(*i, i->getID(), i->m_locals));
+            m_children.back()->m_parent = *this;
         }
     }
 
     Object::Object(Object&& other)
         : SafeReferenceable<Object> (std::move(other)),
-          m_transform               (),
-          m_inverseTransform        (),
+          m_transform               (other.m_transform),
+          m_inverseTransform        (other.m_inverseTransform),
           m_locals                  (other.m_locals),
-          m_globals                 (),
+          m_globals                 (other.m_globals),
+          m_tickLocals              (other.m_tickLocals),
+          m_hierarchy               (nullptr),
+          m_hierarchySlot           (0),
           m_children                (std::move(other.m_children)),
           m_components              (std::move(other.m_components)),
           m_tags                    (std::move(other.m_tags)),
+          m_tagSlots                (std::move(other.m_tagSlots)),
           m_ID                      (std::move(other.m_ID)),
+          m_IDKey                   (other.m_IDKey),
+          m_IDSlot                  (other.m_IDSlot),
+          m_pathCache               (other.m_pathCache.exchange(nullptr)),
+          m_childCursor             (nullptr),
           m_parent                  (other.m_parent),
-          m_flags                   (other.m_flags | MatrixDirty | InverseMatrixDirty | GlobalPositionDirty | GlobalRotationDirty | GlobalScaleDirty)
-    {}
+          m_flags                   (other.m_flags)
+    {
+        other.m_tags.clear();
+        other.m_tagSlots.clear();
+        other.m_IDKey = 0;
+
+        {
+            auto& index = getTagIndex();
+            std::lock_guard<std::mutex> lock(index.mutex);
+
+            for (std::size_t i = 0; i < m_tags.size(); ++i)
+                index.objects[m_tags[i]][m_tagSlots[i]] = this;
+        }
+
+        if (m_IDKey && idIndexEnabled())
+        {
+            auto& index = getIDIndex();
+            std::lock_guard<std::mutex> lock(index.mutex);
+
+            index.objects[m_IDKey][m_IDSlot] = this;
+        }
+
+        ++ns_pathGeneration;
+        detail::TransformHierarchy::replace(other, *this);
+    }
 
     Object& Object::operator=(Object&& other)
     {
         SafeReferenceable<Object>::operator =(std::move(other));
+
+        detail::TransformHierarchy::unlink(*this);
+
+        for (auto i : m_children)
+            destroyObject(i);
+
+        clearTags();
+
+        {
+            std::lock_guard<std::mutex> lock(getIDIndex().mutex);
+            unlinkID();
+        }
+
+        delete m_pathCache.exchange(other.m_pathCache.exchange(nullptr));
         
-        m_locals        = other.m_locals;
-        m_children      = std::move(other.m_children);
-        m_components    = std::move(other.m_components);
-        m_tags          = std::move(other.m_tags);
-        m_ID            = std::move(other.m_ID);
-        m_parent        = other.m_parent;
-        m_flags         = other.m_flags | MatrixDirty | InverseMatrixDirty | GlobalPositionDirty | GlobalRotationDirty | GlobalScaleDirty;
+        m_transform         = other.m_transform;
+        m_inverseTransform  = other.m_inverseTransform;
+        m_locals            = other.m_locals;
+        m_globals           = other.m_globals;
+        m_tickLocals        = other.m_tickLocals;
+        m_children          = std::move(other.m_children);
+        m_components        = std::move(other.m_components);
+        m_tags              = std::move(other.m_tags);
+        m_tagSlots          = std::move(other.m_tagSlots);
+        m_ID                = std::move(other.m_ID);
+        m_IDKey             = other.m_IDKey;
+        m_IDSlot            = other.m_IDSlot;
+        m_parent            = other.m_parent;
+        m_flags             = other.m_flags;
+
+        other.m_tags.clear();
+        other.m_tagSlots.clear();
+        other.m_IDKey = 0;
+
+        {
+            auto& index = getTagIndex();
+            std::lock_guard<std::mutex> lock(index.mutex);
+
+            for (std::size_t i = 0; i < m_tags.size(); ++i)
+                index.objects[m_tags[i]][m_tagSlots[i]] = this;
+        }
+
+        if (m_IDKey && idIndexEnabled())
+        {
+            auto& index = getIDIndex();
+            std::lock_guard<std::mutex> lock(index.mutex);
+
+            index.objects[m_IDKey][m_IDSlot] = this;
+        }
+
+        ++ns_pathGeneration;
+        detail::TransformHierarchy::replace(other, *this);
 
         return *this;
     }
 
     Object::~Object()
     {
-        // These need to be cleared before anything else
+        // These need to be cleared before anything else. The whole subtree
+        // leaves the transform layout at once
+        detail::TransformHierarchy::unlink(*this);
+
+        for (auto i : m_children)
+            destroyObject(i);
+
         m_children.clear();
         m_components.clear();
+
+        clearTags();
+
+        {
+            std::lock_guard<std::mutex> lock(getIDIndex().mutex);
+            unlinkID();
+        }
+
+        delete m_pathCache.load();
     }
 
     //////////////////////////////////////////////
@@ -188,11 +464,15 @@ namespace jop
 
     Object& Object::removeComponents(const uint32 ID)
     {
-        m_components.erase(std::remove_if(m_components.begin(), m_components.end(), [&ID](const std::unique_ptr<Component>& comp)
+        auto first = std::stable_partition(m_components.begin(), m_components.end(), [&ID](const std::unique_ptr<Component>& comp)
         {
-            return comp->getID() == ID;
+            return comp->getID() != ID;
+        });
 
-        }), m_components.end());
+        for (auto itr = first; itr != m_components.end(); ++itr)
+            destroyComponent(std::move(*itr));
+
+        m_components.erase(first, m_components.end());
 
         return *this;
     }
@@ -201,6 +481,9 @@ namespace jop
 
     Object& Object::clearComponents()
     {
+        for (auto& i : m_components)
+            destroyComponent(std::move(i));
+
         m_components.clear();
         return *this;
     }
@@ -216,10 +499,16 @@ namespace jop
 
     WeakReference<Object> Object::createChild(const std::string& ID)
     {
-        m_children.emplace_back(ID);
-        m_children.back().m_parent = *this;
+        if (needsDeferring(*this))
+        {
+            return stageChild(*detail::ObjectPool::create(ID));
+        }
 
-        return m_children.back().getReference();
+        m_children.push_back(detail::ObjectPool::create(ID));
+        m_children.back()->m_parent = *this;
+        detail::TransformHierarchy::link(*m_children.back());
+
+        return m_children.back()->getReference();
     }
 
     //////////////////////////////////////////////
@@ -231,28 +520,47 @@ namespace jop
         if (child.getParent().get() == this)
             return child.getReference();
 
-        if (m_children.size() == m_children.capacity())
-            m_children.reserve(m_children.size() + 1);
+        if (needsDeferring(*this) || needsDeferring(*child.getParent()))
+        {
+            auto childRef = child.getReference();
+
+            defer(*this, [childRef](Object& parent) mutable
+            {
+                if (!childRef.expired())
+                    parent.adoptChild(*childRef);
+            });
 
-        m_children.emplace_back(std::move(child));
-        m_children.back().m_parent = *this;
-        m_children.back().propagateFlags(TransformDirty);
+            return childRef;
+        }
 
-        child.removeSelf();
+        // The old parent may be iterating its children right now. The loops
+        // continue from the right child, the index wraps around if it was 0
+        detail::TransformHierarchy::unlink(child);
 
-        return m_children.back().getReference();
-    }
+        auto& oldParent = *child.m_parent;
+        auto itr = std::find(oldParent.m_children.begin(), oldParent.m_children.end(), &child);
+        const std::size_t index = itr - oldParent.m_children.begin();
+        oldParent.m_children.erase(itr);
 
-    //////////////////////////////////////////////
+        for (auto cursor = oldParent.m_childCursor; cursor; cursor = cursor->outer)
+        {
+            if (index <= cursor->index)
+                --cursor->index;
+        }
 
-    std::vector<Object>& Object::getChildren()
-    {
-        return m_children;
+        m_children.push_back(&child);
+        child.m_parent = *this;
+        detail::TransformHierarchy::link(child);
+        child.propagateFlags(MatrixDirty | GlobalRotationDirty);
+
+        ++ns_pathGeneration;
+
+        return child.getReference();
     }
 
     //////////////////////////////////////////////
 
-    const std::vector<Object>& Object::getChildren() const
+    const std::vector<Object*>& Object::getChildren() const
     {
         return m_children;
     }
@@ -265,11 +573,16 @@ namespace jop
 
         if (!ptr.expired())
         {
-            if (m_children.size() == m_children.capacity())
-                m_children.reserve(m_children.size() + 1);
+            if (needsDeferring(*this))
+            {
+                return stageChild(*detail::ObjectPool::create(*ptr, clonedID, ptr->m_locals));
+            }
+
+            m_children.push_back(detail::ObjectPool::create(*ptr, clonedID, ptr->m_locals));
+            m_children.back()->m_parent = *this;
+            detail::TransformHierarchy::link(*m_children.back());
 
-            m_children.emplace_back(*ptr, clonedID, ptr->m_locals);
-            return m_children.back().getReference();
+            return m_children.back()->getReference();
         }
 
         return WeakReference<Object>();
@@ -283,11 +596,16 @@ namespace jop
 
         if (!ptr.expired())
         {
-            if (m_children.size() == m_children.capacity())
-                m_children.reserve(m_children.size() + 1);
+            if (needsDeferring(*this))
+            {
+                return stageChild(*detail::ObjectPool::create(*ptr, clonedID, newTransform));
+            }
 
-            m_children.emplace_back(*ptr, clonedID, newTransform);
-            return m_children.back().getReference();
+            m_children.push_back(detail::ObjectPool::create(*ptr, clonedID, newTransform));
+            m_children.back()->m_parent = *this;
+            detail::TransformHierarchy::link(*m_children.back());
+
+            return m_children.back()->getReference();
         }
 
         return WeakReference<Object>();
@@ -297,10 +615,15 @@ namespace jop
 
     Object& Object::removeChildren(const std::string& ID)
     {
-        for (auto& i : m_children)
+        const uint32 key = Interner::getIDs().find(ID);
+
+        if (!key)
+            return *this;
+
+        for (auto i : m_children)
         {
-            if (i.getID() == ID)
-                i.removeSelf();
+            if (i->m_IDKey == key)
+                i->removeSelf();
         }
 
         return *this;
@@ -322,6 +645,16 @@ namespace jop
 
     Object& Object::reserveChildren(const uint32 size)
     {
+        if (needsDeferring(*this))
+        {
+            defer(*this, [size](Object& obj)
+            {
+                obj.reserveChildren(size);
+            });
+
+            return *this;
+        }
+
         m_children.reserve(size);
 
         return *this;
@@ -331,6 +664,21 @@ namespace jop
 
     Object& Object::clearChildren()
     {
+        if (needsDeferring(*this))
+        {
+            defer(*this, [](Object& obj)
+            {
+                obj.clearChildren();
+            });
+
+            return *this;
+        }
+
+        detail::TransformHierarchy::unlinkChildren(*this);
+
+        for (auto i : m_children)
+            destroyObject(i);
+
         m_children.clear();
         return *this;
     }
@@ -339,6 +687,16 @@ namespace jop
 
     void Object::removeSelf()
     {
+        if (needsDeferring(*this) || (!m_parent.expired() && needsDeferring(*m_parent)))
+        {
+            defer(*this, [](Object& obj)
+            {
+                obj.removeSelf();
+            });
+
+            return;
+        }
+
         setFlags(RemoveFlag);
 
         if (!m_parent.expired())
@@ -365,19 +723,16 @@ namespace jop
     {
         JOP_ASSERT(!getParent().expired(), "Cannot clone a scene!");
 
-        auto& vec = getParent()->m_children;
-        if (vec.size() == vec.capacity())
+        if (needsDeferring(*m_parent))
         {
-            auto ID = newID;
-            auto transform = newTransform;
-            auto ref = getReference();
-
-            vec.reserve(vec.size() + std::max(1u, vec.size() / 5u));
-            vec.emplace_back(*ref, ID, transform);
-            return vec.back().getReference();
+            return m_parent->stageChild(*detail::ObjectPool::create(*this, newID, newTransform));
         }
-        vec.emplace_back(*this, newID, newTransform);
-        return vec.back().getReference();
+
+        auto clone = detail::ObjectPool::create(*this, newID, newTransform);
+        m_parent->m_children.push_back(clone);
+        detail::TransformHierarchy::link(*clone);
+
+        return clone->getReference();
     }
 
     //////////////////////////////////////////////
@@ -400,8 +755,10 @@ namespace jop
     {
         unsigned int count = childCount();;
 
-        for (auto& i : m_children)
-            count += i.childCountRecursive();
+        for (auto i : m_children)
+        {
+            count += i->childCountRecursive();
+        }
 
         return count;
     }
@@ -434,13 +791,705 @@ namespace jop
         return getParent().expired() ? static_cast<const Scene&>(*this) : getParent()->getScene();
     }
 
-    /////////////////////////////////////////////
+    /////////////////////////////////////////////
+
+    Message::Result Object::sendMessage(const Message& message)
+    {
+        const bool indexed = (message.getIDKey() && idIndexEnabled()) || !message.getTagFilter().empty();
+
+        if (!indexed || !message.passFilter(Message::Object))
+            return sendTreeMessage(message);
+
+        if (sendIndexedMessage(message) == Message::Result::Escape)
+            return Message::Result::Escape;
+
+        return message.passFilter(Message::Component) ? sendComponentMessage(message) : Message::Result::Continue;
+    }
+
+    //////////////////////////////////////////////
+
+    namespace detail
+    {
+        bool findChildLoose(const std::string& childID, const std::string& findID)
+        {
+            return findID.empty() || childID.find(findID) != std::string::npos;
+        }
+    }
+
+    WeakReference<Object> Object::findChild(const std::string& ID, const bool recursive, const bool strict) const
+    {
+        if (strict)
+        {
+            auto& index = getIDIndex();
+            const uint32 key = Interner::getIDs().find(ID);
+
+            if (!key)
+                return WeakReference<Object>();
+
+            if (recursive && idIndexEnabled())
+            {
+                std::lock_guard<std::mutex> lock(index.mutex);
+
+                if (key >= index.objects.size())
+                    return WeakReference<Object>();
+
+                // The index isn't in tree order, so out of several matches the first one
+                // in depth-first order is picked, like a search through the tree would
+                const Object* found = nullptr;
+                std::vector<std::size_t> foundPosition;
+
+                for (auto i : index.objects[key])
+                {
+                    if (!isDescendantOf(*i, *this))
+                        continue;
+
+                    if (!found)
+                    {
+                        found = i;
+                        continue;
+                    }
+
+                    if (foundPosition.empty())
+                        foundPosition = getTreePosition(*found, *this);
+
+                    auto position = getTreePosition(*i, *this);
+
+                    if (position < foundPosition)
+                    {
+                        found = i;
+                        foundPosition.swap(position);
+                    }
+                }
+
+                return found ? found->getReference() : WeakReference<Object>();
+            }
+
+            auto ptr = findChildByKey(key, recursive);
+
+            return ptr ? ptr->getReference() : WeakReference<Object>();
+        }
+
+        for (auto i : m_children)
+        {
+            if (detail::findChildLoose(i->getID(), ID))
+                return i->getReference();
+
+            if (recursive)
+            {
+                auto ref = i->findChild(ID, true, false);
+
+                if (!ref.expired())
+                    return ref;
+            }
+        }
+
+        return WeakReference<Object>();
+    }
+
+    /////////////////////////////////////////////
+
+    std::vector<WeakReference<Object>> Object::findChildren(const std::string& ID, const bool recursive, const bool strict) const
+    {
+        std::vector<WeakReference<Object>> vec;
+
+        if (strict)
+        {
+            auto& index = getIDIndex();
+            const uint32 key = Interner::getIDs().find(ID);
+
+            if (!key)
+                return vec;
+
+            if (recursive && idIndexEnabled())
+            {
+                std::lock_guard<std::mutex> lock(index.mutex);
+
+                if (key < index.objects.size())
+                {
+                    for (auto i : index.objects[key])
+                    {
+                        if (isDescendantOf(*i, *this))
+                            vec.push_back(i->getReference());
+                    }
+                }
+            }
+            else
+                findChildrenByKey(key, recursive, vec);
+
+            return vec;
+        }
+
+        for (auto i : m_children)
+        {
+            if (detail::findChildLoose(i->getID(), ID))
+                vec.push_back(i->getReference());
+
+            if (recursive)
+            {
+                auto ref = i->findChildren(ID, true, false);
+                vec.insert(vec.end(), ref.begin(), ref.end());
+            }
+        }
+
+        return vec;
+    }
+
+    /////////////////////////////////////////////
+
+    std::vector<WeakReference<Object>> Object::findChildrenWithTag(const std::string& tag, const bool recursive) const
+    {
+        std::vector<WeakReference<Object>> vec;
+
+        auto& index = getTagIndex();
+        const uint32 tagID = Interner::getTags().find(tag);
+
+        if (!tagID)
+            return vec;
+
+        if (!recursive)
+        {
+            for (auto i : m_children)
+            {
+                if (std::binary_search(i->m_tags.begin(), i->m_tags.end(), tagID))
+                    vec.push_back(i->getReference());
+            }
+
+            return vec;
+        }
+
+        std::lock_guard<std::mutex> lock(index.mutex);
+
+        if (tagID >= index.objects.size())
+            return vec;
+
+        for (auto i : index.objects[tagID])
+        {
+            if (isDescendantOf(*i, *this))
+                vec.push_back(i->getReference());
+        }
+
+        return vec;
+    }
+
+    /////////////////////////////////////////////
+
+    WeakReference<Object> Object::findChildWithPath(const std::string& path) const
+    {
+        if (path.empty())
+            return WeakReference<Object>();
+
+        if (path[0] == '>')
+        {
+            JOP_DEBUG_ERROR("Invalid object path: " << path);
+            return WeakReference<Object>();
+        }
+
+        const uint32 generation = ns_pathGeneration.load();
+
+        if (auto cache = m_pathCache.load())
+        {
+            std::lock_guard<std::mutex> lock(cache->mutex);
+
+            auto itr = cache->paths.find(path);
+
+            if (itr != cache->paths.end() && itr->second.first == generation && !itr->second.second.expired())
+                return itr->second.second;
+        }
+
+        // Resolve one level at a time
+        auto& names = Interner::getIDs();
+        const Object* obj = this;
+        std::size_t begin = 0;
+
+        while (obj && begin != std::string::npos)
+        {
+            const std::size_t end = path.find_first_of('>', begin);
+            const uint32 key = names.find(path.substr(begin, end == std::string::npos ? end : end - begin));
+
+            obj = key ? obj->findChildByKey(key, false) : nullptr;
+            begin = end == std::string::npos ? end : end + 1;
+        }
+
+        if (!obj)
+            return WeakReference<Object>();
+
+        auto cache = m_pathCache.load();
+
+        if (!cache)
+        {
+            auto newCache = new PathCache;
+
+            if (m_pathCache.compare_exchange_strong(cache, newCache))
+                cache = newCache;
+            else
+                delete newCache;
+        }
+
+        std::lock_guard<std::mutex> lock(cache->mutex);
+
+        // Keep the cache from growing indefinitely with one-off paths
+        if (cache->paths.size() >= PathCache::MaxPaths)
+            cache->paths.clear();
+
+        auto ref = const_cast<Object*>(obj)->getReference();
+        cache->paths[path] = std::make_pair(generation, ref);
+
+        return ref;
+    }
+
+    /////////////////////////////////////////////
+
+    std::string Object::makeSearchPath() const
+    {
+        WeakReference<Object> obj(m_parent);
+        std::string path((obj.expired() ? "" : ">") + getID());
+
+        while (!obj.expired())
+        {
+            path.insert(0, (obj->m_parent.expired() ? "" : ">") + obj->getID());
+            obj = obj->m_parent;
+        }
+
+        return path;
+    }
+
+    /////////////////////////////////////////////
+
+    Object& Object::setActive(const bool active)
+    {
+        setFlagsIf(ActiveFlag, active);
+
+        return *this;
+    }
+
+    //////////////////////////////////////////////
+
+    bool Object::isActive() const
+    {
+        return ((m_flags & ActiveFlag) != 0) && !isRemoved() && (m_parent.expired() || m_parent->isActive());
+    }
+
+    /////////////////////////////////////////////
+
+    void Object::update(const float deltaTime)
+    {
+        if (isActive())
+        {
+            sweepRemoved();
+
+            for (auto& i : m_components)
+            {
+                if (ComponentRegistry::needsUpdate(*i))
+                    i->update(deltaTime);
+            }
+
+            // Have to use a good old fashion loop here
+            // since it's possible that objects are added
+            // or removed inside it.
+            for (ChildCursor i(*this); i.index < m_children.size(); ++i.index)
+                m_children[i.index]->update(deltaTime);
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void Object::updateParallel(const float deltaTime)
+    {
+        if (!isActive())
+            return;
+
+        sweepRemoved();
+
+        for (auto& i : m_components)
+        {
+            if (ComponentRegistry::needsUpdate(*i))
+                i->update(deltaTime);
+        }
+
+        // The subtrees read this object's lazily evaluated transformations,
+        // so they must not be dirty anymore once the tasks start
+        getTransform();
+        getInverseTransform();
+        getGlobalPosition();
+        getGlobalRotation();
+        getGlobalScale();
+
+        auto& pool = ThreadPool::getDefault();
+
+        // One change buffer per contiguous range of children. Applying the
+        // buffers in order keeps the result independent of the scheduling
+        const std::size_t count = m_children.size();
+        const std::size_t ranges = std::min(count, std::size_t(pool.getThreadCount() + 1) * 4);
+
+        if (!ranges)
+            return;
+
+        const std::size_t rangeSize = (count + ranges - 1) / ranges;
+        FrameVector<DeferredChanges> changes(ranges);
+
+        pool.parallelFor(ranges, 1, [this, &changes, count, rangeSize, deltaTime](const std::size_t begin, const std::size_t end)
+        {
+            JOP_PROFILE_SCOPE_CATEGORY("Object update range", "update");
+
+            // A waiting worker may pick up another range, so restore the previous buffer afterwards
+            auto previous = ns_deferred;
+
+            for (std::size_t r = begin; r < end; ++r)
+            {
+                ns_deferred = &changes[r];
+
+                for (std::size_t i = r * rangeSize; i < std::min(count, (r + 1) * rangeSize); ++i)
+                {
+                    changes[r].root = m_children[i];
+                    m_children[i]->update(deltaTime);
+                }
+            }
+
+            ns_deferred = previous;
+        });
+
+        JOP_PROFILE_SCOPE_CATEGORY("Deferred changes", "update");
+
+        for (auto& i : changes)
+        {
+            for (auto& j : i.commands)
+                j();
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void Object::runSerial(std::function<void()> func) const
+    {
+        if (!ns_deferred)
+            return func();
+
+        defer(*this, [func](Object&)
+        {
+            func();
+        });
+    }
+
+    //////////////////////////////////////////////
+
+    void Object::printDebugTree() const
+    {
+        printDebugTreeImpl(std::vector<uint32>(), false);
+    }
+
+    //////////////////////////////////////////////
+
+    void Object::printDebugTreeImpl(std::vector<uint32> spacing, const bool isLast) const
+    {
+    #if JOP_CONSOLE_VERBOSITY >= 2
+
+        auto& deb = DebugHandler::getInstance();
+
+        std::lock_guard<std::recursive_mutex> lock(deb.getMutex());
+
+        static const unsigned char codes[] =
+        {
+            196, // 0: Horizontal line
+            194, // 1: Right & down
+            195, // 2: Down & right
+            192, // 3: Right from up
+            179, // 4: Vertical line
+            191, // 5: Down from left
+            218, // 6: Down from right
+            217, // 7: Left from up
+        };
+
+        if (spacing.empty())
+        {
+            const auto n = childCountRecursive() + 1; // +1 for scene
+            deb << DebugHandler::Severity::Info << "Tree (total amount " << n << "): " << codes[5] << "\n" << codes[6];
+
+            for (uint32 i = 0; i < 45 + std::ceil(std::log10(n + 1)); ++i)
+                deb << codes[0];
+
+            deb << codes[7] << "\n" << codes[3];
+        }
+
+        deb << " " << (getID().empty() ? "<unnamed>" : getID()) << "\n";
+        spacing.emplace_back(getID().length() / 2 + 1 + spacing.empty());
+
+        auto& c = getChildren();
+        for (auto itr = c.begin(); itr != c.end(); ++itr)
+        {
+            if (!*itr)
+                continue;
+
+            for (uint32 sp = 0; sp < spacing[0]; ++sp)
+                deb << " ";
+
+            for (uint32 sp = 1; sp < spacing.size(); ++sp)
+            {
+                if (sp + 1 < spacing.size() || !isLast)
+                    deb << codes[4];
+                else
+                    deb << " ";
+
+                for (uint32 i = 0; i < spacing[sp]; ++i)
+                    deb << " ";
+            }
+
+            deb << codes[2 + (itr == c.end() - 1)];
+
+            (*itr)->printDebugTreeImpl(spacing, itr == c.end() - 1);
+        }
+
+        if (spacing.size() == 1)
+            deb << std::endl;
+
+    #else
+
+        spacing;
+        isLast;
+
+    #endif
+    }
+
+    /////////////////////////////////////////////
+
+    const std::string& Object::getID() const
+    {
+        return m_ID;
+    }
+
+    /////////////////////////////////////////////
+
+    Object& Object::setID(const std::string& ID)
+    {
+        const uint32 key = Interner::getIDs().intern(ID);
+
+        if (key != m_IDKey)
+        {
+            {
+                std::lock_guard<std::mutex> lock(getIDIndex().mutex);
+
+                unlinkID();
+                linkID(key);
+            }
+
+            ++ns_pathGeneration;
+        }
+
+        m_ID = ID;
+
+    #ifdef JOP_DEBUG_MODE   
+    
+        if (ID.find('>') != std::string::npos)
+            JOP_DEBUG_WARNING_ONCE("Forbidden character '>' found in object ID \"" << ID << "\". Object searches might not work correctly");
+
+    #endif
+
+        return *this;
+    }
+
+    //////////////////////////////////////////////
+
+    Object& Object::addTag(const std::string& tag)
+    {
+        insertTag(getTagID(tag));
+        return *this;
+    }
+
+    //////////////////////////////////////////////
+
+    Object& Object::removeTag(const std::string& tag)
+    {
+        const uint32 tagID = Interner::getTags().find(tag);
+        auto itr = std::lower_bound(m_tags.begin(), m_tags.end(), tagID);
+
+        if (tagID && itr != m_tags.end() && *itr == tagID)
+        {
+            const std::size_t pos = itr - m_tags.begin();
+
+            {
+                std::lock_guard<std::mutex> lock(getTagIndex().mutex);
+                unlinkTag(pos);
+            }
+
+            m_tags.erase(m_tags.begin() + pos);
+            m_tagSlots.erase(m_tagSlots.begin() + pos);
+        }
+
+        return *this;
+    }
+
+    //////////////////////////////////////////////
+
+    Object& Object::clearTags()
+    {
+        if (!m_tags.empty())
+        {
+            {
+                std::lock_guard<std::mutex> lock(getTagIndex().mutex);
+
+                for (std::size_t i = 0; i < m_tags.size(); ++i)
+                    unlinkTag(i);
+            }
+
+            m_tags.clear();
+            m_tagSlots.clear();
+        }
+
+        return *this;
+    }
+
+    //////////////////////////////////////////////
+
+    bool Object::hasTag(const std::string& tag) const
+    {
+        const uint32 tagID = Interner::getTags().find(tag);
+
+        return tagID && std::binary_search(m_tags.begin(), m_tags.end(), tagID);
+    }
+
+    //////////////////////////////////////////////
+
+    const std::vector<uint32>& Object::getTags() const
+    {
+        return m_tags;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 Object::getTagID(const std::string& tag)
+    {
+        return Interner::getTags().intern(tag);
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 Object::getIDKey(const std::string& ID)
+    {
+        return Interner::getIDs().intern(ID);
+    }
+
+    //////////////////////////////////////////////
+
+    const std::string& Object::getTagName(const uint32 ID)
+    {
+        return Interner::getTags().getString(ID);
+    }
+
+    //////////////////////////////////////////////
+
+    void Object::insertTag(const uint32 tag)
+    {
+        auto itr = std::lower_bound(m_tags.begin(), m_tags.end(), tag);
+
+        if (itr != m_tags.end() && *itr == tag)
+            return;
+
+        const std::size_t pos = itr - m_tags.begin();
+
+        auto& index = getTagIndex();
+        std::lock_guard<std::mutex> lock(index.mutex);
+
+        if (tag >= index.objects.size())
+            index.objects.resize(tag + 1);
+
+        auto& list = index.objects[tag];
+
+        m_tags.insert(m_tags.begin() + pos, tag);
+        m_tagSlots.insert(m_tagSlots.begin() + pos, static_cast<uint32>(list.size()));
+        list.push_back(this);
+    }
+
+    //////////////////////////////////////////////
+
+    void Object::linkID(const uint32 key)
+    {
+        m_IDKey = key;
+
+        if (!idIndexEnabled())
+            return;
+
+        auto& index = getIDIndex();
+
+        if (key >= index.objects.size())
+            index.objects.resize(key + 1);
+
+        m_IDSlot = static_cast<uint32>(index.objects[key].size());
+        index.objects[key].push_back(this);
+    }
+
+    //////////////////////////////////////////////
+
+    void Object::unlinkID()
+    {
+        if (m_IDKey && idIndexEnabled())
+        {
+            auto& list = getIDIndex().objects[m_IDKey];
+
+            // Move the last object into the freed slot
+            if (m_IDSlot + 1 < list.size())
+            {
+                list[m_IDSlot] = list.back();
+                list[m_IDSlot]->m_IDSlot = m_IDSlot;
+            }
+
+            list.pop_back();
+        }
+
+        m_IDKey = 0;
+    }
+
+    //////////////////////////////////////////////
+
+    Object* Object::findChildByKey(const uint32 key, const bool recursive) const
+    {
+        for (auto i : m_children)
+        {
+            if (i->m_IDKey == key)
+                return i;
+
+            if (recursive)
+            {
+                auto ptr = i->findChildByKey(key, true);
+
+                if (ptr)
+                    return ptr;
+            }
+        }
+
+        return nullptr;
+    }
+
+    //////////////////////////////////////////////
+
+    void Object::findChildrenByKey(const uint32 key, const bool recursive, std::vector<WeakReference<Object>>& found) const
+    {
+        for (auto i : m_children)
+        {
+            if (i->m_IDKey == key)
+                found.push_back(i->getReference());
+
+            if (recursive)
+                i->findChildrenByKey(key, true, found);
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    bool Object::passIDFilter(const Message& message) const
+    {
+        // Exact identifiers are compared by their keys
+        if (message.getIDKey())
+            return message.getIDKey() == m_IDKey;
+
+        return message.passFilter(getID());
+    }
+
+    //////////////////////////////////////////////
 
-    Message::Result Object::sendMessage(const Message& message)
+    Message::Result Object::sendTreeMessage(const Message& message)
     {
-        if (message.passFilter(Message::Object) && message.passFilter(getID()) && message.passFilter(m_tags))
+        if (message.passFilter(Message::Object) && passIDFilter(message) && message.passFilter(m_tags))
         {
-            if (JOP_EXECUTE_COMMAND(Object, message.getString(), this) == Message::Result::Escape)
+            if (JOP_EXECUTE_COMMAND(Object, message, this) == Message::Result::Escape)
                 return Message::Result::Escape;
         }
 
@@ -455,9 +1504,9 @@ namespace jop
 
         if (message.passFilter(Message::Object))
         {
-            for (auto& i : m_children)
+            for (ChildCursor i(*this); i.index < m_children.size(); ++i.index)
             {
-                if (i.sendMessage(message) == Message::Result::Escape)
+                if (m_children[i.index]->sendTreeMessage(message) == Message::Result::Escape)
                     return Message::Result::Escape;
             }
         }
@@ -467,313 +1516,267 @@ namespace jop
 
     //////////////////////////////////////////////
 
-    namespace detail
+    Message::Result Object::sendIndexedMessage(const Message& message)
     {
-        bool findChildStrict(const std::string& childID, const std::string& findID)
-        {
-            return childID == findID;
-        }
+        std::vector<WeakReference<Object>> targets;
 
-        bool findChildLoose(const std::string& childID, const std::string& findID)
+        auto accept = [this, &message, &targets](Object& obj)
         {
-            return findID.empty() || childID.find(findID) != std::string::npos;
-        }
-    }
-
-    WeakReference<Object> Object::findChild(const std::string& ID, const bool recursive, const bool strict) const
-    {
-        auto method = strict ? &detail::findChildStrict : &detail::findChildLoose;
+            if ((&obj == this || isDescendantOf(obj, *this)) && obj.passIDFilter(message) && message.passFilter(obj.m_tags))
+                targets.push_back(obj.getReference());
+        };
 
-        for (auto& i : m_children)
+        // The commands may change the indices, so the targets are collected first
+        if (message.getIDKey() && idIndexEnabled())
         {
-            if (method(i.getID(), ID))
-                return i.getReference();
+            auto& index = getIDIndex();
+            std::lock_guard<std::mutex> lock(index.mutex);
 
-            if (recursive)
+            if (message.getIDKey() < index.objects.size())
             {
-                auto ref = i.findChild(ID, true, strict);
-
-                if (!ref.expired())
-                    return ref;
+                for (auto i : index.objects[message.getIDKey()])
+                    accept(*i);
             }
         }
+        else
+        {
+            auto& index = getTagIndex();
+            std::lock_guard<std::mutex> lock(index.mutex);
 
-        return WeakReference<Object>();
-    }
-
-    /////////////////////////////////////////////
+            auto& tags = message.getTagFilter();
 
-    std::vector<WeakReference<Object>> Object::findChildren(const std::string& ID, const bool recursive, const bool strict) const
-    {
-        auto method = strict ? &detail::findChildStrict : &detail::findChildLoose;
+            if (message.requiresAllTags())
+            {
+                // Only the objects having the rarest tag need to be checked
+                const std::vector<Object*>* rarest = nullptr;
 
-        std::vector<WeakReference<Object>> vec;
+                for (auto i : tags)
+                {
+                    if (i >= index.objects.size())
+                        return Message::Result::Continue;
 
-        for (auto& i : m_children)
-        {
-            if (method(i.getID(), ID))
-                vec.push_back(i.getReference());
+                    if (!rarest || index.objects[i].size() < rarest->size())
+                        rarest = &index.objects[i];
+                }
 
-            if (recursive)
+                for (auto i : *rarest)
+                    accept(*i);
+            }
+            else
             {
-                auto ref = i.findChildren(ID, true, strict);
-                vec.insert(vec.end(), ref.begin(), ref.end());
+                for (std::size_t i = 0; i < tags.size() && tags[i] < index.objects.size(); ++i)
+                {
+                    for (auto obj : index.objects[tags[i]])
+                    {
+                        // Objects with an earlier tag in the filter were visited already
+                        bool visited = false;
+
+                        for (std::size_t j = 0; j < i && !visited; ++j)
+                            visited = std::binary_search(obj->m_tags.begin(), obj->m_tags.end(), tags[j]);
+
+                        if (!visited)
+                            accept(*obj);
+                    }
+                }
             }
         }
 
-        return vec;
+        for (auto& i : targets)
+        {
+            if (!i.expired() && JOP_EXECUTE_COMMAND(Object, message, i.get()) == Message::Result::Escape)
+                return Message::Result::Escape;
+        }
+
+        return Message::Result::Continue;
     }
 
-    /////////////////////////////////////////////
+    //////////////////////////////////////////////
 
-    std::vector<WeakReference<Object>> Object::findChildrenWithTag(const std::string& tag, const bool recursive) const
+    Message::Result Object::sendComponentMessage(const Message& message)
     {
-        std::vector<WeakReference<Object>> vec;
-
-        for (auto& i : m_children)
+        for (auto& i : m_components)
         {
-            if (i.hasTag(tag))
-                vec.push_back(i.getReference());
+            if (i->sendMessage(message) == Message::Result::Escape)
+                return Message::Result::Escape;
+        }
 
-            if (recursive)
-            {
-                auto ref = i.findChildrenWithTag(tag, true);
-                vec.insert(vec.end(), ref.begin(), ref.end());
-            }
+        for (ChildCursor i(*this); i.index < m_children.size(); ++i.index)
+        {
+            if (m_children[i.index]->sendComponentMessage(message) == Message::Result::Escape)
+                return Message::Result::Escape;
         }
 
-        return vec;
+        return Message::Result::Continue;
     }
 
-    /////////////////////////////////////////////
+    //////////////////////////////////////////////
 
-    WeakReference<Object> Object::findChildWithPath(const std::string& path) const
+    void Object::unlinkTag(const std::size_t pos)
     {
-        if (!path.empty())
-        {
-            auto pos = path.find_first_of('>');
+        auto& list = getTagIndex().objects[m_tags[pos]];
+        const uint32 slot = m_tagSlots[pos];
 
-            if (pos != 0)
-            {
-                if (pos != std::string::npos)
-                {
-                    auto ref = findChild(path.substr(0, pos), false, true);
+        // Move the last object into the freed slot
+        if (slot + 1 < list.size())
+        {
+            Object* moved = list.back();
+            list[slot] = moved;
 
-                    if (!ref.expired() && pos < path.length())
-                        return ref->findChild(path.substr(pos + 1));
-                }
-                else
-                    return findChild(path, false, true);
-            }
-            else
-                JOP_DEBUG_ERROR("Invalid object path: " << path);
+            auto itr = std::lower_bound(moved->m_tags.begin(), moved->m_tags.end(), m_tags[pos]);
+            moved->m_tagSlots[itr - moved->m_tags.begin()] = slot;
         }
 
-        return WeakReference<Object>();
+        list.pop_back();
     }
 
     /////////////////////////////////////////////
 
-    std::string Object::makeSearchPath() const
+    void Object::destroyComponent(std::unique_ptr<Component> component)
     {
-        WeakReference<Object> obj(m_parent);
-        std::string path((obj.expired() ? "" : ">") + getID());
-
-        while (!obj.expired())
+        // The destructor unregisters the component from the shared systems
+        if (ns_deferred)
         {
-            path.insert(0, (obj->m_parent.expired() ? "" : ">") + obj->getID());
-            obj = obj->m_parent;
+            auto comp = component.release();
+            ns_deferred->commands.emplace_back([comp]() { delete comp; });
         }
-
-        return path;
     }
 
     /////////////////////////////////////////////
 
-    Object& Object::setActive(const bool active)
+    void Object::sweepRemoved()
     {
-        setFlagsIf(ActiveFlag, active);
+        if (flagSet(ChildrenRemovedFlag))
+        {
+            m_children.erase(std::remove_if(m_children.begin(), m_children.end(), [](Object* obj)
+            {
+                if (obj->isRemoved())
+                {
+                    destroyObject(obj);
+                    return true;
+                }
 
-        return *this;
-    }
+                return false;
 
-    //////////////////////////////////////////////
+            }), m_children.end());
 
-    bool Object::isActive() const
-    {
-        return ((m_flags & ActiveFlag) != 0) && !isRemoved() && (m_parent.expired() || m_parent->isActive());
+            clearFlags(ChildrenRemovedFlag);
+        }
     }
 
     /////////////////////////////////////////////
 
-    void Object::update(const float deltaTime)
+    void Object::storeTickState()
     {
-        if (isActive())
-        {
-            sweepRemoved();
-
-            for (auto& i : m_components)
-                i->update(deltaTime);
+        m_tickLocals = m_locals;
+        setFlags(TickStateFlag);
 
-            // Have to use a good old fashion loop here
-            // since it's possible that objects are added
-            // or removed inside it.
-            for (std::size_t i = 0; i < m_children.size(); ++i)
-                m_children[i].update(deltaTime);
+        for (auto i : m_children)
+        {
+            i->storeTickState();
         }
     }
 
-    //////////////////////////////////////////////
-
-    void Object::printDebugTree() const
-    {
-        printDebugTreeImpl(std::vector<uint32>(), false);
-    }
-
-    //////////////////////////////////////////////
+    /////////////////////////////////////////////
 
-    void Object::printDebugTreeImpl(std::vector<uint32> spacing, const bool isLast) const
+    void Object::interpolateTransforms(const float alpha, std::vector<std::pair<Object*, Transform::Variables>>& saved)
     {
-    #if JOP_CONSOLE_VERBOSITY >= 2
-
-        auto& deb = DebugHandler::getInstance();
-
-        std::lock_guard<std::recursive_mutex> lock(deb.getMutex());
-
-        static const unsigned char codes[] =
-        {
-            196, // 0: Horizontal line
-            194, // 1: Right & down
-            195, // 2: Down & right
-            192, // 3: Right from up
-            179, // 4: Vertical line
-            191, // 5: Down from left
-            218, // 6: Down from right
-            217, // 7: Left from up
-        };
+        if (!isActive())
+            return;
 
-        if (spacing.empty())
+        // Objects created after the last fixed update have nothing to interpolate from
+        if (flagSet(TickStateFlag) && (m_tickLocals.position != m_locals.position ||
+                                       m_tickLocals.rotation != m_locals.rotation ||
+                                       m_tickLocals.scale    != m_locals.scale))
         {
-            const auto n = childCountRecursive() + 1; // +1 for scene
-            deb << DebugHandler::Severity::Info << "Tree (total amount " << n << "): " << codes[5] << "\n" << codes[6];
+            saved.emplace_back(this, m_locals);
 
-            for (uint32 i = 0; i < 45 + std::ceil(std::log10(n + 1)); ++i)
-                deb << codes[0];
+            m_locals.position = glm::mix(m_tickLocals.position, m_locals.position, alpha);
+            m_locals.rotation = glm::slerp(m_tickLocals.rotation, m_locals.rotation, alpha);
+            m_locals.scale    = glm::mix(m_tickLocals.scale, m_locals.scale, alpha);
 
-            deb << codes[7] << "\n" << codes[3];
+            propagateFlags(TransformDirty);
         }
 
-        deb << " " << (getID().empty() ? "<unnamed>" : getID()) << "\n";
-        spacing.emplace_back(getID().length() / 2 + 1 + spacing.empty());
-
-        auto& c = getChildren();
-        for (auto itr = c.begin(); itr != c.end(); ++itr)
+        for (auto i : m_children)
         {
-            for (uint32 sp = 0; sp < spacing[0]; ++sp)
-                deb << " ";
-
-            for (uint32 sp = 1; sp < spacing.size(); ++sp)
-            {
-                if (sp + 1 < spacing.size() || !isLast)
-                    deb << codes[4];
-                else
-                    deb << " ";
-
-                for (uint32 i = 0; i < spacing[sp]; ++i)
-                    deb << " ";
-            }
-
-            deb << codes[2 + (itr == c.end() - 1)];
-
-            itr->printDebugTreeImpl(spacing, itr == c.end() - 1);
+            i->interpolateTransforms(alpha, saved);
         }
-
-        if (spacing.size() == 1)
-            deb << std::endl;
-
-    #else
-
-        spacing;
-        isLast;
-
-    #endif
     }
 
     /////////////////////////////////////////////
 
-    const std::string& Object::getID() const
+    void Object::restoreTransforms(std::vector<std::pair<Object*, Transform::Variables>>& saved)
     {
-        return m_ID;
+        for (auto& i : saved)
+        {
+            i.first->m_locals = i.second;
+            i.first->propagateFlags(TransformDirty);
+        }
+
+        saved.clear();
     }
 
     /////////////////////////////////////////////
 
-    Object& Object::setID(const std::string& ID)
+    void Object::gatherUpdates(std::deque<std::vector<Component*>>& lists, std::vector<uint32>& order)
     {
-        m_ID = ID;
-
-    #ifdef JOP_DEBUG_MODE   
-    
-        if (ID.find('>') != std::string::npos)
-            JOP_DEBUG_WARNING_ONCE("Forbidden character '>' found in object ID \"" << ID << "\". Object searches might not work correctly");
+        if (!isActive())
+            return;
 
-    #endif
+        sweepRemoved();
 
-        return *this;
-    }
+        for (auto& i : m_components)
+        {
+            if (!ComponentRegistry::needsUpdate(*i))
+                continue;
 
-    //////////////////////////////////////////////
+            const uint32 type = i->getTypeID();
 
-    Object& Object::addTag(const std::string& tag)
-    {
-        m_tags.insert(tag);
-        return *this;
-    }
+            if (type >= lists.size())
+                lists.resize(type + 1);
 
-    //////////////////////////////////////////////
+            auto& list = lists[type];
 
-    Object& Object::removeTag(const std::string& tag)
-    {
-        m_tags.erase(tag);
-        return *this;
-    }
+            // Types are updated in the order they're first encountered
+            if (list.empty())
+                order.push_back(type);
 
-    //////////////////////////////////////////////
+            i->m_batch = &list;
+            i->m_batchIndex = static_cast<uint32>(list.size());
+            list.push_back(i.get());
+        }
 
-    Object& Object::clearTags()
-    {
-        m_tags.clear();
-        return *this;
+        for (auto i : m_children)
+        {
+            i->gatherUpdates(lists, order);
+        }
     }
 
-    //////////////////////////////////////////////
+    /////////////////////////////////////////////
 
-    bool Object::hasTag(const std::string& tag) const
+    WeakReference<Object> Object::stageChild(Object& staged)
     {
-        return m_tags.find(tag) != m_tags.end();
-    }
+        staged.m_parent = *this;
+        ns_deferred->owned.insert(&staged);
 
-    /////////////////////////////////////////////
+        auto parentRef = getReference();
+        auto child = &staged;
 
-    void Object::sweepRemoved()
-    {
-        if (flagSet(ChildrenRemovedFlag))
+        ns_deferred->commands.emplace_back([parentRef, child]() mutable
         {
-            m_children.erase(std::remove_if(m_children.begin(), m_children.end(), [](Object& obj)
+            // Nobody else owns the staged object, so it must be destroyed here if the parent is gone
+            if (parentRef.expired())
             {
-                if (obj.isRemoved())
-                {
-                    obj.clearChildren();
-                    obj.clearComponents();
-                    return true;
-                }
-
-                return false;
+                destroyObject(child);
+                return;
+            }
 
-            }), m_children.end());
+            parentRef->m_children.push_back(child);
+            detail::TransformHierarchy::link(*child);
+            child->propagateFlags(MatrixDirty | GlobalRotationDirty);
+        });
 
-            clearFlags(ChildrenRemovedFlag);
-        }
+        return staged.getReference();
     }
 
     /////////////////////////////////////////////
@@ -782,62 +1785,69 @@ namespace jop
     {
         if (flagSet(MatrixDirty))
         {
-            m_transform.getMatrix() = Transform::IdentityMatrix;
-            m_transform.translate(getLocalPosition());
-            m_transform.rotate(getLocalRotation());
-            m_transform.scale(getLocalScale());
+            glm::mat4& matrix = m_transform.getMatrix();
+            composeLocalMatrix(matrix, m_locals);
 
             if (!m_parent.expired() && !ignoresParent())
             {
-                Transform globalTrans = m_parent->getTransform();
-                glm::mat4& globalMat = globalTrans.getMatrix();
-
-                if (flagSet(ScaleX)) globalMat[0] = glm::normalize(globalMat[0]);
-                if (flagSet(ScaleY)) globalMat[1] = glm::normalize(globalMat[1]);
-                if (flagSet(ScaleZ)) globalMat[2] = glm::normalize(globalMat[2]);
-                
-                if (flagSet(Rotation))
-                {
-                    const glm::vec3 scl
-                    (
-                        glm::length(globalMat[0]),
-                        glm::length(globalMat[1]),
-                        glm::length(globalMat[2])
-                    );
-
-                    m_transform.getMatrix()[3] = glm::quat(globalMat) * m_transform.getMatrix()[3];
-
-                    globalMat[0] = glm::mat4::col_type(scl.x, 0.f, 0.f, 0.f);
-                    globalMat[1] = glm::mat4::col_type(0.f, scl.y, 0.f, 0.f);
-                    globalMat[2] = glm::mat4::col_type(0.f, 0.f, scl.z, 0.f);
-                }
-
-                if (flagSet(Translation))
+                // Without restrictions the parent matrix can be used as is
+                if (!flagSet(IgnoreParent))
+                    matrix = m_parent->getTransform().getMatrix() * matrix;
+                else
                 {
-                    glm::mat4& localMat = m_transform.getMatrix();
+                    Transform globalTrans = m_parent->getTransform();
+                    glm::mat4& globalMat = globalTrans.getMatrix();
 
-                    if (flagSet(TranslationX))
+                    if (flagSet(ScaleX)) globalMat[0] = glm::normalize(globalMat[0]);
+                    if (flagSet(ScaleY)) globalMat[1] = glm::normalize(globalMat[1]);
+                    if (flagSet(ScaleZ)) globalMat[2] = glm::normalize(globalMat[2]);
+                
+                    if (flagSet(Rotation))
                     {
-                        globalMat[3][0] = 0.f;
-                        localMat[3][0] = getLocalPosition().x;
+                        const glm::vec3 scl
+                        (
+                            glm::length(globalMat[0]),
+                            glm::length(globalMat[1]),
+                            glm::length(globalMat[2])
+                        );
+
+                        m_transform.getMatrix()[3] = glm::quat(globalMat) * m_transform.getMatrix()[3];
+
+                        globalMat[0] = glm::mat4::col_type(scl.x, 0.f, 0.f, 0.f);
+                        globalMat[1] = glm::mat4::col_type(0.f, scl.y, 0.f, 0.f);
+                        globalMat[2] = glm::mat4::col_type(0.f, 0.f, scl.z, 0.f);
                     }
 
-                    if (flagSet(TranslationY))
+                    if (flagSet(Translation))
                     {
-                        globalMat[3][1] = 0.f;
-                        localMat[3][1] = getLocalPosition().y;
+                        glm::mat4& localMat = m_transform.getMatrix();
+
+                        if (flagSet(TranslationX))
+                        {
+                            globalMat[3][0] = 0.f;
+                            localMat[3][0] = getLocalPosition().x;
+                        }
+
+                        if (flagSet(TranslationY))
+                        {
+                            globalMat[3][1] = 0.f;
+                            localMat[3][1] = getLocalPosition().y;
+                        }
+
+                        if (flagSet(TranslationZ))
+                        {
+                            globalMat[3][2] = 0.f;
+                            localMat[3][2] = getLocalPosition().z;
+                        }
                     }
 
-                    if (flagSet(TranslationZ))
-                    {
-                        globalMat[3][2] = 0.f;
-                        localMat[3][2] = getLocalPosition().z;
-                    }
+                    m_transform = globalTrans * m_transform;
                 }
-
-                m_transform = globalTrans * m_transform;
             }
 
+            // Values derived from the matrix are only marked here, so that
+            // propagateFlags() can stop at subtrees that are already dirty
+            setFlags(InverseMatrixDirty | GlobalPositionDirty | GlobalScaleDirty);
             clearFlags(MatrixDirty);
         }
 
@@ -846,9 +1856,11 @@ namespace jop
 
     const Transform& Object::getInverseTransform() const
     {
+        const auto& transform = getTransform();
+
         if (flagSet(InverseMatrixDirty))
         {
-            m_inverseTransform.getMatrix() = glm::inverse(getTransform().getMatrix());
+            m_inverseTransform.getMatrix() = glm::inverse(transform.getMatrix());
             clearFlags(InverseMatrixDirty);
         }
 
@@ -892,7 +1904,7 @@ namespace jop
     Object& Object::setRotation(const glm::quat& rotation)
     {
         m_locals.rotation = rotation;
-        propagateFlags(MatrixDirty | InverseMatrixDirty | GlobalRotationDirty | GlobalPositionDirty);
+        propagateFlags(MatrixDirty | GlobalRotationDirty);
 
         return *this;
     }
@@ -918,9 +1930,9 @@ namespace jop
         if (flagSet(GlobalRotationDirty))
         {
             if (m_parent.expired() || ignoresTransform(Rotation))
-                return getLocalRotation();
-
-            m_globals.rotation = m_parent->getGlobalRotation() * getLocalRotation();
+                m_globals.rotation = getLocalRotation();
+            else
+                m_globals.rotation = m_parent->getGlobalRotation() * getLocalRotation();
 
             clearFlags(GlobalRotationDirty);
         }
@@ -982,7 +1994,7 @@ namespace jop
     Object& Object::setScale(const glm::vec3& scale)
     {
         m_locals.scale = scale;
-        propagateFlags(MatrixDirty | InverseMatrixDirty | GlobalScaleDirty | GlobalPositionDirty);
+        propagateFlags(MatrixDirty);
 
         return *this;
     }
@@ -1005,10 +2017,10 @@ namespace jop
 
     const glm::vec3& Object::getGlobalScale() const
     {
+        const auto& mat = getTransform().getMatrix();
+
         if (flagSet(GlobalScaleDirty))
         {
-            const auto& mat = getTransform().getMatrix();
-
             m_globals.scale = glm::vec3
             (
                 glm::length(mat[0]),
@@ -1034,7 +2046,7 @@ namespace jop
     Object& Object::setPosition(const glm::vec3& position)
     {
         m_locals.position = position;
-        propagateFlags(MatrixDirty | InverseMatrixDirty | GlobalPositionDirty);
+        propagateFlags(MatrixDirty);
 
         return *this;
     }
@@ -1050,9 +2062,10 @@ namespace jop
 
     const glm::vec3& Object::getGlobalPosition() const
     {
+        const auto& mat = getTransform().getMatrix();
+
         if (flagSet(GlobalPositionDirty))
         {
-            const auto& mat = getTransform().getMatrix();
             m_globals.position = glm::vec3(mat[3][0], mat[3][1], mat[3][2]);
 
             clearFlags(GlobalPositionDirty);
@@ -1161,6 +2174,8 @@ namespace jop
     Object& Object::setIgnoreParent(const bool ignore)
     {
         ignore ? setFlags(IgnoreParent) : clearFlags(IgnoreParent);
+        propagateFlags(MatrixDirty | GlobalRotationDirty);
+
         return *this;
     }
 
@@ -1175,7 +2190,9 @@ namespace jop
 
     Object& Object::setIgnoreTransform(const uint32 flags)
     {
-        setFlags((flags & IgnoreParent) | TransformDirty);
+        setFlags(flags & IgnoreParent);
+        propagateFlags(MatrixDirty | GlobalRotationDirty);
+
         return *this;
     }
 
@@ -1210,9 +2227,37 @@ namespace jop
 
     void Object::propagateFlags(const uint32 flags)
     {
+        // Dirty flags are only ever cleared after the parent's, so if this
+        // object already has them set, so does every descendant
+        if ((m_flags & flags) == flags)
+            return;
+
         setFlags(flags);
 
-        for (auto& i : m_children)
-            i.propagateFlags(flags);
+        if (m_hierarchy && (flags & MatrixDirty))
+            m_hierarchy->markDirty(m_hierarchySlot);
+
+        for (auto i : m_children)
+        {
+            i->propagateFlags(flags);
+        }
+    }
+
+    void Object::resolveTransform(const glm::mat4* parentMatrix) const
+    {
+        // Restricted transformations need the parent's decomposed values
+        if (flagSet(IgnoreParent))
+        {
+            getTransform();
+            return;
+        }
+
+        composeLocalMatrix(m_transform.getMatrix(), m_locals);
+
+        if (parentMatrix)
+            m_transform.getMatrix() = *parentMatrix * m_transform.getMatrix();
+
+        setFlags(InverseMatrixDirty | GlobalPositionDirty | GlobalScaleDirty);
+        clearFlags(MatrixDirty);
     }
 }
\ No newline at end of file
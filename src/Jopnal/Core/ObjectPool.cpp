@@ -0,0 +1,125 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Core/ObjectPool.hpp>
+
+    #include <memory>
+    #include <mutex>
+    #include <type_traits>
+    #include <vector>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    // Amount of objects per block
+    const std::size_t ns_blockSize = 256;
+
+    union Slot
+    {
+        Slot* next;
+        std::aligned_storage<sizeof(jop::Object), alignof(jop::Object)>::type storage;
+    };
+
+    struct PoolState
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Slot[]>> blocks;
+        Slot* freeHead = nullptr;
+        std::size_t alive = 0;
+    };
+
+    PoolState& getState()
+    {
+        // Leaked on purpose, statically allocated objects may be destroyed after this
+        static PoolState* state = new PoolState;
+        return *state;
+    }
+}
+
+namespace jop { namespace detail
+{
+    void ObjectPool::destroy(Object* object)
+    {
+        if (object)
+        {
+            object->~Object();
+            deallocate(object);
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    std::size_t ObjectPool::getObjectCount()
+    {
+        auto& state = getState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        return state.alive;
+    }
+
+    //////////////////////////////////////////////
+
+    void* ObjectPool::allocate()
+    {
+        auto& state = getState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        if (!state.freeHead)
+        {
+            state.blocks.emplace_back(new Slot[ns_blockSize]);
+            auto block = state.blocks.back().get();
+
+            for (std::size_t i = 0; i < ns_blockSize - 1; ++i)
+                block[i].next = &block[i + 1];
+
+            block[ns_blockSize - 1].next = nullptr;
+            state.freeHead = block;
+        }
+
+        Slot* slot = state.freeHead;
+        state.freeHead = slot->next;
+        ++state.alive;
+
+        return slot;
+    }
+
+    //////////////////////////////////////////////
+
+    void ObjectPool::deallocate(void* ptr)
+    {
+        auto& state = getState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        Slot* slot = static_cast<Slot*>(ptr);
+        slot->next = state.freeHead;
+        state.freeHead = slot;
+        --state.alive;
+    }
+}}
\ No newline at end of file
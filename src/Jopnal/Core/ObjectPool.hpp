@@ -0,0 +1,88 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_OBJECTPOOL_HPP
+#define JOP_OBJECTPOOL_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <Jopnal/Core/Object.hpp>
+#include <utility>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    namespace detail
+    {
+        /// \brief Storage for child objects
+        ///
+        /// Objects are constructed into fixed size blocks, which are never
+        /// moved or freed, so an object keeps its address for its entire
+        /// lifetime. Destroyed slots are put on a free list and reused by
+        /// the next allocation, making both operations constant time.
+        ///
+        /// The pool is shared by all scenes, so that objects can be adopted
+        /// across scenes without being moved. It's thread safe.
+        ///
+        class ObjectPool final
+        {
+        private:
+
+            JOP_DISALLOW_COPY_MOVE(ObjectPool);
+
+        public:
+
+            /// \brief Construct a new object
+            ///
+            /// \param args Arguments to pass to the object constructor
+            ///
+            /// \return Pointer to the constructed object
+            ///
+            template<typename ... Args>
+            static Object* create(Args&&... args)
+            {
+                return new (allocate()) Object(std::forward<Args>(args)...);
+            }
+
+            /// \brief Destroy an object created with create()
+            ///
+            /// \param object The object to destroy. Can be nullptr
+            ///
+            static void destroy(Object* object);
+
+            /// \brief Get the amount of objects currently alive in the pool
+            ///
+            /// \return The amount of objects
+            ///
+            static std::size_t getObjectCount();
+
+        private:
+
+            static void* allocate();
+
+            static void deallocate(void* ptr);
+        };
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,801 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Core/Profiler.hpp>
+
+    #include <Jopnal/Core/DebugHandler.hpp>
+    #include <Jopnal/Core/FileLoader.hpp>
+    #include <Jopnal/Core/SettingManager.hpp>
+    #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+    #include <algorithm>
+    #include <atomic>
+    #include <chrono>
+    #include <cstdlib>
+    #include <cstring>
+    #include <deque>
+    #include <iomanip>
+    #include <mutex>
+    #include <sstream>
+    #include <thread>
+    #include <typeindex>
+    #include <unordered_map>
+
+    #if defined(__GNUG__)
+        #include <cxxabi.h>
+    #endif
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    struct PendingQuery
+    {
+        unsigned int query;
+        jop::uint64 frame;
+        std::size_t sample;
+    };
+
+    // Queries issued in the even and odd frames. A set is read back
+    // when it's about to be reused, two frames after it was issued
+    struct QuerySet
+    {
+        std::vector<unsigned int> queries;
+        std::vector<PendingQuery> pending;
+    };
+
+    // Sample recorded outside the main thread, tagged with the frame it was begun in
+    struct ThreadSample
+    {
+        jop::Profiler::Sample sample;
+        jop::uint64 frame;
+    };
+
+    // Samples recorded outside the main thread. Only the owning thread writes
+    // and only the main thread reads, so no locking is needed
+    struct ThreadBuffer
+    {
+        static const std::size_t Size = 4096;
+
+        std::vector<ThreadSample> samples;
+        std::atomic<jop::uint64> written;
+        std::atomic<jop::uint64> read;
+        const jop::uint32 index;
+        jop::uint32 depth;
+
+        explicit ThreadBuffer(const jop::uint32 threadIndex)
+            : samples   (Size),
+              written   (0),
+              read      (0),
+              index     (threadIndex),
+              depth     (0)
+        {}
+    };
+
+    struct ProfilerState
+    {
+        std::vector<jop::Profiler::Frame> frames;
+        std::deque<std::string> names;
+        std::unordered_map<std::string, jop::uint32> nameIds;
+        std::unordered_map<std::type_index, jop::uint32> typeIds;
+        std::mutex nameMutex;
+        std::vector<ThreadBuffer*> threadBuffers;
+        std::mutex threadMutex;
+        QuerySet querySets[2];
+        std::chrono::steady_clock::time_point epoch;
+        std::atomic<std::thread::id> thread;
+        std::atomic<jop::uint64> frameCounter;
+        std::size_t completed;
+        jop::uint32 depth;
+        std::atomic<bool> recording;
+        std::atomic<bool> enabled;
+        bool gpuActive;
+
+        ProfilerState()
+            : frames        (std::max(2u, jop::SettingManager::get<unsigned int>("engine@Debug|Profiler|uHistorySize", 120))),
+              names         (),
+              nameIds       (),
+              typeIds       (),
+              nameMutex     (),
+              threadBuffers (),
+              threadMutex   (),
+              querySets     (),
+              epoch         (std::chrono::steady_clock::now()),
+              thread        (std::thread::id()),
+              frameCounter  (0),
+              completed     (0),
+              depth         (0),
+              recording     (false),
+              enabled       (false),
+              gpuActive     (false)
+        {}
+    };
+
+    ProfilerState& getState()
+    {
+        static ProfilerState state;
+        return state;
+    }
+
+    bool onMainThread()
+    {
+        return std::this_thread::get_id() == getState().thread.load(std::memory_order_relaxed);
+    }
+
+    // The main thread records between beginFrame() and endFrame(). Other threads
+    // record whenever the profiler is enabled, their frames don't line up with
+    // the main thread's
+    bool shouldRecord()
+    {
+        auto& s = getState();
+        return onMainThread() ? s.recording.load() : s.enabled.load();
+    }
+
+    ThreadBuffer& getThreadBuffer()
+    {
+        // The buffers are never freed, the main thread may still be reading
+        // them after the owning thread has exited
+        thread_local ThreadBuffer* buffer = nullptr;
+
+        if (!buffer)
+        {
+            auto& s = getState();
+            std::lock_guard<std::mutex> lock(s.threadMutex);
+
+            buffer = new ThreadBuffer(static_cast<jop::uint32>(s.threadBuffers.size() + 1));
+            s.threadBuffers.push_back(buffer);
+        }
+
+        return *buffer;
+    }
+
+    jop::uint64 getTime()
+    {
+        using namespace std::chrono;
+        return static_cast<jop::uint64>(duration_cast<nanoseconds>(steady_clock::now() - getState().epoch).count());
+    }
+
+    jop::uint32 internName(const std::string& name)
+    {
+        auto& s = getState();
+        std::lock_guard<std::mutex> lock(s.nameMutex);
+
+        auto itr = s.nameIds.find(name);
+
+        if (itr != s.nameIds.end())
+            return itr->second;
+
+        const jop::uint32 id = static_cast<jop::uint32>(s.names.size());
+        s.names.push_back(name);
+        s.nameIds[name] = id;
+
+        return id;
+    }
+
+    std::string getTypeName(const std::type_info& type)
+    {
+        std::string name = type.name();
+
+    #if defined(__GNUG__)
+
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+
+        if (status == 0 && demangled)
+            name = demangled;
+
+        std::free(demangled);
+
+    #else
+
+        for (auto prefix : {"class ", "struct "})
+        {
+            if (name.compare(0, std::strlen(prefix), prefix) == 0)
+                name.erase(0, std::strlen(prefix));
+        }
+
+    #endif
+
+        return name;
+    }
+
+    bool gpuTimingSupported()
+    {
+    #ifndef JOP_OPENGL_ES
+
+        static const bool supported = jop::gl::getVersionMajor() > 3 || (jop::gl::getVersionMajor() == 3 && jop::gl::getVersionMinor() >= 3);
+        return supported;
+
+    #else
+
+        return false;
+
+    #endif
+    }
+
+    void resolveQueries(QuerySet& set)
+    {
+    #ifndef JOP_OPENGL_ES
+
+        auto& s = getState();
+
+        for (auto& i : set.pending)
+        {
+            // Never wait for the GPU. If the result isn't there yet, the sample is dropped
+            GLint available = GL_FALSE;
+            glCheck(glGetQueryObjectiv(i.query, GL_QUERY_RESULT_AVAILABLE, &available));
+
+            auto& frame = s.frames[i.frame % s.frames.size()];
+
+            if (available == GL_FALSE || frame.index != i.frame || i.sample >= frame.samples.size())
+                continue;
+
+            GLuint64 elapsed = 0;
+            glCheck(glGetQueryObjectui64v(i.query, GL_QUERY_RESULT, &elapsed));
+
+            auto& sample = frame.samples[i.sample];
+            sample.duration = static_cast<jop::uint64>(elapsed);
+            sample.resolved = true;
+        }
+
+    #endif
+
+        set.pending.clear();
+    }
+
+    void escapeJson(std::ostringstream& stream, const std::string& str)
+    {
+        for (auto c : str)
+        {
+            if (c == '"' || c == '\\')
+                stream << '\\' << c;
+            else if (static_cast<unsigned char>(c) >= 0x20)
+                stream << c;
+        }
+    }
+
+    void writeEvent(std::ostringstream& stream, bool& first, const std::string& name, const char* category, const int track, const jop::uint64 start, const jop::uint64 duration)
+    {
+        if (!first)
+            stream << ",\n";
+
+        first = false;
+
+        stream << "{\"name\":\"";
+        escapeJson(stream, name);
+        stream << "\",\"cat\":\"";
+        escapeJson(stream, category);
+        stream << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << track
+               << ",\"ts\":" << (static_cast<double>(start) / 1000.0)
+               << ",\"dur\":" << (static_cast<double>(duration) / 1000.0) << "}";
+    }
+
+    void escapeCsv(std::ostringstream& stream, const std::string& str)
+    {
+        stream << '"';
+
+        for (auto c : str)
+        {
+            if (c == '"')
+                stream << '"';
+
+            stream << c;
+        }
+
+        stream << '"';
+    }
+}
+
+namespace jop
+{
+    Profiler::Scope::Scope(const std::string& name, const char* category, const Type type)
+        : m_cpuSample   (-1),
+          m_gpuSample   (-1),
+          m_start       (0),
+          m_name        (0),
+          m_frame       (0),
+          m_category    (nullptr)
+    {
+        if (!shouldRecord())
+            return;
+
+        if (onMainThread())
+            begin(internName(name), category, type);
+        else
+            beginThread(internName(name), category);
+    }
+
+    //////////////////////////////////////////////
+
+    Profiler::Scope::Scope(const std::type_info& type, const char* category)
+        : m_cpuSample   (-1),
+          m_gpuSample   (-1),
+          m_start       (0),
+          m_name        (0),
+          m_frame       (0),
+          m_category    (nullptr)
+    {
+        auto& s = getState();
+
+        if (!shouldRecord())
+            return;
+
+        uint32 name = 0;
+        {
+            std::unique_lock<std::mutex> lock(s.nameMutex);
+            auto itr = s.typeIds.find(std::type_index(type));
+
+            if (itr != s.typeIds.end())
+                name = itr->second;
+            else
+            {
+                lock.unlock();
+                name = internName(getTypeName(type));
+
+                lock.lock();
+                s.typeIds.emplace(std::type_index(type), name);
+            }
+        }
+
+        if (onMainThread())
+            begin(name, category, Type::CPU);
+        else
+            beginThread(name, category);
+    }
+
+    //////////////////////////////////////////////
+
+    Profiler::Scope::Scope(const uint32 name, const char* category)
+        : m_cpuSample   (-1),
+          m_gpuSample   (-1),
+          m_start       (0),
+          m_name        (0),
+          m_frame       (0),
+          m_category    (nullptr)
+    {
+        if (!shouldRecord())
+            return;
+
+        if (onMainThread())
+            begin(name, category, Type::CPU);
+        else
+            beginThread(name, category);
+    }
+
+    //////////////////////////////////////////////
+
+    Profiler::Scope::~Scope()
+    {
+        auto& s = getState();
+
+        if (m_cpuSample == -2)
+        {
+            endThread();
+            return;
+        }
+
+        if (m_cpuSample < 0 || !s.recording)
+            return;
+
+        auto& frame = s.frames[s.frameCounter % s.frames.size()];
+        auto& cpu = frame.samples[static_cast<std::size_t>(m_cpuSample)];
+
+        cpu.duration = getTime() - cpu.start;
+        cpu.resolved = true;
+
+        --s.depth;
+
+    #ifndef JOP_OPENGL_ES
+
+        if (m_gpuSample >= 0)
+        {
+            glCheck(glEndQuery(GL_TIME_ELAPSED));
+            s.gpuActive = false;
+        }
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
+    void Profiler::Scope::begin(const uint32 name, const char* category, const Type type)
+    {
+        auto& s = getState();
+        auto& frame = s.frames[s.frameCounter % s.frames.size()];
+
+        const Sample sample = {name, category, Type::CPU, s.depth++, getTime(), 0, false, 0};
+
+        m_cpuSample = static_cast<int64>(frame.samples.size());
+        frame.samples.push_back(sample);
+
+    #ifndef JOP_OPENGL_ES
+
+        if (type == Type::GPU && !s.gpuActive && gpuTimingSupported())
+        {
+            auto& set = s.querySets[s.frameCounter % 2];
+
+            if (set.pending.size() == set.queries.size())
+            {
+                GLuint query = 0;
+                glCheck(glGenQueries(1, &query));
+                set.queries.push_back(query);
+            }
+
+            const GLuint query = set.queries[set.pending.size()];
+
+            m_gpuSample = static_cast<int64>(frame.samples.size());
+            frame.samples.push_back(sample);
+            frame.samples.back().type = Type::GPU;
+
+            const PendingQuery pending = {query, s.frameCounter, static_cast<std::size_t>(m_gpuSample)};
+            set.pending.push_back(pending);
+
+            glCheck(glBeginQuery(GL_TIME_ELAPSED, query));
+            s.gpuActive = true;
+        }
+
+    #else
+
+        static_cast<void>(type);
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
+    void Profiler::Scope::beginThread(const uint32 name, const char* category)
+    {
+        m_cpuSample = -2;
+        m_name = name;
+        m_category = category;
+        m_frame = getState().frameCounter.load();
+
+        ++getThreadBuffer().depth;
+        m_start = getTime();
+    }
+
+    //////////////////////////////////////////////
+
+    void Profiler::Scope::endThread()
+    {
+        const uint64 end = getTime();
+
+        auto& buffer = getThreadBuffer();
+        --buffer.depth;
+
+        const uint64 written = buffer.written.load(std::memory_order_relaxed);
+
+        // Drop the sample if the main thread hasn't caught up
+        if (written - buffer.read.load(std::memory_order_acquire) >= ThreadBuffer::Size)
+            return;
+
+        const ThreadSample sample = {{m_name, m_category, Type::CPU, buffer.depth, m_start, end - m_start, true, buffer.index}, m_frame};
+
+        buffer.samples[written % ThreadBuffer::Size] = sample;
+        buffer.written.store(written + 1, std::memory_order_release);
+    }
+
+    //////////////////////////////////////////////
+
+    void Profiler::beginFrame()
+    {
+        auto& s = getState();
+
+        if (!isEnabled())
+        {
+            s.recording = false;
+            s.enabled = false;
+            return;
+        }
+
+        s.thread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+        // Read the timings of the frame two frames back, these queries are about to be reused
+        resolveQueries(s.querySets[s.frameCounter % 2]);
+
+        auto& frame = s.frames[s.frameCounter % s.frames.size()];
+        frame.index = s.frameCounter;
+        frame.start = getTime();
+        frame.duration = 0;
+        frame.samples.clear();
+
+        s.depth = 0;
+        s.gpuActive = false;
+        s.enabled = true;
+        s.recording = true;
+    }
+
+    //////////////////////////////////////////////
+
+    void Profiler::endFrame()
+    {
+        auto& s = getState();
+
+        if (!s.recording)
+            return;
+
+        auto& frame = s.frames[s.frameCounter % s.frames.size()];
+        frame.duration = getTime() - frame.start;
+
+        // Collect the samples of the other threads
+        {
+            std::lock_guard<std::mutex> lock(s.threadMutex);
+
+            for (auto buffer : s.threadBuffers)
+            {
+                const uint64 written = buffer->written.load(std::memory_order_acquire);
+
+                for (uint64 i = buffer->read.load(std::memory_order_relaxed); i < written; ++i)
+                {
+                    auto& sample = buffer->samples[i % ThreadBuffer::Size];
+
+                    // A scope may span the end of a frame, so put the sample into the frame
+                    // it was begun in. It's dropped if that frame isn't in the history anymore
+                    auto& target = s.frames[sample.frame % s.frames.size()];
+
+                    if (target.index == sample.frame && sample.frame <= frame.index)
+                        target.samples.push_back(sample.sample);
+                }
+
+                buffer->read.store(written, std::memory_order_release);
+            }
+        }
+
+        ++s.frameCounter;
+        s.completed = std::min(s.completed + 1, s.frames.size());
+        s.recording = false;
+    }
+
+    //////////////////////////////////////////////
+
+    bool Profiler::isEnabled()
+    {
+        static const DynamicSetting<bool> enabled("engine@Debug|bProfiler", false);
+        return enabled.value;
+    }
+
+    //////////////////////////////////////////////
+
+    void Profiler::setEnabled(const bool enabled)
+    {
+        SettingManager::set("engine@Debug|bProfiler", enabled);
+    }
+
+    //////////////////////////////////////////////
+
+    std::size_t Profiler::getFrameCount()
+    {
+        return getState().completed;
+    }
+
+    //////////////////////////////////////////////
+
+    const Profiler::Frame& Profiler::getFrame(const std::size_t age)
+    {
+        auto& s = getState();
+
+        JOP_ASSERT(age < s.completed, "Profiler frame index out of range!");
+
+        return s.frames[(s.frameCounter - 1 - age) % s.frames.size()];
+    }
+
+    //////////////////////////////////////////////
+
+    const std::string& Profiler::getName(const uint32 name)
+    {
+        auto& s = getState();
+        std::lock_guard<std::mutex> lock(s.nameMutex);
+
+        JOP_ASSERT(name < s.names.size(), "Profiler name id out of range!");
+
+        return s.names[name];
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 Profiler::getNameID(const std::string& name)
+    {
+        return internName(name);
+    }
+
+    //////////////////////////////////////////////
+
+    double Profiler::getAverageTime(const std::string& name, const Type type)
+    {
+        auto& s = getState();
+        uint32 id = 0;
+        {
+            std::lock_guard<std::mutex> lock(s.nameMutex);
+            auto itr = s.nameIds.find(name);
+
+            if (itr == s.nameIds.end())
+                return 0.0;
+
+            id = itr->second;
+        }
+
+        uint64 total = 0;
+        std::size_t frames = 0;
+
+        for (std::size_t i = 0; i < s.completed; ++i)
+        {
+            bool found = false;
+
+            for (auto& j : getFrame(i).samples)
+            {
+                if (j.name == id && j.type == type && j.resolved)
+                {
+                    total += j.duration;
+                    found = true;
+                }
+            }
+
+            frames += found;
+        }
+
+        return frames > 0 ? static_cast<double>(total) / static_cast<double>(frames) / 1000000.0 : 0.0;
+    }
+
+    //////////////////////////////////////////////
+
+    std::vector<Profiler::Statistics> Profiler::getStatistics()
+    {
+        std::vector<Statistics> stats;
+        std::unordered_map<uint64, std::size_t> indices;
+        std::unordered_map<uint64, uint64> frameTimes;
+
+        for (std::size_t i = 0; i < getFrameCount(); ++i)
+        {
+            frameTimes.clear();
+
+            for (auto& j : getFrame(i).samples)
+            {
+                if (!j.resolved)
+                    continue;
+
+                const uint64 key = (static_cast<uint64>(j.name) << 1) | (j.type == Type::GPU);
+                frameTimes[key] += j.duration;
+
+                auto itr = indices.find(key);
+
+                if (itr == indices.end())
+                {
+                    const Statistics stat = {j.name, j.type, 0, 0, 0.0, 0.0, 0.0};
+
+                    itr = indices.emplace(key, stats.size()).first;
+                    stats.push_back(stat);
+                }
+
+                ++stats[itr->second].calls;
+            }
+
+            for (auto& j : frameTimes)
+            {
+                auto& stat = stats[indices[j.first]];
+                const double time = static_cast<double>(j.second) / 1000000.0;
+
+                stat.minTime = stat.frames > 0 ? std::min(stat.minTime, time) : time;
+                stat.maxTime = std::max(stat.maxTime, time);
+                stat.averageTime += time;
+                ++stat.frames;
+            }
+        }
+
+        for (auto& i : stats)
+            i.averageTime /= static_cast<double>(i.frames);
+
+        return stats;
+    }
+
+    //////////////////////////////////////////////
+
+    std::string Profiler::getChromeTrace()
+    {
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(3);
+        stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+               << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"CPU\"}},\n"
+               << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"GPU\"}}";
+
+        bool first = false;
+        uint32 threads = 0;
+
+        // Oldest first
+        for (std::size_t i = getFrameCount(); i-- > 0;)
+        {
+            auto& frame = getFrame(i);
+
+            writeEvent(stream, first, "Frame " + std::to_string(frame.index), "frame", 0, frame.start, frame.duration);
+
+            for (auto& j : frame.samples)
+            {
+                if (!j.resolved)
+                    continue;
+
+                // Other threads come after the GPU track
+                const int track = j.type == Type::GPU ? 1 : (j.thread > 0 ? static_cast<int>(j.thread) + 1 : 0);
+                writeEvent(stream, first, getName(j.name), j.category, track, j.start, j.duration);
+
+                threads = std::max(threads, j.thread);
+            }
+        }
+
+        for (uint32 i = 1; i <= threads; ++i)
+            stream << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << (i + 1) << ",\"args\":{\"name\":\"Thread " << i << "\"}}";
+
+        stream << "\n]}";
+
+        return stream.str();
+    }
+
+    //////////////////////////////////////////////
+
+    bool Profiler::saveChromeTrace(const std::string& path)
+    {
+        return FileLoader::writeTextfile(FileLoader::Directory::User, path, getChromeTrace());
+    }
+
+    //////////////////////////////////////////////
+
+    std::string Profiler::getCSV()
+    {
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(3);
+        stream << "frame,thread,type,category,name,depth,start_us,duration_us\n";
+
+        // Oldest first
+        for (std::size_t i = getFrameCount(); i-- > 0;)
+        {
+            auto& frame = getFrame(i);
+
+            for (auto& j : frame.samples)
+            {
+                if (!j.resolved)
+                    continue;
+
+                stream << frame.index << ',' << j.thread << ',' << (j.type == Type::GPU ? "GPU" : "CPU") << ',';
+                escapeCsv(stream, j.category);
+                stream << ',';
+                escapeCsv(stream, getName(j.name));
+                stream << ',' << j.depth
+                       << ',' << (static_cast<double>(j.start) / 1000.0)
+                       << ',' << (static_cast<double>(j.duration) / 1000.0) << '\n';
+            }
+        }
+
+        return stream.str();
+    }
+
+    //////////////////////////////////////////////
+
+    bool Profiler::saveCSV(const std::string& path)
+    {
+        return FileLoader::writeTextfile(FileLoader::Directory::User, path, getCSV());
+    }
+}
\ No newline at end of file
@@ -44,6 +44,31 @@ namespace std
 
 namespace jop
 {
+    namespace detail
+    {
+        ResourceLoadScope::ResourceLoadScope(const std::string& name)
+            : m_scope()
+        {
+        #ifdef JOP_PROFILING
+
+            if (Profiler::isEnabled())
+                m_scope = std::make_unique<Profiler::Scope>("Load " + name, "resource", Profiler::Type::CPU);
+
+        #else
+
+            static_cast<void>(name);
+
+        #endif
+        }
+
+        //////////////////////////////////////////////
+
+        ResourceLoadScope::~ResourceLoadScope()
+        {}
+    }
+
+    //////////////////////////////////////////////
+
     ResourceManager::ResourceManager()
         : Subsystem             (0),
           m_resources           (),
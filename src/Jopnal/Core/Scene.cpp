@@ -27,10 +27,12 @@
     #include <Jopnal/Core/Scene.hpp>
 
     #include <Jopnal/Core/Engine.hpp>
+    #include <Jopnal/Core/Profiler.hpp>
+    #include <Jopnal/Core/SettingManager.hpp>
+    #include <Jopnal/Core/TransformHierarchy.hpp>
     #include <Jopnal/Graphics/Renderer.hpp>
     #include <Jopnal/Physics/World.hpp>
     #include <Jopnal/Utility/CommandHandler.hpp>
-    #include <Jopnal/Graphics/Culling/CullerComponent.hpp>
     #include <Jopnal/Physics/Collider.hpp>
 
 #endif
@@ -49,43 +51,21 @@ namespace jop
 
 namespace jop
 {
-    namespace detail
-    {
-        class CullingBroadphaseCallback : public World::BroadphaseCallback
-        {
-        public:
-
-            CullingBroadphaseCallback(World& worldRef)
-                : World::BroadphaseCallback(worldRef)
-            {}
-
-            bool collide(const Collider& c0, const Collider& c1) const override
-            {
-                auto& st = static_cast<const CullerComponent&>(c0);
-                auto& nd = static_cast<const CullerComponent&>(c1);
-
-                return st.shouldCollide(nd) || nd.shouldCollide(st);
-            }
-        };
-    }
-
-    //////////////////////////////////////////////
-
     Scene::Scene(const std::string& ID)
         : Object                (ID),
           m_renderer            (std::make_unique<Renderer>(Engine::getMainRenderTarget(), *this)),
+          m_transforms          (std::make_unique<detail::TransformHierarchy>(getAsObject())),
           m_worlds              (nullptr, nullptr),
           m_deltaScale          (1.f),
-          m_cullingWorld        (*this, *m_renderer),
-          m_broadphaseCallback  (std::make_unique<detail::CullingBroadphaseCallback>(m_cullingWorld))
-    {
-        m_cullingWorld.setBroadphaseBallback(*m_broadphaseCallback);
-        m_cullingWorld.setDebugMode(true);
-    }
+          m_parallelUpdate      (SettingManager::get<bool>("engine@Scene|bParallelUpdate", false)),
+          m_batchedUpdate       (SettingManager::get<bool>("engine@Scene|bBatchedUpdate", false)),
+          m_updateLists         (),
+          m_updateOrder         ()
+    {}
 
     Scene::~Scene()
     {
-        // Child objects need to be deinitialized before the renderer & culling world
+        // Child objects need to be deinitialized before the renderer
         Object::clearChildren();
         Object::clearComponents();
     }
@@ -113,9 +93,37 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    void Scene::setParallelUpdate(const bool parallel)
+    {
+        m_parallelUpdate = parallel;
+    }
+
+    //////////////////////////////////////////////
+
+    bool Scene::parallelUpdateEnabled() const
+    {
+        return m_parallelUpdate;
+    }
+
+    //////////////////////////////////////////////
+
+    void Scene::setBatchedUpdate(const bool batched)
+    {
+        m_batchedUpdate = batched;
+    }
+
+    //////////////////////////////////////////////
+
+    bool Scene::batchedUpdateEnabled() const
+    {
+        return m_batchedUpdate;
+    }
+
+    //////////////////////////////////////////////
+
     Message::Result Scene::sendMessage(const Message& message)
     {
-        if (message.passFilter(getID()))
+        if (passIDFilter(message))
         {
             if ((message.passFilter(Message::Scene) || (this == &Engine::getSharedScene() && message.passFilter(Message::SharedScene))))
             {
@@ -138,24 +146,80 @@ namespace jop
     {
         if (isActive())
         {
+            JOP_PROFILE_TYPE_SCOPE(typeid(*this), "scene");
+
             const float dt = deltaTime * m_deltaScale;
 
             // Have to check every step since engine state
             // might be changed at any time
 
             if (Engine::getState() == Engine::State::Running)
+            {
+                JOP_PROFILE_SCOPE_CATEGORY("Scene::preUpdate", "scene");
                 preUpdate(dt);
+            }
 
             if (Engine::getState() == Engine::State::Running)
-                Object::update(dt);
-
-            
-            if (detail::CullerComponent::cullingEnabled() && Engine::getState() < Engine::State::Frozen)
-                m_cullingWorld.update(1.f / 60.f);
+            {
+                JOP_PROFILE_SCOPE_CATEGORY("Object update", "scene");
+
+                if (m_parallelUpdate)
+                    Object::updateParallel(dt);
+                else if (m_batchedUpdate)
+                    updateBatched(dt);
+                else
+                    Object::update(dt);
+            }
 
             if (Engine::getState() == Engine::State::Running)
+            {
+                JOP_PROFILE_SCOPE_CATEGORY("Scene::postUpdate", "scene");
                 postUpdate(dt);
+            }
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void Scene::updateBatched(const float deltaTime)
+    {
+        gatherUpdates(m_updateLists, m_updateOrder);
+
+        for (auto type : m_updateOrder)
+        {
+            auto& list = m_updateLists[type];
+
+            JOP_PROFILE_TYPE_SCOPE(list.empty() || !list.front() ? typeid(Component) : typeid(*list.front()), "update");
+
+            // Components destroyed during the update have their entries cleared.
+            // Components created during it will be updated next frame
+            for (std::size_t i = 0; i < list.size(); ++i)
+            {
+                Component* comp = list[i];
+
+                if (!comp)
+                    continue;
+
+                comp->m_batch = nullptr;
+
+                // The object may have been deactivated or removed earlier in this frame
+                if (comp->isActive())
+                    comp->update(deltaTime);
+            }
+
+            list.clear();
         }
+
+        m_updateOrder.clear();
+    }
+
+    //////////////////////////////////////////////
+
+    void Scene::updateTransforms()
+    {
+        JOP_PROFILE_SCOPE_CATEGORY("Transform update", "scene");
+
+        m_transforms->update();
     }
 
     //////////////////////////////////////////////
@@ -186,6 +250,6 @@ namespace jop
 
     Message::Result Scene::receiveMessage(const Message& message)
     {
-        return JOP_EXECUTE_COMMAND(Scene, message.getString(), this);
+        return JOP_EXECUTE_COMMAND(Scene, message, this);
     }
 }
\ No newline at end of file
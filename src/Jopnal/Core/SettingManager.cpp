@@ -493,6 +493,9 @@ namespace jop
           m_updaters        (),
           m_wasSaved        (false)
     {
+        // Setting callbacks may touch anything, including the window
+        setAffinity(Stage::PreUpdate, Affinity::Render);
+
         {
             std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
@@ -45,9 +45,14 @@ namespace jop
 namespace jop
 {
     Subsystem::Subsystem(const uint32 ID)
-        : m_ID      (ID),
-          m_active  (true)
-    {}
+        : m_ID          (ID),
+          m_active      (true),
+          m_affinities  ()
+    {
+        m_affinities[static_cast<int>(Stage::PreUpdate)] = Affinity::Simulation;
+        m_affinities[static_cast<int>(Stage::PostUpdate)] = Affinity::Simulation;
+        m_affinities[static_cast<int>(Stage::Draw)] = Affinity::Render;
+    }
 
     Subsystem::~Subsystem()
     {}
@@ -102,8 +107,23 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    Subsystem& Subsystem::setAffinity(const Stage stage, const Affinity affinity)
+    {
+        m_affinities[static_cast<int>(stage)] = affinity;
+        return *this;
+    }
+
+    //////////////////////////////////////////////
+
+    Subsystem::Affinity Subsystem::getAffinity(const Stage stage) const
+    {
+        return m_affinities[static_cast<int>(stage)];
+    }
+
+    //////////////////////////////////////////////
+
     Message::Result Subsystem::receiveMessage(const Message& message)
     {
-        return JOP_EXECUTE_COMMAND(Subsystem, message.getString(), this);
+        return JOP_EXECUTE_COMMAND(Subsystem, message, this);
     }
 }
\ No newline at end of file
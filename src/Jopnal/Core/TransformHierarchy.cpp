@@ -0,0 +1,249 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Core/TransformHierarchy.hpp>
+
+    #include <Jopnal/Core/Object.hpp>
+    #include <algorithm>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace jop { namespace detail
+{
+    TransformHierarchy::TransformHierarchy(Object& root)
+        : m_root    (root),
+          m_objects (),
+          m_parents (),
+          m_ends    (),
+          m_dirty   ()
+    {}
+
+    TransformHierarchy::~TransformHierarchy()
+    {
+        for (auto i : m_objects)
+            i->m_hierarchy = nullptr;
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformHierarchy::markDirty(const uint32 slot)
+    {
+        m_dirty[slot] = 1;
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformHierarchy::update()
+    {
+        if (m_objects.empty())
+            rebuild();
+
+        const auto begin = m_dirty.begin();
+        auto itr = std::find(begin, m_dirty.end(), uint8(1));
+
+        while (itr != m_dirty.end())
+        {
+            const uint32 first = static_cast<uint32>(itr - begin);
+            const uint32 end = m_ends[first];
+
+            // Marks inside the range are covered by it. Parents come before their
+            // children, so the parent matrices are always up to date when read
+            for (uint32 i = first; i < end; ++i)
+            {
+                const Object* obj = m_objects[i];
+
+                if (obj->flagSet(Object::MatrixDirty))
+                {
+                    const int32 parent = m_parents[i];
+                    obj->resolveTransform(parent >= 0 ? &m_objects[parent]->getTransform().getMatrix() : nullptr);
+                }
+            }
+
+            std::fill(itr, begin + end, uint8(0));
+            itr = std::find(begin + end, m_dirty.end(), uint8(1));
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformHierarchy::link(Object& object)
+    {
+        JOP_ASSERT(!object.m_hierarchy, "Object is already laid out");
+
+        const auto parent = object.m_parent.get();
+
+        if (parent && parent->m_hierarchy)
+            parent->m_hierarchy->insert(object, parent->m_hierarchySlot);
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformHierarchy::unlink(Object& object)
+    {
+        if (auto h = object.m_hierarchy)
+        {
+            const uint32 slot = object.m_hierarchySlot;
+            h->remove(slot, h->m_ends[slot], h->m_parents[slot]);
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformHierarchy::unlinkChildren(Object& object)
+    {
+        if (auto h = object.m_hierarchy)
+        {
+            const uint32 slot = object.m_hierarchySlot;
+            h->remove(slot + 1, h->m_ends[slot], static_cast<int32>(slot));
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformHierarchy::replace(Object& from, Object& to)
+    {
+        if (auto h = from.m_hierarchy)
+        {
+            h->m_objects[from.m_hierarchySlot] = &to;
+
+            to.m_hierarchy = h;
+            to.m_hierarchySlot = from.m_hierarchySlot;
+            from.m_hierarchy = nullptr;
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformHierarchy::rebuild()
+    {
+        m_objects.clear();
+        m_parents.clear();
+        m_ends.clear();
+        m_dirty.clear();
+
+        append(m_root, -1);
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformHierarchy::append(Object& object, const int32 parent)
+    {
+        const uint32 slot = static_cast<uint32>(m_objects.size());
+
+        m_objects.push_back(&object);
+        m_parents.push_back(parent);
+        m_ends.push_back(0);
+        m_dirty.push_back(object.flagSet(Object::MatrixDirty));
+
+        object.m_hierarchy = this;
+        object.m_hierarchySlot = slot;
+
+        for (auto i : object.m_children)
+            append(*i, static_cast<int32>(slot));
+
+        m_ends[slot] = static_cast<uint32>(m_objects.size());
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformHierarchy::insert(Object& object, const uint32 parent)
+    {
+        // The subtree is laid out at the back and then rotated to the end of the parent's range
+        const uint32 pos = m_ends[parent];
+        const uint32 oldSize = static_cast<uint32>(m_objects.size());
+
+        append(object, static_cast<int32>(parent));
+
+        const uint32 newSize = static_cast<uint32>(m_objects.size());
+        const uint32 count = newSize - oldSize;
+
+        if (pos != oldSize)
+        {
+            const uint32 shift = oldSize - pos;
+
+            for (uint32 i = pos; i < oldSize; ++i)
+            {
+                if (m_parents[i] >= static_cast<int32>(pos))
+                    m_parents[i] += count;
+
+                m_ends[i] += count;
+            }
+
+            for (uint32 i = oldSize; i < newSize; ++i)
+            {
+                if (m_parents[i] >= static_cast<int32>(oldSize))
+                    m_parents[i] -= shift;
+
+                m_ends[i] -= shift;
+            }
+
+            std::rotate(m_objects.begin() + pos, m_objects.begin() + oldSize, m_objects.end());
+            std::rotate(m_parents.begin() + pos, m_parents.begin() + oldSize, m_parents.end());
+            std::rotate(m_ends.begin() + pos, m_ends.begin() + oldSize, m_ends.end());
+            std::rotate(m_dirty.begin() + pos, m_dirty.begin() + oldSize, m_dirty.end());
+
+            for (uint32 i = pos; i < newSize; ++i)
+                m_objects[i]->m_hierarchySlot = i;
+        }
+
+        for (int32 i = static_cast<int32>(parent); i >= 0; i = m_parents[i])
+            m_ends[i] += count;
+    }
+
+    //////////////////////////////////////////////
+
+    void TransformHierarchy::remove(const uint32 first, const uint32 last, const int32 owner)
+    {
+        const uint32 count = last - first;
+
+        if (!count)
+            return;
+
+        for (uint32 i = first; i < last; ++i)
+            m_objects[i]->m_hierarchy = nullptr;
+
+        // The ranges containing the removed one shrink, the ones after it move down
+        for (int32 i = owner; i >= 0; i = m_parents[i])
+            m_ends[i] -= count;
+
+        m_objects.erase(m_objects.begin() + first, m_objects.begin() + last);
+        m_parents.erase(m_parents.begin() + first, m_parents.begin() + last);
+        m_ends.erase(m_ends.begin() + first, m_ends.begin() + last);
+        m_dirty.erase(m_dirty.begin() + first, m_dirty.begin() + last);
+
+        for (uint32 i = first; i < m_objects.size(); ++i)
+        {
+            if (m_parents[i] >= static_cast<int32>(last))
+                m_parents[i] -= count;
+
+            m_ends[i] -= count;
+            m_objects[i]->m_hierarchySlot = i;
+        }
+    }
+}}
\ No newline at end of file
@@ -0,0 +1,141 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_TRANSFORMHIERARCHY_HPP
+#define JOP_TRANSFORMHIERARCHY_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <glm/mat4x4.hpp>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    class Object;
+
+    namespace detail
+    {
+        /// \brief Depth-ordered transform data of a scene
+        ///
+        /// The objects of a scene are laid out in depth-first order, so every parent
+        /// comes before its children and every subtree occupies a contiguous range.
+        /// Setting a transform marks the object's entry dirty, and update() then
+        /// recomputes the world matrices of the dirty ranges in one linear pass.
+        /// The matrices are written straight into the objects, and the parents
+        /// are always resolved before their children.
+        ///
+        /// The layout is built on the first update. After that, objects attached to
+        /// a laid out parent are spliced in at the end of the parent's range, and
+        /// destroyed or reparented subtrees are spliced out. Changes to one scene
+        /// never touch the layouts of the others. Object::getTransform() still
+        /// resolves matrices lazily when they're needed before the pass, and objects
+        /// outside of any layout only use that.
+        ///
+        /// None of the functions may be called while the scene is being updated in
+        /// parallel, except markDirty().
+        ///
+        class TransformHierarchy final
+        {
+        private:
+
+            JOP_DISALLOW_COPY_MOVE(TransformHierarchy);
+
+        public:
+
+            /// \brief Constructor
+            ///
+            /// \param root The root object, the scene
+            ///
+            TransformHierarchy(Object& root);
+
+            /// \brief Destructor
+            ///
+            /// Unlinks the objects that are still in the layout.
+            ///
+            ~TransformHierarchy();
+
+
+            /// \brief Mark the entry of an object dirty
+            ///
+            /// Can be called from several threads, as long as the slots are different.
+            ///
+            /// \param slot Slot of the object
+            ///
+            void markDirty(const uint32 slot);
+
+            /// \brief Recompute the world matrices of the dirty subtrees
+            ///
+            void update();
+
+            /// \brief Add an object to the layout of its parent
+            ///
+            /// Call after the object has been attached to its parent. The whole
+            /// subtree is added. Does nothing if the parent isn't laid out.
+            ///
+            /// \param object The object
+            ///
+            static void link(Object& object);
+
+            /// \brief Remove an object and its subtree from their layout
+            ///
+            /// \param object The object
+            ///
+            static void unlink(Object& object);
+
+            /// \brief Remove the subtrees of the children of an object from their layout
+            ///
+            /// \param object The object
+            ///
+            static void unlinkChildren(Object& object);
+
+            /// \brief Give the entry of an object to another object
+            ///
+            /// Used when an object is moved into another one.
+            ///
+            /// \param from The object to take the entry from
+            /// \param to The object to give the entry to
+            ///
+            static void replace(Object& from, Object& to);
+
+        private:
+
+            void rebuild();
+
+            void append(Object& object, const int32 parent);
+
+            void insert(Object& object, const uint32 parent);
+
+            void remove(const uint32 first, const uint32 last, const int32 owner);
+
+
+            Object& m_root;                     ///< The root object
+            std::vector<Object*> m_objects;     ///< Objects in depth-first order
+            std::vector<int32> m_parents;       ///< Slot of the parent, -1 for the root
+            std::vector<uint32> m_ends;         ///< One past the last slot of the subtree
+            std::vector<uint8> m_dirty;         ///< Dirty marks, one per slot
+        };
+    }
+}
+
+#endif
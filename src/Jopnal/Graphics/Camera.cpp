@@ -33,8 +33,7 @@
     #include <Jopnal/Graphics/Renderer.hpp>
     #include <Jopnal/Utility/CommandHandler.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
-    #include <Jopnal/Graphics/Culling/CullerComponent.hpp>
-    #include <Jopnal/Physics/Shape/FrustumShape.hpp>
+    #include <Jopnal/Graphics/Culling/FrustumCuller.hpp>
     #include <glm/gtc/matrix_transform.hpp>
 
 #endif
@@ -62,9 +61,8 @@ namespace jop
         : Component                 (object, 0),
           m_projectionMatrix        (),
           m_renderTexture           (),
-          m_drawables               (),
-          m_lights                  (),
-          m_culler                  (),
+          m_visibleDrawables        (),
+          m_visibility              (),
           m_viewPort                (glm::vec2(0.f), glm::vec2(1.f)),
           m_projData                ({{0.f, 0.f}}),
           m_clippingPlanes          (0.f, 0.f),
@@ -89,23 +87,15 @@ namespace jop
             setSize(Engine::getMainRenderTarget().getSize());
         }
 
-        if (detail::CullerComponent::cullingEnabled())
-        {
-            m_culler = std::make_unique<detail::CullerComponent>(object, renderer.getCullingWorld(), detail::CullerComponent::Type::Camera, this);
-            m_shape = std::make_unique<FrustumShape>("");
-            updateShape();
-        }
-
-        renderer.bind(this);
+        object.runSerial([this]() { m_rendererRef.bind(this); });
     }
 
     Camera::Camera(const Camera& other, Object& newObj)
         : Component                 (other, newObj),
           m_projectionMatrix        (other.m_projectionMatrix),
           m_renderTexture           (),
-          m_drawables               (),
-          m_lights                  (),
-          m_culler                  (),
+          m_visibleDrawables        (),
+          m_visibility              (),
           m_viewPort                (other.m_viewPort),
           m_projData                (other.m_projData),
           m_clippingPlanes          (other.m_clippingPlanes),
@@ -114,14 +104,7 @@ namespace jop
           m_mode                    (other.m_mode),
           m_projectionNeedUpdate    (other.m_projectionNeedUpdate)
     {
-        if (other.m_culler)
-        {
-            m_culler = std::make_unique<detail::CullerComponent>(*other.m_culler, newObj, this);
-            m_shape = std::make_unique<FrustumShape>("");
-            updateShape();
-        }
-
-        m_rendererRef.bind(this);
+        newObj.runSerial([this]() { m_rendererRef.bind(this); });
     }
     
     Camera::~Camera()
@@ -129,13 +112,6 @@ namespace jop
         m_rendererRef.unbind(this);
     }
 
-    //////////////////////////////////////////////
-
-    void Camera::update(const float deltaTime)
-    {
-        if (m_culler)
-            m_culler->update(deltaTime);
-    }
 
     //////////////////////////////////////////////
 
@@ -189,7 +165,7 @@ namespace jop
         m_mode = mode;
         m_projectionNeedUpdate = true;
 
-        return updateShape();
+        return *this;
     }
 
     //////////////////////////////////////////////
@@ -206,7 +182,7 @@ namespace jop
         m_clippingPlanes = ClippingPlanes(clipNear, clipFar);
         m_projectionNeedUpdate = true;
 
-        return updateShape();
+        return *this;
     }
 
     //////////////////////////////////////////////
@@ -236,7 +212,7 @@ namespace jop
         else
             setAspectRatio(x / y);
 
-        return updateShape();
+        return *this;
     }
 
     //////////////////////////////////////////////
@@ -253,7 +229,7 @@ namespace jop
         m_projData.perspective.aspectRatio = ratio;
         m_projectionNeedUpdate = true;
 
-        return updateShape();
+        return *this;
     }
 
     //////////////////////////////////////////////
@@ -270,7 +246,7 @@ namespace jop
         m_projData.perspective.fov = fovY;
         m_projectionNeedUpdate = true;
 
-        return updateShape();
+        return *this;
     }
 
     //////////////////////////////////////////////
@@ -339,33 +315,23 @@ namespace jop
 
     bool Camera::inView(const Drawable& drawable) const
     {
-        return !detail::CullerComponent::cullingEnabled() || m_drawables.find(&drawable) != m_drawables.end();
+        return !detail::FrustumCuller::cullingEnabled() || detail::FrustumCuller::inView(*this, drawable);
     }
 
     //////////////////////////////////////////////
 
-    Message::Result Camera::receiveMessage(const Message& message)
+    const std::vector<const Drawable*>& Camera::getVisibleDrawables() const
     {
-        if (JOP_EXECUTE_COMMAND(Camera, message.getString(), this) == Message::Result::Escape)
-            return Message::Result::Escape;
-
-        return Component::receiveMessage(message); 
+        return m_visibleDrawables;
     }
 
     //////////////////////////////////////////////
 
-    Camera& Camera::updateShape()
+    Message::Result Camera::receiveMessage(const Message& message)
     {
-        if (m_culler)
-        {
-            if (getProjectionMode() == Projection::Perspective)
-                m_shape->load(getClippingPlanes(), getFieldOfView(), getAspectRatio(), glm::quat());
-            else
-                m_shape->load(getClippingPlanes(), getSize(), glm::quat());
-
-            m_culler->updateWorldBounds();
-        }
+        if (JOP_EXECUTE_COMMAND(Camera, message, this) == Message::Result::Escape)
+            return Message::Result::Escape;
 
-        return *this;
+        return Component::receiveMessage(message); 
     }
 }
\ No newline at end of file
@@ -0,0 +1,476 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Graphics/Culling/FrustumCuller.hpp>
+
+    #include <Jopnal/Core/Object.hpp>
+    #include <Jopnal/Core/SettingManager.hpp>
+    #include <Jopnal/Graphics/Camera.hpp>
+    #include <Jopnal/Graphics/Drawable.hpp>
+    #include <Jopnal/Graphics/Mesh/Mesh.hpp>
+    #include <glm/matrix.hpp>
+    #include <algorithm>
+    #include <cfloat>
+
+#endif
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define JOP_CULLER_SSE
+    #include <xmmintrin.h>
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    // Maximum amount of items in a leaf. Multiple of the SIMD width
+    const jop::uint32 ns_leafSize = 8;
+
+    // Padding at the end of the bounds arrays, so that the last items can be loaded four at a time
+    const std::size_t ns_boundsPadding = 3;
+
+    typedef std::array<glm::vec4, 6> FrustumPlanes;
+
+    FrustumPlanes extractPlanes(const glm::mat4& pv)
+    {
+        const glm::mat4 rows(glm::transpose(pv));
+
+        return FrustumPlanes
+        {{
+            rows[3] + rows[0], rows[3] - rows[0],
+            rows[3] + rows[1], rows[3] - rows[1],
+            rows[3] + rows[2], rows[3] - rows[2]
+        }};
+    }
+
+    enum class Containment
+    {
+        Outside,
+        Intersects,
+        Inside
+    };
+
+    Containment classify(const FrustumPlanes& planes, const glm::vec3& min, const glm::vec3& max)
+    {
+        Containment result = Containment::Inside;
+
+        for (auto& p : planes)
+        {
+            // The corners furthest along and against the plane normal
+            const glm::vec3 pos(p.x >= 0.f ? max.x : min.x, p.y >= 0.f ? max.y : min.y, p.z >= 0.f ? max.z : min.z);
+            const glm::vec3 neg(p.x >= 0.f ? min.x : max.x, p.y >= 0.f ? min.y : max.y, p.z >= 0.f ? min.z : max.z);
+
+            if (glm::dot(glm::vec3(p), pos) + p.w < 0.f)
+                return Containment::Outside;
+
+            if (glm::dot(glm::vec3(p), neg) + p.w < 0.f)
+                result = Containment::Intersects;
+        }
+
+        return result;
+    }
+}
+
+namespace jop { namespace detail
+{
+    FrustumCuller::FrustumCuller()
+        : m_drawables   (),
+          m_transforms  (),
+          m_meshes      (),
+          m_slotLeaves  (),
+          m_slotItems   (),
+          m_itemSlots   (),
+          m_bounds      (),
+          m_nodes       (),
+          m_dirtyNodes  (),
+          m_needRebuild (false)
+    {}
+
+    //////////////////////////////////////////////
+
+    void FrustumCuller::add(Drawable& drawable)
+    {
+        drawable.m_cullSlot = static_cast<uint32>(m_drawables.size());
+
+        m_drawables.push_back(&drawable);
+        m_transforms.emplace_back();
+        m_meshes.push_back(nullptr);
+
+        m_needRebuild = true;
+    }
+
+    //////////////////////////////////////////////
+
+    void FrustumCuller::remove(Drawable& drawable)
+    {
+        const uint32 slot = drawable.m_cullSlot;
+
+        if (slot >= m_drawables.size() || m_drawables[slot] != &drawable)
+            return;
+
+        // Move the last drawable into the freed slot
+        m_drawables[slot] = m_drawables.back();
+        m_drawables[slot]->m_cullSlot = slot;
+        m_transforms[slot] = m_transforms.back();
+        m_meshes[slot] = m_meshes.back();
+
+        m_drawables.pop_back();
+        m_transforms.pop_back();
+        m_meshes.pop_back();
+
+        drawable.m_cullSlot = Drawable::NotCulled;
+        m_needRebuild = true;
+    }
+
+    //////////////////////////////////////////////
+
+    void FrustumCuller::update()
+    {
+        if (m_needRebuild)
+        {
+            rebuild();
+            return;
+        }
+
+        std::size_t moved = 0;
+
+        for (uint32 slot = 0; slot < m_drawables.size(); ++slot)
+        {
+            auto d = m_drawables[slot];
+            auto& transform = d->getObject()->getTransform().getMatrix();
+            auto mesh = d->getMesh();
+
+            if (mesh == m_meshes[slot] && transform == m_transforms[slot])
+                continue;
+
+            m_transforms[slot] = transform;
+            m_meshes[slot] = mesh;
+
+            const auto bounds = d->getGlobalBounds();
+            const uint32 item = m_slotItems[slot];
+
+            m_bounds[0][item] = bounds.first.x;
+            m_bounds[1][item] = bounds.first.y;
+            m_bounds[2][item] = bounds.first.z;
+            m_bounds[3][item] = bounds.second.x;
+            m_bounds[4][item] = bounds.second.y;
+            m_bounds[5][item] = bounds.second.z;
+
+            m_dirtyNodes[m_slotLeaves[slot]] = 1;
+            ++moved;
+        }
+
+        // Refitting degrades the tree, rebuild it when most of the objects have moved
+        if (moved > m_drawables.size() / 2)
+            rebuild();
+        else if (moved)
+            refit();
+    }
+
+    //////////////////////////////////////////////
+
+    void FrustumCuller::cull(const Camera& camera) const
+    {
+        auto& visible = camera.m_visibleDrawables;
+        auto& flags = camera.m_visibility;
+
+        visible.clear();
+        flags.assign(m_drawables.size(), 0);
+
+        if (m_nodes.empty())
+            return;
+
+        const FrustumPlanes planes = extractPlanes(camera.getProjectionMatrix() * camera.getViewMatrix());
+        const uint32 mask = camera.getRenderMask();
+
+        auto accept = [&visible, &flags, mask, this](const uint32 item)
+        {
+            const uint32 slot = m_itemSlots[item];
+            auto d = m_drawables[slot];
+
+            if ((mask & (1 << d->getRenderGroup())) != 0)
+            {
+                flags[slot] = 1;
+                visible.push_back(d);
+            }
+        };
+
+        // Depth is bounded by the tree height, which stays low with median splits
+        uint32 stack[64];
+        uint32 top = 0;
+        stack[top++] = 0;
+
+        while (top)
+        {
+            const Node& node = m_nodes[stack[--top]];
+            const Containment c = classify(planes, node.min, node.max);
+
+            if (c == Containment::Outside)
+                continue;
+
+            if (c == Containment::Inside)
+            {
+                // Every item in the subtree is stored contiguously
+                for (uint32 i = node.first; i < node.first + node.count; ++i)
+                    accept(i);
+
+                continue;
+            }
+
+            if (node.right)
+            {
+                stack[top++] = node.right;
+                stack[top++] = static_cast<uint32>(&node - m_nodes.data()) + 1;
+
+                continue;
+            }
+
+            // Partially visible leaf, test the items against the planes
+            const float* const minX = m_bounds[0].data() + node.first;
+            const float* const minY = m_bounds[1].data() + node.first;
+            const float* const minZ = m_bounds[2].data() + node.first;
+            const float* const maxX = m_bounds[3].data() + node.first;
+            const float* const maxY = m_bounds[4].data() + node.first;
+            const float* const maxZ = m_bounds[5].data() + node.first;
+
+        #ifdef JOP_CULLER_SSE
+
+            for (uint32 i = 0; i < node.count; i += 4)
+            {
+                __m128 inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+
+                for (auto& p : planes)
+                {
+                    // Test the corner furthest along the plane normal
+                    const __m128 x = _mm_loadu_ps((p.x >= 0.f ? maxX : minX) + i);
+                    const __m128 y = _mm_loadu_ps((p.y >= 0.f ? maxY : minY) + i);
+                    const __m128 z = _mm_loadu_ps((p.z >= 0.f ? maxZ : minZ) + i);
+
+                    const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(p.x)), _mm_mul_ps(y, _mm_set1_ps(p.y))),
+                                                   _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(p.z)), _mm_set1_ps(p.w)));
+
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, _mm_setzero_ps()));
+                }
+
+                const int bits = _mm_movemask_ps(inside);
+
+                for (uint32 j = 0; j < 4 && i + j < node.count; ++j)
+                {
+                    if (bits & (1 << j))
+                        accept(node.first + i + j);
+                }
+            }
+
+        #else
+
+            for (uint32 i = 0; i < node.count; ++i)
+            {
+                if (classify(planes, glm::vec3(minX[i], minY[i], minZ[i]), glm::vec3(maxX[i], maxY[i], maxZ[i])) != Containment::Outside)
+                    accept(node.first + i);
+            }
+
+        #endif
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    bool FrustumCuller::inView(const Camera& camera, const Drawable& drawable)
+    {
+        const uint32 slot = drawable.m_cullSlot;
+
+        // Drawables added after the last cull are considered visible until the next one
+        return slot == Drawable::NotCulled || slot >= camera.m_visibility.size() || camera.m_visibility[slot] != 0;
+    }
+
+    //////////////////////////////////////////////
+
+    bool FrustumCuller::cullingEnabled()
+    {
+        static const bool culling = SettingManager::get<bool>("engine@Graphics|bCulling", true);
+        return culling;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 FrustumCuller::build(const uint32 parent, const uint32 first, const uint32 count)
+    {
+        const uint32 index = static_cast<uint32>(m_nodes.size());
+
+        m_nodes.emplace_back();
+        m_nodes[index].first = first;
+        m_nodes[index].count = count;
+        m_nodes[index].right = 0;
+        m_nodes[index].parent = parent;
+
+        fitNode(m_nodes[index]);
+
+        if (count <= ns_leafSize)
+        {
+            for (uint32 i = first; i < first + count; ++i)
+                m_slotLeaves[m_itemSlots[i]] = index;
+
+            return index;
+        }
+
+        // Split at the median along the longest axis
+        const glm::vec3 extent = m_nodes[index].max - m_nodes[index].min;
+        const int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+        auto& minBounds = m_bounds[axis];
+        auto& maxBounds = m_bounds[axis + 3];
+
+        // Sort the tree order indices, the bounds are reordered once the tree is complete
+        static std::vector<uint32> order;
+        order.resize(count);
+
+        for (uint32 i = 0; i < count; ++i)
+            order[i] = first + i;
+
+        const uint32 half = count / 2;
+
+        std::nth_element(order.begin(), order.begin() + half, order.end(), [&minBounds, &maxBounds](const uint32 a, const uint32 b)
+        {
+            return minBounds[a] + maxBounds[a] < minBounds[b] + maxBounds[b];
+        });
+
+        static std::vector<uint32> slots;
+        static std::array<std::vector<float>, 6> bounds;
+
+        slots.resize(count);
+
+        for (auto& i : bounds)
+            i.resize(count);
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            slots[i] = m_itemSlots[order[i]];
+
+            for (int j = 0; j < 6; ++j)
+                bounds[j][i] = m_bounds[j][order[i]];
+        }
+
+        std::copy(slots.begin(), slots.end(), m_itemSlots.begin() + first);
+
+        for (int j = 0; j < 6; ++j)
+            std::copy(bounds[j].begin(), bounds[j].end(), m_bounds[j].begin() + first);
+
+        build(index, first, half);
+        const uint32 right = build(index, first + half, count - half);
+
+        m_nodes[index].right = right;
+
+        return index;
+    }
+
+    //////////////////////////////////////////////
+
+    void FrustumCuller::rebuild()
+    {
+        const std::size_t size = m_drawables.size();
+
+        m_itemSlots.resize(size);
+        m_slotItems.resize(size);
+        m_slotLeaves.resize(size);
+
+        for (auto& i : m_bounds)
+            i.assign(size + ns_boundsPadding, 0.f);
+
+        for (uint32 slot = 0; slot < size; ++slot)
+        {
+            auto d = m_drawables[slot];
+
+            m_transforms[slot] = d->getObject()->getTransform().getMatrix();
+            m_meshes[slot] = d->getMesh();
+
+            const auto bounds = d->getGlobalBounds();
+
+            m_itemSlots[slot] = slot;
+
+            m_bounds[0][slot] = bounds.first.x;
+            m_bounds[1][slot] = bounds.first.y;
+            m_bounds[2][slot] = bounds.first.z;
+            m_bounds[3][slot] = bounds.second.x;
+            m_bounds[4][slot] = bounds.second.y;
+            m_bounds[5][slot] = bounds.second.z;
+        }
+
+        m_nodes.clear();
+
+        if (size)
+            build(0, 0, static_cast<uint32>(size));
+
+        for (uint32 i = 0; i < size; ++i)
+            m_slotItems[m_itemSlots[i]] = i;
+
+        m_dirtyNodes.assign(m_nodes.size(), 0);
+        m_needRebuild = false;
+    }
+
+    //////////////////////////////////////////////
+
+    void FrustumCuller::refit()
+    {
+        // Children are always stored after their parents
+        for (std::size_t i = m_nodes.size(); i-- > 0;)
+        {
+            if (!m_dirtyNodes[i])
+                continue;
+
+            auto& node = m_nodes[i];
+            m_dirtyNodes[i] = 0;
+
+            if (node.right)
+            {
+                auto& left = m_nodes[i + 1];
+                auto& right = m_nodes[node.right];
+
+                node.min = glm::min(left.min, right.min);
+                node.max = glm::max(left.max, right.max);
+            }
+            else
+                fitNode(node);
+
+            if (i)
+                m_dirtyNodes[node.parent] = 1;
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void FrustumCuller::fitNode(Node& node) const
+    {
+        node.min = glm::vec3(FLT_MAX);
+        node.max = glm::vec3(-FLT_MAX);
+
+        for (uint32 i = node.first; i < node.first + node.count; ++i)
+        {
+            node.min = glm::min(node.min, glm::vec3(m_bounds[0][i], m_bounds[1][i], m_bounds[2][i]));
+            node.max = glm::max(node.max, glm::vec3(m_bounds[3][i], m_bounds[4][i], m_bounds[5][i]));
+        }
+    }
+}}
\ No newline at end of file
@@ -0,0 +1,142 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_FRUSTUMCULLER_HPP
+#define JOP_FRUSTUMCULLER_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <array>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    class Camera;
+    class Drawable;
+    class Mesh;
+
+    namespace detail
+    {
+        /// \brief Frustum culler
+        ///
+        /// Keeps the world bounds of the culled drawables in flat arrays, ordered
+        /// by a bounding volume hierarchy. Only the drawables whose transform or
+        /// mesh has changed are updated every frame, after which the affected
+        /// nodes are refitted. The tree is rebuilt when drawables are added or
+        /// removed, or when most of them have moved.
+        ///
+        class FrustumCuller final
+        {
+        private:
+
+            JOP_DISALLOW_COPY_MOVE(FrustumCuller);
+
+        public:
+
+            /// \brief Constructor
+            ///
+            FrustumCuller();
+
+
+            /// \brief Add a drawable
+            ///
+            /// \param drawable The drawable to add
+            ///
+            void add(Drawable& drawable);
+
+            /// \brief Remove a drawable
+            ///
+            /// \param drawable The drawable to remove
+            ///
+            void remove(Drawable& drawable);
+
+            /// \brief Update the bounds of the moved drawables
+            ///
+            /// Must be called once per frame, before cull().
+            ///
+            void update();
+
+            /// \brief Find the drawables visible to a camera
+            ///
+            /// The results are written into the camera's visible drawable list.
+            ///
+            /// \param camera The camera
+            ///
+            void cull(const Camera& camera) const;
+
+            /// \brief Check if a drawable was visible to a camera during the last cull()
+            ///
+            /// \param camera The camera
+            /// \param drawable The drawable
+            ///
+            /// \return True if visible. Always true if the drawable isn't culled
+            ///
+            static bool inView(const Camera& camera, const Drawable& drawable);
+
+            /// \brief Check if culling is enabled
+            ///
+            /// Controlled by the setting engine@Graphics|bCulling.
+            ///
+            /// \return True if enabled
+            ///
+            static bool cullingEnabled();
+
+        private:
+
+            struct Node
+            {
+                glm::vec3 min;      ///< Minimum bounds
+                uint32 first;       ///< First item in tree order
+                glm::vec3 max;      ///< Maximum bounds
+                uint32 count;       ///< Amount of items
+                uint32 right;       ///< Right child. The left child follows this node. 0 for leaves
+                uint32 parent;      ///< Parent node
+            };
+
+            uint32 build(const uint32 parent, const uint32 first, const uint32 count);
+
+            void rebuild();
+
+            void refit();
+
+            void fitNode(Node& node) const;
+
+
+            std::vector<Drawable*> m_drawables;             ///< Culled drawables, indexed by slot
+            std::vector<glm::mat4> m_transforms;            ///< Transforms at the time of the last update, by slot
+            std::vector<const Mesh*> m_meshes;              ///< Meshes at the time of the last update, by slot
+            std::vector<uint32> m_slotLeaves;               ///< Leaf node of each slot
+            std::vector<uint32> m_slotItems;                ///< Tree order index of each slot
+            std::vector<uint32> m_itemSlots;                ///< Slot of each item in tree order
+            std::array<std::vector<float>, 6> m_bounds;     ///< Item bounds in tree order (min x, y, z, max x, y, z)
+            std::vector<Node> m_nodes;                      ///< Tree nodes. The root is at index 0
+            std::vector<uint8> m_dirtyNodes;                ///< Nodes that need to be refitted
+            bool m_needRebuild;                             ///< Have drawables been added or removed?
+        };
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,340 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Graphics/Culling/LightClusterer.hpp>
+
+    #include <Jopnal/Core/Object.hpp>
+    #include <Jopnal/Core/SettingManager.hpp>
+    #include <Jopnal/Graphics/Camera.hpp>
+    #include <Jopnal/Graphics/LightSource.hpp>
+    #include <Jopnal/Graphics/RenderTarget.hpp>
+    #include <glm/geometric.hpp>
+    #include <algorithm>
+    #include <cfloat>
+    #include <cstring>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    // Cluster grid dimensions. Must match JOP_CLUSTER_X/Y/Z in the shaders
+    const unsigned int ns_clusterDims[] = {16, 8, 24};
+    const unsigned int ns_clusterCount = 16 * 8 * 24;
+
+    // Each cluster is packed as (count << 24) | offset
+    const jop::uint32 ns_maxClusterLights = 0xFF;
+
+    // Upper limit for the size of a single block, bigger blocks wouldn't pay off
+    const unsigned int ns_maxBlockSize = 0x10000;
+
+    // CPU side mirror of ClusteredLightInfo
+    struct ClusteredLightBlock
+    {
+        glm::vec4 position;     ///< xyz = position, w = range
+        glm::vec4 direction;    ///< xyz = direction, w = 1 for spot lights
+        glm::vec4 ambient;      ///< w = inner cutoff cosine
+        glm::vec4 diffuse;      ///< w = outer cutoff cosine
+        glm::vec4 specular;
+        glm::vec4 attenuation;
+    };
+    static_assert(sizeof(ClusteredLightBlock) == 96, "ClusteredLightBlock doesn't match the std140 layout");
+
+    // Header of jop_ClusterGridBlock, followed by the packed clusters
+    struct ClusterGridHeader
+    {
+        glm::vec4 viewport;     ///< xy = viewport origin in pixels, zw = inverse viewport size
+        glm::vec4 depth;        ///< x = depth slice scale, y = depth slice bias
+    };
+
+    template<typename Func>
+    void forEachCluster(const unsigned int* min, const unsigned int* max, Func func)
+    {
+        for (unsigned int z = min[2]; z <= max[2]; ++z)
+        {
+            for (unsigned int y = min[1]; y <= max[1]; ++y)
+            {
+                for (unsigned int x = min[0]; x <= max[0]; ++x)
+                    func(x + ns_clusterDims[0] * (y + ns_clusterDims[1] * z));
+            }
+        }
+    }
+
+    unsigned int getBlockSize()
+    {
+        static const unsigned int size = std::min(jop::UniformBuffer::getMaximumSize(), ns_maxBlockSize);
+
+        return size;
+    }
+
+    // Amount of uvec4s in jop_ClusterIndexBlock. Each holds 8 light indices
+    unsigned int getIndexVectors()
+    {
+        return getBlockSize() / 16;
+    }
+}
+
+namespace jop { namespace detail
+{
+    LightClusterer::LightClusterer()
+        : m_candidates  (),
+          m_counts      (),
+          m_lightData   (),
+          m_gridData    (),
+          m_indexData   (),
+          m_lightBlock  (Buffer::StreamDraw),
+          m_gridBlock   (Buffer::StreamDraw),
+          m_indexBlock  (Buffer::StreamDraw)
+    {}
+
+    //////////////////////////////////////////////
+
+    unsigned int LightClusterer::build(const Camera& camera, const RenderTarget& mainTarget, const std::vector<const LightSource*>& lights)
+    {
+        const unsigned int maxLights = getMaximumLights();
+        const uint32 maxIndices = getIndexVectors() * 8;
+
+        const glm::mat4& view = camera.getViewMatrix();
+        const glm::mat4& proj = camera.getProjectionMatrix();
+
+        const float nearPlane = std::max(camera.getClippingPlanes().first, 0.001f);
+        const float farPlane = std::max(camera.getClippingPlanes().second, nearPlane * 2.f);
+
+        // Depth slices are distributed exponentially:
+        // slice = log(depth) * scale + bias
+        const float logRatio = std::log(farPlane / nearPlane);
+        const float depthScale = ns_clusterDims[2] / logRatio;
+        const float depthBias = -(ns_clusterDims[2] * std::log(nearPlane)) / logRatio;
+
+        auto getSlice = [depthScale, depthBias](const float depth) -> unsigned int
+        {
+            const float slice = std::log(std::max(depth, FLT_MIN)) * depthScale + depthBias;
+
+            return static_cast<unsigned int>(glm::clamp(slice, 0.f, static_cast<float>(ns_clusterDims[2] - 1)));
+        };
+
+        auto getTile = [](const float ndc, const unsigned int axis) -> unsigned int
+        {
+            const float tile = (ndc * 0.5f + 0.5f) * ns_clusterDims[axis];
+
+            return static_cast<unsigned int>(glm::clamp(tile, 0.f, static_cast<float>(ns_clusterDims[axis] - 1)));
+        };
+
+        // Find the lights inside the frustum and the clusters they touch
+        m_candidates.clear();
+
+        for (auto l : lights)
+        {
+            Candidate c;
+            c.light = l;
+            c.position = glm::vec3(view * glm::vec4(l->getObject()->getGlobalPosition(), 1.f));
+            c.range = l->getRange();
+
+            const float minDepth = -c.position.z - c.range;
+            const float maxDepth = -c.position.z + c.range;
+
+            if (maxDepth < nearPlane || minDepth > farPlane)
+                continue;
+
+            // Project the corners of the bounding box, clamped in front of the near plane
+            glm::vec2 ndcMin(FLT_MAX);
+            glm::vec2 ndcMax(-FLT_MAX);
+
+            for (int i = 0; i < 8; ++i)
+            {
+                glm::vec3 corner
+                (
+                    c.position.x + (i & 1 ? c.range : -c.range),
+                    c.position.y + (i & 2 ? c.range : -c.range),
+                    c.position.z + (i & 4 ? c.range : -c.range)
+                );
+                corner.z = std::min(corner.z, -nearPlane);
+
+                const glm::vec4 clip(proj * glm::vec4(corner, 1.f));
+                const glm::vec2 ndc(glm::vec2(clip) / clip.w);
+
+                ndcMin = glm::min(ndcMin, ndc);
+                ndcMax = glm::max(ndcMax, ndc);
+            }
+
+            if (ndcMax.x < -1.f || ndcMin.x > 1.f || ndcMax.y < -1.f || ndcMin.y > 1.f)
+                continue;
+
+            c.distance = std::max(glm::length(c.position) - c.range, 0.f);
+
+            c.min[0] = getTile(ndcMin.x, 0);
+            c.max[0] = getTile(ndcMax.x, 0);
+            c.min[1] = getTile(ndcMin.y, 1);
+            c.max[1] = getTile(ndcMax.y, 1);
+            c.min[2] = getSlice(std::max(minDepth, nearPlane));
+            c.max[2] = getSlice(std::min(maxDepth, farPlane));
+
+            m_candidates.push_back(c);
+        }
+
+        // Nearest lights first, they're kept when running out of space
+        std::sort(m_candidates.begin(), m_candidates.end(), [](const Candidate& a, const Candidate& b)
+        {
+            return a.distance < b.distance;
+        });
+
+        if (m_candidates.size() > maxLights)
+            m_candidates.resize(maxLights);
+
+        // Count the lights in each cluster
+        m_counts.assign(ns_clusterCount, 0);
+
+        for (auto& c : m_candidates)
+        {
+            forEachCluster(c.min, c.max, [this](const unsigned int cluster)
+            {
+                m_counts[cluster] = std::min(m_counts[cluster] + 1, ns_maxClusterLights);
+            });
+        }
+
+        // Assign the index list ranges. Clusters that don't fit are truncated
+        m_gridData.assign(sizeof(ClusterGridHeader) + ns_clusterCount * sizeof(uint32), 0);
+        auto grid = reinterpret_cast<uint32*>(m_gridData.data() + sizeof(ClusterGridHeader));
+
+        uint32 offset = 0;
+
+        for (unsigned int i = 0; i < ns_clusterCount; ++i)
+        {
+            const uint32 count = std::min(m_counts[i], maxIndices - offset);
+
+            grid[i] = (count << 24) | offset;
+            m_counts[i] = offset;
+            offset += count;
+        }
+
+        // Fill the index list, m_counts now holds the write position of each cluster
+        m_indexData.assign(getIndexVectors() * 4, 0);
+
+        for (uint32 i = 0; i < m_candidates.size(); ++i)
+        {
+            forEachCluster(m_candidates[i].min, m_candidates[i].max, [this, grid, i](const unsigned int cluster)
+            {
+                const uint32 end = (grid[cluster] & 0xFFFFFF) + (grid[cluster] >> 24);
+                auto& pos = m_counts[cluster];
+
+                if (pos < end)
+                {
+                    m_indexData[pos / 2] |= i << ((pos % 2) * 16);
+                    ++pos;
+                }
+            });
+        }
+
+        // Grid parameters
+        {
+            const glm::uvec2 mainSize = camera.getRenderTexture().isValid() ? camera.getRenderTexture().getSize() : mainTarget.getSize();
+            const auto p = glm::ivec2(camera.getViewport().first * glm::vec2(mainSize));
+            const auto s = glm::max(glm::ivec2(camera.getViewport().second * glm::vec2(mainSize)) - p, glm::ivec2(1));
+
+            auto& header = *reinterpret_cast<ClusterGridHeader*>(m_gridData.data());
+            header.viewport = glm::vec4(p.x, p.y, 1.f / s.x, 1.f / s.y);
+            header.depth = glm::vec4(depthScale, depthBias, 0.f, 0.f);
+        }
+
+        // Light data
+        m_lightData.assign(maxLights * sizeof(ClusteredLightBlock), 0);
+
+        for (std::size_t i = 0; i < m_candidates.size(); ++i)
+        {
+            auto& c = m_candidates[i];
+            auto& li = *c.light;
+            auto& block = reinterpret_cast<ClusteredLightBlock*>(m_lightData.data())[i];
+
+            const bool spot = li.getType() == LightSource::Type::Spot;
+            const glm::vec2 cutoff = spot ? glm::vec2(std::cos(li.getCutoff().x), std::cos(li.getCutoff().y)) : glm::vec2(0.f);
+
+            block.position      = glm::vec4(c.position, c.range);
+            block.direction     = glm::vec4(glm::normalize(glm::mat3(view) * li.getObject()->getGlobalFront()), spot ? 1.f : 0.f);
+            block.ambient       = glm::vec4(glm::vec3(li.getIntensity(LightSource::Intensity::Ambient).colors), cutoff.x);
+            block.diffuse       = glm::vec4(glm::vec3(li.getIntensity(LightSource::Intensity::Diffuse).colors), cutoff.y);
+            block.specular      = glm::vec4(glm::vec3(li.getIntensity(LightSource::Intensity::Specular).colors), 0.f);
+            block.attenuation   = glm::vec4(li.getAttenuation(), 0.f);
+        }
+
+        m_lightBlock.setData(m_lightData.data(), m_lightData.size());
+        m_gridBlock.setData(m_gridData.data(), m_gridData.size());
+        m_indexBlock.setData(m_indexData.data(), m_indexData.size() * sizeof(uint32));
+
+        m_lightBlock.bindBase(UniformBuffer::ClusterLightBlock);
+        m_gridBlock.bindBase(UniformBuffer::ClusterGridBlock);
+        m_indexBlock.bindBase(UniformBuffer::ClusterIndexBlock);
+
+        return static_cast<unsigned int>(m_candidates.size());
+    }
+
+    //////////////////////////////////////////////
+
+    bool LightClusterer::isEnabled()
+    {
+        static const bool enabled = LightContainer::usesUniformBlock() &&
+                                    getBlockSize() >= ns_clusterCount * sizeof(uint32) + sizeof(ClusterGridHeader) &&
+                                    SettingManager::get<bool>("engine@Graphics|Shading|bClusteredLights", true);
+
+        return enabled;
+    }
+
+    //////////////////////////////////////////////
+
+    bool LightClusterer::isClustered(const LightSource& light)
+    {
+        return light.getType() != LightSource::Type::Directional && !light.castsShadows();
+    }
+
+    //////////////////////////////////////////////
+
+    unsigned int LightClusterer::getMaximumLights()
+    {
+        static const unsigned int maxLights = std::max(1u, std::min
+        (
+            SettingManager::get<unsigned int>("engine@Graphics|Shading|uMaxClusteredLights", 256),
+            static_cast<unsigned int>(getBlockSize() / sizeof(ClusteredLightBlock))
+        ));
+
+        return maxLights;
+    }
+
+    //////////////////////////////////////////////
+
+    const std::string& LightClusterer::getShaderDefines()
+    {
+        static const std::string defines =
+            "#define JOP_CLUSTERED_LIGHTS\n"
+            "#define JOP_CLUSTER_X " + std::to_string(ns_clusterDims[0]) +
+            "\n#define JOP_CLUSTER_Y " + std::to_string(ns_clusterDims[1]) +
+            "\n#define JOP_CLUSTER_Z " + std::to_string(ns_clusterDims[2]) +
+            "\n#define JOP_MAX_CLUSTERED_LIGHTS " + std::to_string(getMaximumLights()) +
+            "\n#define JOP_CLUSTER_INDEX_VECS " + std::to_string(getIndexVectors()) + "\n";
+
+        return defines;
+    }
+}}
\ No newline at end of file
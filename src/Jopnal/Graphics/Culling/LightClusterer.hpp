@@ -0,0 +1,140 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+#ifndef JOP_LIGHTCLUSTERER_HPP
+#define JOP_LIGHTCLUSTERER_HPP
+
+// Headers
+#include <Jopnal/Header.hpp>
+#include <Jopnal/Graphics/UniformBuffer.hpp>
+#include <glm/vec3.hpp>
+#include <string>
+#include <vector>
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    class Camera;
+    class LightSource;
+    class RenderTarget;
+
+    namespace detail
+    {
+        /// \brief Clustered light binning
+        ///
+        /// Divides the view frustum of a camera into a grid of clusters, tiled
+        /// in screen space and sliced exponentially in depth. Point and spot
+        /// lights that don't cast shadows are binned into the clusters they
+        /// touch, and the light data, cluster grid & light index list are
+        /// uploaded into uniform blocks. The shaders then only iterate the lights
+        /// of the cluster the fragment is in.
+        ///
+        /// Lights are binned nearest first, so that when the light or index
+        /// capacity runs out, it's the farthest lights that get dropped.
+        ///
+        class LightClusterer final
+        {
+        private:
+
+            JOP_DISALLOW_COPY_MOVE(LightClusterer);
+
+        public:
+
+            /// \brief Constructor
+            ///
+            LightClusterer();
+
+
+            /// \brief Bin lights for a camera and upload the results
+            ///
+            /// Binds the cluster uniform blocks.
+            ///
+            /// \param camera The camera
+            /// \param mainTarget The main render target, used if the camera doesn't have a render texture
+            /// \param lights The lights to bin. Should only contain lights for which isClustered() returns true
+            ///
+            /// \return Amount of lights that were binned
+            ///
+            unsigned int build(const Camera& camera, const RenderTarget& mainTarget, const std::vector<const LightSource*>& lights);
+
+            /// \brief Check if clustered lighting is enabled
+            ///
+            /// Controlled by the setting engine@Graphics|Shading|bClusteredLights.
+            /// Always false if the light uniform block isn't used.
+            ///
+            /// \return True if enabled
+            ///
+            static bool isEnabled();
+
+            /// \brief Check if a light is handled by the clusters
+            ///
+            /// Shadow casting and directional lights are always passed using
+            /// LightContainer instead.
+            ///
+            /// \param light The light
+            ///
+            /// \return True if the light should be binned into the clusters
+            ///
+            static bool isClustered(const LightSource& light);
+
+            /// \brief Get the maximum amount of clustered lights per camera
+            ///
+            /// Read from engine@Graphics|Shading|uMaxClusteredLights and limited
+            /// by the maximum uniform block size.
+            ///
+            /// \return The maximum amount of lights
+            ///
+            static unsigned int getMaximumLights();
+
+            /// \brief Get the shader preprocessor definitions for clustered lighting
+            ///
+            /// \return The definitions
+            ///
+            static const std::string& getShaderDefines();
+
+        private:
+
+            struct Candidate
+            {
+                float distance;             ///< Distance from the camera to the light bounds
+                const LightSource* light;   ///< The light
+                glm::vec3 position;         ///< View space position
+                float range;                ///< Light range
+                unsigned int min[3];        ///< First cluster on each axis
+                unsigned int max[3];        ///< Last cluster on each axis
+            };
+
+
+            std::vector<Candidate> m_candidates;        ///< Lights inside the frustum, reused between calls
+            std::vector<uint32> m_counts;               ///< Light count of each cluster
+            std::vector<unsigned char> m_lightData;     ///< Light block data
+            std::vector<unsigned char> m_gridData;      ///< Cluster grid block data
+            std::vector<uint32> m_indexData;            ///< Light index block data
+            UniformBuffer m_lightBlock;                 ///< Light uniform block
+            UniformBuffer m_gridBlock;                  ///< Cluster grid uniform block
+            UniformBuffer m_indexBlock;                 ///< Light index uniform block
+        };
+    }
+}
+
+#endif
\ No newline at end of file
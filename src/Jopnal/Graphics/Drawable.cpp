@@ -34,9 +34,11 @@
     #include <Jopnal/Graphics/Renderer.hpp>
     #include <Jopnal/Graphics/ShaderProgram.hpp>
     #include <Jopnal/Graphics/ShaderAssembler.hpp>
+    #include <Jopnal/Graphics/UniformBuffer.hpp>
+    #include <Jopnal/Graphics/VertexBuffer.hpp>
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
-    #include <Jopnal/Graphics/Culling/CullerComponent.hpp>
+    #include <Jopnal/Graphics/Culling/FrustumCuller.hpp>
     #include <Jopnal/Utility/CommandHandler.hpp>
     #include <glm/gtc/type_ptr.hpp>
 
@@ -58,11 +60,53 @@ namespace jop
 namespace jop
 {
     Drawable::ProjectionInfo::ProjectionInfo(const glm::mat4& view, const glm::mat4& proj, const glm::vec3& camPos)
-        : viewMatrix        (view),
-          projectionMatrix  (proj),
-          cameraPosition    (camPos)
+        : viewMatrix            (view),
+          projectionMatrix      (proj),
+          cameraPosition        (camPos),
+          m_inverseViewMatrix   (nullptr),
+          m_inverseViewCache    ()
     {}
 
+    Drawable::ProjectionInfo::ProjectionInfo(const glm::mat4& view, const glm::mat4& proj, const glm::vec3& camPos, const glm::mat4& invView)
+        : viewMatrix            (view),
+          projectionMatrix      (proj),
+          cameraPosition        (camPos),
+          m_inverseViewMatrix   (&invView),
+          m_inverseViewCache    ()
+    {}
+
+    //////////////////////////////////////////////
+
+    void Drawable::ProjectionInfo::sendToBlock(UniformBuffer& buffer) const
+    {
+        // std140: two mat4s followed by a vec4
+        struct
+        {
+            glm::mat4 view;
+            glm::mat4 projection;
+            glm::vec4 position;
+
+        } block = {viewMatrix, projectionMatrix, glm::vec4(cameraPosition, 1.f)};
+
+        static_assert(sizeof(block) == 144, "Camera block doesn't match the std140 layout");
+
+        buffer.setData(&block, sizeof(block));
+        buffer.bindBase(UniformBuffer::CameraBlock);
+    }
+
+    //////////////////////////////////////////////
+
+    const glm::mat4& Drawable::ProjectionInfo::getInverseViewMatrix() const
+    {
+        if (!m_inverseViewMatrix)
+        {
+            m_inverseViewCache = glm::inverse(viewMatrix);
+            m_inverseViewMatrix = &m_inverseViewCache;
+        }
+
+        return *m_inverseViewMatrix;
+    }
+
     //////////////////////////////////////////////
 
     Drawable::Drawable(Object& object, Renderer& renderer, const bool cull)
@@ -75,7 +119,7 @@ namespace jop
           m_mesh            (),
           m_material        (),
           m_shader          (),
-          m_culler          (),
+          m_cullSlot        (NotCulled),
           m_attributes      (0),
           m_rendererRef     (renderer),
           m_pass            (pass),
@@ -84,10 +128,14 @@ namespace jop
           m_renderGroup     (0)
     {
         setModel(Mesh::getDefault(), Material::getDefault());
-        renderer.bind(this, pass, weight);
 
-        if (cull && detail::CullerComponent::cullingEnabled())
-            m_culler = std::make_unique<detail::CullerComponent>(object, renderer.getCullingWorld(), detail::CullerComponent::Type::Drawable, this);
+        object.runSerial([this, cull]()
+        {
+            m_rendererRef.bind(this, m_pass, m_weight);
+
+            if (cull && detail::FrustumCuller::cullingEnabled())
+                m_rendererRef.m_culler->add(*this);
+        });
     }
 
     Drawable::Drawable(const Drawable& other, Object& newObj)
@@ -96,35 +144,59 @@ namespace jop
           m_mesh            (other.m_mesh),
           m_material        (other.m_material),
           m_shader          (other.m_shader),
-          m_culler          (),
+          m_cullSlot        (NotCulled),
           m_rendererRef     (other.m_rendererRef),
           m_pass            (other.m_pass),
           m_weight          (other.m_weight),
           m_renderGroup     (other.m_renderGroup),
           m_flags           (other.m_flags)
     {
-        m_rendererRef.bind(this, m_pass, m_weight);
+        const bool cull = other.isCulled();
 
-        if (other.isCulled() && detail::CullerComponent::cullingEnabled())
-            m_culler = std::make_unique<detail::CullerComponent>(*other.m_culler, newObj, this);
+        newObj.runSerial([this, cull]()
+        {
+            m_rendererRef.bind(this, m_pass, m_weight);
+
+            if (cull)
+                m_rendererRef.m_culler->add(*this);
+        });
     }
 
     Drawable::~Drawable()
     {
+        if (isCulled())
+            m_rendererRef.m_culler->remove(*this);
+
         m_rendererRef.unbind(this, m_pass, m_weight);
     }
 
     //////////////////////////////////////////////
 
-    void Drawable::update(const float deltaTime)
+    void Drawable::draw(const ProjectionInfo& proj, const LightContainer& lights) const
+    {
+        if (m_mesh.expired())
+            return;
+
+        DrawMatrices matrices;
+        calculateMatrices(proj, matrices);
+
+        drawPrepared(proj, lights, matrices);
+    }
+
+    //////////////////////////////////////////////
+
+    void Drawable::calculateMatrices(const ProjectionInfo& proj, DrawMatrices& matrices) const
     {
-        if (m_culler)
-            m_culler->update(deltaTime);
+        matrices.viewModel = proj.viewMatrix * getObject()->getTransform().getMatrix();
+        matrices.projViewModel = proj.projectionMatrix * matrices.viewModel;
+
+        if (getMaterial() && (getMaterial()->getAttributes() & Material::LightingAttribs))
+            matrices.normal = glm::transpose(glm::inverse(glm::mat3(matrices.viewModel)));
     }
 
     //////////////////////////////////////////////
 
-    void Drawable::draw(const ProjectionInfo& proj, const LightContainer& lights) const
+    void Drawable::drawPrepared(const ProjectionInfo& proj, const LightContainer& lights, const DrawMatrices& matrices) const
     {
         if (m_mesh.expired())
             return;
@@ -132,11 +204,13 @@ namespace jop
         auto& mesh = *getMesh();
 
         {
+            static const UniformHandle pvmHandle("u_PVMMatrix");
+            static const UniformHandle vmHandle("u_VMMatrix");
+            static const UniformHandle nHandle("u_NMatrix");
+
             auto& shdr = getShader();
-            auto& modelMat = getObject()->getTransform().getMatrix();
-            const auto VMMatrix = proj.viewMatrix * modelMat;
 
-            shdr.setUniform("u_PVMMatrix", proj.projectionMatrix * VMMatrix);
+            shdr.setUniform(pvmHandle, matrices.projViewModel);
 
             if (!mesh.hasVertexComponent(Mesh::Color))
             {
@@ -150,9 +224,9 @@ namespace jop
                 auto& mat = *getMaterial();
                 if (mat.getAttributes() & Material::LightingAttribs)
                 {
-                    shdr.setUniform("u_VMMatrix", VMMatrix);
-                    shdr.setUniform("u_NMatrix", glm::transpose(glm::inverse(glm::mat3(VMMatrix))));
-                    lights.sendToShader(shdr, *this, proj.viewMatrix);
+                    shdr.setUniform(vmHandle, matrices.viewModel);
+                    shdr.setUniform(nHandle, matrices.normal);
+                    lights.sendToShader(shdr, *this, proj);
                 }
 
                 mat.sendToShader(shdr);
@@ -168,6 +242,61 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    void Drawable::drawInstanced(const ProjectionInfo& proj, const LightContainer& lights, const std::vector<const Drawable*>& drawables, VertexBuffer& instanceBuffer)
+    {
+        if (drawables.empty() || drawables.front()->m_mesh.expired() || !drawables.front()->getMaterial())
+            return;
+
+        auto& first = *drawables.front();
+        auto& mesh = *first.getMesh();
+        auto& mat = *first.getMaterial();
+
+        struct InstanceData
+        {
+            glm::mat4 modelMatrix;
+            glm::vec4 color;
+        };
+
+        static std::vector<InstanceData> instances;
+        instances.resize(drawables.size());
+
+        for (std::size_t i = 0; i < drawables.size(); ++i)
+        {
+            instances[i].modelMatrix = drawables[i]->getObject()->getTransform().getMatrix();
+            instances[i].color = glm::vec4(drawables[i]->getColor().colors, drawables[i]->getColor().alpha);
+        }
+
+        instanceBuffer.setData(instances.data(), instances.size() * sizeof(InstanceData));
+
+        {
+            static const UniformHandle vHandle("u_VMatrix");
+            static const UniformHandle pHandle("u_PMatrix");
+
+            auto& shdr = ShaderAssembler::getShader(mat.getAttributes(), first.getAttributes() | Attribute::__Instanced);
+
+            // With uniform buffers the matrices come from jop_CameraBlock, uploaded once per camera
+            if (!UniformBuffer::isSupported())
+            {
+                shdr.setUniform(vHandle, proj.viewMatrix);
+                shdr.setUniform(pHandle, proj.projectionMatrix);
+            }
+
+            if (mat.getAttributes() & Material::LightingAttribs)
+                lights.sendToShader(shdr, first, proj);
+
+            mat.sendToShader(shdr);
+
+            static const DynamicSetting<bool> validateSetting("engine@Debug|bValidateShaders", false);
+
+            if (validateSetting.value && !shdr.validate())
+                return;
+        }
+
+        mesh.drawInstanced(static_cast<unsigned int>(drawables.size()), instanceBuffer);
+    }
+
+    //////////////////////////////////////////////
+
     Renderer& Drawable::getRendrer()
     {
         return m_rendererRef;
@@ -208,12 +337,6 @@ namespace jop
     {
         m_mesh = static_ref_cast<const Mesh>(mesh.getReference());
 
-        if (m_culler)
-        {
-            m_culler->setCollisionShape(mesh.getCullingShape());
-            m_culler->updateWorldBounds();
-        }
-
         return *this;
     }
 
@@ -314,14 +437,14 @@ namespace jop
 
     bool Drawable::isCulled() const
     {
-        return m_culler.operator bool();
+        return m_cullSlot != NotCulled;
     }
 
     //////////////////////////////////////////////
 
     Message::Result Drawable::receiveMessage(const Message& message)
     {
-        if (JOP_EXECUTE_COMMAND(Drawable, message.getString(), this) == Message::Result::Escape)
+        if (JOP_EXECUTE_COMMAND(Drawable, message, this) == Message::Result::Escape)
             return Message::Result::Escape;
 
         return Component::receiveMessage(message);
@@ -367,6 +490,14 @@ namespace jop
         if (attributes & Attribute::__SkySphere)
             str += "#define JDRW_SKYSPHERE\n";
 
+        if (attributes & Attribute::__Instanced)
+        {
+            str += "#define JDRW_INSTANCED\n";
+
+            if (UniformBuffer::isSupported())
+                str += "#define JOP_CAMERA_BLOCK\n";
+        }
+
         return str;
     }
 }
\ No newline at end of file
@@ -31,19 +31,26 @@
     #include <Jopnal/Core/SettingManager.hpp>
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlState.hpp>
+    #include <Jopnal/Graphics/Camera.hpp>
     #include <Jopnal/Graphics/Drawable.hpp>
     #include <Jopnal/Graphics/Texture/Texture.hpp>
+    #include <Jopnal/Graphics/Texture/Texture2D.hpp>
     #include <Jopnal/Graphics/Mesh/Mesh.hpp>
     #include <Jopnal/Graphics/Renderer.hpp>
     #include <Jopnal/Graphics/ShaderAssembler.hpp>
     #include <Jopnal/Graphics/ShaderProgram.hpp>
     #include <Jopnal/Graphics/Material.hpp>
+    #include <Jopnal/Graphics/UniformBuffer.hpp>
     #include <Jopnal/Utility/Assert.hpp>
     #include <Jopnal/Utility/CommandHandler.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
     #include <glm/mat4x4.hpp>
+    #include <glm/matrix.hpp>
     #include <glm/gtc/matrix_transform.hpp>
     #include <glm/gtc/type_ptr.hpp>
+    #include <cmath>
+    #include <cstring>
 
 #endif
 
@@ -76,6 +83,175 @@ namespace
 
         return intensities;
     }
+
+    // CPU side mirrors of the std140 structures in jop_LightBlock.
+    // The order of the members must match structures.jops
+
+    struct PointLightBlock
+    {
+        glm::vec3 position;
+        jop::int32 enabled;
+
+        glm::vec3 ambient;
+        jop::int32 castShadow;
+
+        glm::vec3 diffuse;
+        float farPlane;
+
+        glm::vec3 specular;
+        float pad0;
+
+        glm::vec3 attenuation;
+        float pad1;
+    };
+    static_assert(sizeof(PointLightBlock) == 80, "PointLightBlock doesn't match the std140 layout");
+
+    struct SpotLightBlock
+    {
+        glm::mat4 lsMatrix;
+
+        glm::vec3 position;
+        jop::int32 enabled;
+
+        glm::vec3 direction;
+        jop::int32 castShadow;
+
+        glm::vec3 ambient;
+        float pad0;
+        glm::vec3 diffuse;
+        float pad1;
+        glm::vec3 specular;
+        float pad2;
+        glm::vec3 attenuation;
+        float pad3;
+
+        glm::vec2 cutoff;
+        float pad4[2];
+    };
+    static_assert(sizeof(SpotLightBlock) == 176, "SpotLightBlock doesn't match the std140 layout");
+
+    // Must match JOP_MAX_SHADOW_CASCADES in structures.jops
+    const unsigned int ns_maxShadowCascades = 4;
+
+    struct DirectionalLightBlock
+    {
+        glm::mat4 lsMatrices[ns_maxShadowCascades];
+        glm::vec4 cascadeSplits;
+
+        glm::vec3 direction;
+        jop::int32 enabled;
+
+        glm::vec3 ambient;
+        jop::int32 castShadow;
+
+        glm::vec3 diffuse;
+        jop::int32 cascades;
+
+        glm::vec3 specular;
+        float pad0;
+    };
+    static_assert(sizeof(DirectionalLightBlock) == 336, "DirectionalLightBlock doesn't match the std140 layout");
+
+    // Light counts, padded to the base alignment of the light arrays
+    const std::size_t ns_lightBlockHeaderSize = 16;
+
+    // Depth record shader variants
+    enum RecordShader
+    {
+        ClipDepth,      ///< Directional & spot lights
+        LinearDepth,    ///< Point lights, one face at a time
+        LayeredDepth    ///< Point lights, all faces in a single pass
+    };
+
+    jop::ShaderProgram& getRecordShader(const RecordShader variant)
+    {
+        using namespace jop;
+
+        static WeakReference<ShaderProgram> shaders[3];
+        auto& shader = shaders[variant];
+
+        if (shader.expired())
+        {
+            static const char* const names[] =
+            {
+                "jop_depth_record_shader",
+                "jop_depth_record_shader_linear",
+                "jop_depth_record_shader_layered"
+            };
+
+            shader = static_ref_cast<ShaderProgram>(ResourceManager::getEmpty<ShaderProgram>(names[variant]).getReference());
+            shader->setPersistence(0);
+
+            const bool depthTextureSupport =
+            #if defined(JOP_OPENGL_ES) && JOP_MIN_OPENGL_ES_VERSION < 300
+                gl::getVersionMajor() >= 3 || JOP_CHECK_GL_EXTENSION(OES_depth_texture);
+            #else
+                true;
+            #endif
+
+            std::string pp(depthTextureSupport ? "" : "#define JOP_PACK_DEPTH\n");
+
+            if (variant != ClipDepth)
+                pp += "#define JOP_LINEAR_DEPTH\n";
+
+            if (variant == LayeredDepth)
+                pp += "#define JOP_LAYERED\n";
+
+            JOP_ASSERT_EVAL(shader->load(pp,
+                Shader::Type::Vertex, std::string(reinterpret_cast<const char*>(jopr::depthRecordShaderVert), sizeof(jopr::depthRecordShaderVert)),
+                Shader::Type::Geometry, variant == LayeredDepth ? std::string(reinterpret_cast<const char*>(jopr::depthRecordShaderGeom), sizeof(jopr::depthRecordShaderGeom)) : std::string(),
+                Shader::Type::Fragment, std::string(reinterpret_cast<const char*>(jopr::depthRecordShaderFrag), sizeof(jopr::depthRecordShaderFrag))),
+                "Failed to compile depth record shader!");
+        }
+
+        return *shader;
+    }
+
+    // Frustum planes of a projection-view matrix. The planes aren't normalized
+    typedef std::array<glm::vec4, 6> FrustumPlanes;
+
+    FrustumPlanes extractPlanes(const glm::mat4& pv)
+    {
+        const glm::mat4 rows(glm::transpose(pv));
+
+        return FrustumPlanes
+        {{
+            rows[3] + rows[0], rows[3] - rows[0],
+            rows[3] + rows[1], rows[3] - rows[1],
+            rows[3] + rows[2], rows[3] - rows[2]
+        }};
+    }
+
+    bool boundsInFrustum(const FrustumPlanes& planes, const std::pair<glm::vec3, glm::vec3>& bounds)
+    {
+        for (auto& p : planes)
+        {
+            // The corner furthest along the plane normal
+            const glm::vec3 corner
+            (
+                p.x >= 0.f ? bounds.second.x : bounds.first.x,
+                p.y >= 0.f ? bounds.second.y : bounds.first.y,
+                p.z >= 0.f ? bounds.second.z : bounds.first.z
+            );
+
+            if (glm::dot(glm::vec3(p), corner) + p.w < 0.f)
+                return false;
+        }
+
+        return true;
+    }
+
+    // 64-bit FNV-1a
+    void hashBytes(jop::uint64& hash, const void* data, const std::size_t size)
+    {
+        auto bytes = static_cast<const unsigned char*>(data);
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    }
 }
 
 namespace jop
@@ -83,6 +259,8 @@ namespace jop
     LightSource::LightSource(Object& object, Renderer& renderer, const Type type)
         : Component             (object, 0),
           m_lightSpaceMatrices  (),
+          m_cascadeSplits       (0.f),
+          m_casterHash          (0),
           m_type                (type),
           m_intensities         (getDefaultIntensities()),
           m_attenuation         (1.f, 1.f, 2.f),
@@ -91,12 +269,14 @@ namespace jop
           m_renderMask          (1),
           m_shadowMap           ()
     {
-        renderer.bind(this);
+        object.runSerial([this]() { m_rendererRef.bind(this); });
     }
 
     LightSource::LightSource(const LightSource& other, Object& newObj)
         : Component             (other, newObj),
           m_lightSpaceMatrices  (),
+          m_cascadeSplits       (0.f),
+          m_casterHash          (0),
           m_type                (other.m_type),
           m_intensities         (other.m_intensities),
           m_attenuation         (other.m_attenuation),
@@ -106,7 +286,7 @@ namespace jop
           m_shadowMap           ()
     {
         setCastShadows(other.castsShadows());
-        m_rendererRef.bind(this);
+        newObj.runSerial([this]() { m_rendererRef.bind(this); });
     }
 
     LightSource::~LightSource()
@@ -137,17 +317,22 @@ namespace jop
 
     //////////////////////////////////////////////
 
-    LightSource& LightSource::setCastShadows(const bool castShadows, const glm::uvec2& /*resolution*/)
+    LightSource& LightSource::setCastShadows(const bool castShadows, const glm::uvec2& resolution)
     {
         if (castsShadows() != castShadows)
-        {/*
+        {
             if (castShadows)
             {
                 static const unsigned int defMapSize = SettingManager::get<unsigned int>("engine@Graphics|Shading|uDefaultShadowMapResolution", 512);
-                const glm::uvec2 realSize = glm::min(glm::uvec2(m_type == Type::Point ? Cubemap::getMaximumSize() : Texture2D::getMaximumSize()),
-                                                    (resolution == glm::uvec2(0) ? glm::uvec2(defMapSize) : resolution));
+                static const unsigned int cascades = glm::clamp(SettingManager::get<unsigned int>("engine@Graphics|Shading|uShadowCascades", 3), 1u, ns_maxShadowCascades);
+
+                // Directional light cascades are laid out side by side
+                const unsigned int mapCount = m_type == Type::Directional ? cascades : 1;
 
-                m_shadowMap.setSize(realSize);
+                const glm::uvec2 maxSize(m_type == Type::Point ? Cubemap::getMaximumSize() : Texture2D::getMaximumSize());
+                const glm::uvec2 realSize = glm::min(maxSize / glm::uvec2(mapCount, 1), (resolution == glm::uvec2(0) ? glm::uvec2(defMapSize) : resolution));
+
+                m_shadowMap.setSize(realSize * glm::uvec2(mapCount, 1));
                 bool packed = false;
 
                 using Slot = RenderTexture::Slot;
@@ -155,27 +340,34 @@ namespace jop
                 if (m_type == Type::Point)
                 {
                     if (!m_shadowMap.addCubemapAttachment(Slot::Depth, Texture::Format::Depth_US_16))
-                        m_shadowMap.addCubemapAttachment(Slot::Color0, Texture::Format::RGBA_UB_8);
+                        packed = m_shadowMap.addCubemapAttachment(Slot::Color0, Texture::Format::RGBA_UB_8);
                 }
                 else
                 {
                     if (!m_shadowMap.addTextureAttachment(Slot::Depth, Texture::Format::Depth_US_16))
-                        m_shadowMap.addTextureAttachment(Slot::Color0, Texture::Format::RGBA_UB_8);
+                        packed = m_shadowMap.addTextureAttachment(Slot::Color0, Texture::Format::RGBA_UB_8);
                 }
 
-                m_shadowMap.getTextureAttachment(packed ? Slot::Color0 : Slot::Depth)
-                    ->setFilterMode(TextureSampler::Filter::Bilinear)
-                     .setRepeatMode(TextureSampler::Repeat::ClampBorder)
-                     .setBorderColor(Color::White);
+                auto tex = m_shadowMap.getTextureAttachment(packed ? Slot::Color0 : Slot::Depth);
+
+                if (tex)
+                {
+                    tex->setFilterMode(TextureSampler::Filter::Bilinear)
+                        .setRepeatMode(TextureSampler::Repeat::ClampBorder)
+                        .setBorderColor(Color::White);
+                }
                 
-                m_lightSpaceMatrices.resize(1 + (m_type == Type::Point) * 5);
+                m_lightSpaceMatrices.resize(m_type == Type::Point ? 6 : mapCount);
             }
             else
             {
                 m_shadowMap.destroy(true, true);
                 m_lightSpaceMatrices.clear();
                 m_lightSpaceMatrices.shrink_to_fit();
-            }*/
+            }
+
+            m_cascadeSplits = glm::vec4(0.f);
+            m_casterHash = 0;
         }
 
         return *this;
@@ -203,110 +395,269 @@ namespace jop
 
     //////////////////////////////////////////////
 
-    bool LightSource::drawShadowMap() const
+    unsigned int LightSource::getShadowCascades() const
+    {
+        return m_type == Type::Directional ? static_cast<unsigned int>(m_lightSpaceMatrices.size()) : 0;
+    }
+
+    //////////////////////////////////////////////
+
+    const glm::vec4& LightSource::getCascadeSplits() const
+    {
+        return m_cascadeSplits;
+    }
+
+    //////////////////////////////////////////////
+
+    bool LightSource::drawShadowMap(const std::set<const Drawable*>& drawables, const Camera* camera) const
     {
         if (!castsShadows() || !isActive() || !getRenderMask())
             return false;
 
-        static WeakReference<ShaderProgram> recordShader;
+        const glm::vec3 pos = getObject()->getGlobalPosition();
 
-        // Shadow map recorder shader
-        if (recordShader.expired())
+        // Point lights store linear depth, this is the distance it's divided by
+        const float farPlane = getRange() * 10.f;
+
+        // Update the light space matrices
+        if (m_type == Type::Point)
         {
-            recordShader = static_ref_cast<ShaderProgram>(ResourceManager::getEmpty<ShaderProgram>("jop_depth_record_shader").getReference());
-            recordShader->setPersistence(0);
+            makeCubemapMatrices(glm::perspective(glm::half_pi<float>(), 1.f, 0.1f, farPlane), pos, m_lightSpaceMatrices);
+        }
+        else if (m_type == Type::Spot)
+        {
+            const glm::vec2 s(m_shadowMap.getSize());
+            const glm::vec3 front = glm::normalize(getObject()->getGlobalFront());
 
-            const bool depthTextureSupport =
-            #if defined(JOP_OPENGL_ES) && JOP_MIN_OPENGL_ES_VERSION < 300
-                gl::getVersionMajor() >= 3 || JOP_CHECK_GL_EXTENSION(OES_depth_texture);
-            #else
-                true;
-            #endif
+            m_lightSpaceMatrices[0] = glm::perspective(getCutoff().y * 2.f, s.x / s.y, 0.1f, getRange()) * glm::lookAt(pos, pos + front, glm::normalize(getObject()->getGlobalUp()));
+        }
+        else
+        {
+            // The cascades need a camera to be fitted to
+            if (!camera)
+                return false;
 
-            JOP_ASSERT_EVAL(recordShader->load(depthTextureSupport ? "" : "#define JOP_PACK_DEPTH\n",
-                Shader::Type::Vertex, std::string(reinterpret_cast<const char*>(jopr::depthRecordShaderVert), sizeof(jopr::depthRecordShaderVert)),
-                Shader::Type::Fragment, std::string(reinterpret_cast<const char*>(jopr::depthRecordShaderFrag), sizeof(jopr::depthRecordShaderFrag))),
-                "Failed to compile depth record shader!");
+            fitShadowCascades(*camera);
         }
 
-        if (!m_shadowMap.bind() || !recordShader->bind())
-            return false;
+        // Find the shadow casters touching each light space frustum. One bit per frustum
+        static std::vector<std::pair<const Drawable*, uint32>> casters;
+        casters.clear();
 
-        m_shadowMap.clear(RenderTarget::DepthBit);
-        /*
-        if (getType() == Type::Point)
+        static std::vector<FrustumPlanes> frustums;
+        frustums.clear();
+
+        for (auto& i : m_lightSpaceMatrices)
+            frustums.push_back(extractPlanes(i));
+
+        uint64 hash = 14695981039346656037ull;
+        hashBytes(hash, m_lightSpaceMatrices.data(), m_lightSpaceMatrices.size() * sizeof(glm::mat4));
+
+        for (auto d : drawables)
         {
-            auto pos = getObject()->getGlobalPosition();
+            if (!d->isActive() || !d->hasFlag(Drawable::CastShadows) || !d->getMesh() || (getRenderMask() & (1 << d->getRenderGroup())) == 0)
+                continue;
 
-            const float range = getRange() * 10.f;
+            const auto bounds = d->getGlobalBounds();
+            uint32 mask = 0;
 
-            const glm::mat4 proj = glm::perspective(glm::half_pi<float>(), 1.f, 0.1f, range);
+            for (std::size_t i = 0; i < frustums.size(); ++i)
+                mask |= static_cast<uint32>(boundsInFrustum(frustums[i], bounds)) << i;
 
-            makeCubemapMatrices(proj, pos, m_lightSpaceMatrices);
+            if (!mask)
+                continue;
+
+            casters.emplace_back(d, mask);
 
-            recordShader->setUniform("u_PVMatrices", glm::value_ptr(m_lightSpaceMatrices[0]), 6);
-            recordShader->setUniform("u_FarClippingPlane", range);
-            recordShader->setUniform("u_LightPosition", pos);
+            // Static casters produce the same hash every frame
+            const void* mesh = d->getMesh();
+            hashBytes(hash, &d, sizeof(d));
+            hashBytes(hash, &mesh, sizeof(mesh));
+            hashBytes(hash, &mask, sizeof(mask));
+            hashBytes(hash, &d->getObject()->getTransform().getMatrix(), sizeof(glm::mat4));
         }
-        else
-        {
-            // Use the object's scale to construct the frustum
-            auto scl = getObject()->getLocalScale();
 
-            // We need scale at 1 to avoid messing up the view transform
-            glm::mat4 trans(getObject()->getInverseTransform().getMatrix());
-            trans[0] = glm::normalize(trans[0]);
-            trans[1] = glm::normalize(trans[1]);
-            trans[2] = glm::normalize(trans[2]);
+        // Nothing has changed since the last time, the old shadow map is still valid
+        if (hash == m_casterHash)
+            return false;
+
+        m_casterHash = hash;
+
+        using Slot = RenderTexture::Slot;
 
-            if (getType() == Type::Directional)
+        const Slot slot = m_shadowMap.getTextureAttachment(Slot::Depth) ? Slot::Depth : Slot::Color0;
+        const unsigned int clearBits = RenderTarget::DepthBit | (slot == Slot::Color0 ? RenderTarget::ColorBit : 0);
+
+        GlState::setDepthTest(true);
+        GlState::setDepthWrite(true);
+        GlState::setBlendFunc(false);
+
+        static const UniformHandle pvMatrixHandle("u_PVMatrix");
+        static const UniformHandle pvMatricesHandle("u_PVMatrices");
+        static const UniformHandle mMatrixHandle("u_MMatrix");
+        static const UniformHandle farPlaneHandle("u_FarClippingPlane");
+        static const UniformHandle lightPositionHandle("u_LightPosition");
+
+        auto drawCasters = [](ShaderProgram& shader, const uint32 mask)
+        {
+            for (auto& i : casters)
             {
-                m_lightSpaceMatrices[0] = glm::ortho(scl.x * -0.5f, scl.x * 0.5f, scl.y * -0.5f, scl.y * 0.5f, 0.f, scl.z) * trans;
-                recordShader->setUniform("u_PVMatrix", m_lightSpaceMatrices[0]);
+                if ((i.second & mask) == 0)
+                    continue;
+
+                shader.setUniform(mMatrixHandle, i.first->getObject()->getTransform().getMatrix());
+                i.first->getMesh()->draw();
             }
-            else
+        };
+
+        if (m_type == Type::Point)
+        {
+            const bool layered = slot == Slot::Depth && RenderTexture::isLayeredSupported();
+            auto& shader = getRecordShader(layered ? LayeredDepth : LinearDepth);
+
+            if (!shader.bind())
+                return false;
+
+            shader.setUniform(farPlaneHandle, farPlane);
+            shader.setUniform(lightPositionHandle, pos);
+
+            if (layered && m_shadowMap.bindLayered(slot))
             {
-                auto s = glm::vec2(m_shadowMap.getSize());
-                m_lightSpaceMatrices[0] = glm::perspective(getCutoff().y * 2.f, s.x / s.y, 0.5f, getRange()) * trans;
+                // Every face is rendered in a single pass by the geometry shader
+                shader.setUniform(pvMatricesHandle, glm::value_ptr(m_lightSpaceMatrices[0]), 6);
 
-                recordShader->setUniform("u_PVMatrix", m_lightSpaceMatrices[0]);
+                m_shadowMap.clear(clearBits);
+                drawCasters(shader, 0x3F);
             }
-        }*/
+            else
+            {
+                for (int i = 0; i < 6; ++i)
+                {
+                    if (!m_shadowMap.bindCubeFace(slot, static_cast<Cubemap::Face>(i)))
+                        return false;
 
-        bool drawn = false;
+                    shader.setUniform(pvMatrixHandle, m_lightSpaceMatrices[i]);
 
-        /*for (auto d : drawables)
+                    m_shadowMap.clear(clearBits);
+                    drawCasters(shader, 1 << i);
+                }
+            }
+        }
+        else
         {
-            if (!d->isActive() || !d->castShadows() || (getRenderMask() & (1 << d->getRenderGroup())) == 0 || !d->lightTouches(*this))
-                continue;
+            auto& shader = getRecordShader(ClipDepth);
 
-            drawn = true;
+            if (!m_shadowMap.bind() || !shader.bind())
+                return false;
 
-            auto& mesh = *d->getModel().getMesh();
-            mesh.getVertexBuffer().bind();
+            m_shadowMap.clear(clearBits);
 
-            shdr.setAttribute("a_Position", 0, GL_FLOAT, 3, mesh.getVertexSize(), mesh.getVertexOffset(Mesh::Position));
-            shdr.setUniform("u_MMatrix", d->getObject()->getTransform().getMatrix());
+            // Directional light cascades are rendered side by side
+            const glm::uvec2 size(m_shadowMap.getSize().x / m_lightSpaceMatrices.size(), m_shadowMap.getSize().y);
 
-            if (mesh.getElementAmount())
+            for (std::size_t i = 0; i < m_lightSpaceMatrices.size(); ++i)
             {
-                mesh.getIndexBuffer().bind();
-                glCheck(glDrawElements(GL_TRIANGLES, mesh.getElementAmount(), mesh.getElementEnum(), (void*)0));
+                glCheck(glViewport(static_cast<GLint>(size.x * i), 0, size.x, size.y));
+
+                shader.setUniform(pvMatrixHandle, m_lightSpaceMatrices[i]);
+                drawCasters(shader, 1 << i);
             }
-            else
+        }
+
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
+    void LightSource::fitShadowCascades(const Camera& camera) const
+    {
+        static const float shadowDistance = SettingManager::get<float>("engine@Graphics|Shading|fShadowDistance", 100.f);
+        static const float splitLambda = glm::clamp(SettingManager::get<float>("engine@Graphics|Shading|fCascadeSplitLambda", 0.75f), 0.f, 1.f);
+
+        const auto& planes = camera.getClippingPlanes();
+        const float clipNear = std::max(planes.first, 0.01f);
+        const float clipFar = std::max(clipNear + 0.01f, std::min(planes.second, shadowDistance));
+        const float clipRange = std::max(planes.second - planes.first, FLT_MIN);
+
+        // Corners of the whole view frustum
+        const glm::mat4 invPV(glm::inverse(camera.getProjectionMatrix() * camera.getViewMatrix()));
+        glm::vec3 nearCorners[4], farCorners[4];
+
+        for (int i = 0; i < 4; ++i)
+        {
+            const glm::vec2 ndc((i & 1) ? 1.f : -1.f, (i & 2) ? 1.f : -1.f);
+
+            const glm::vec4 n = invPV * glm::vec4(ndc, -1.f, 1.f);
+            const glm::vec4 f = invPV * glm::vec4(ndc, 1.f, 1.f);
+
+            nearCorners[i] = glm::vec3(n) / n.w;
+            farCorners[i] = glm::vec3(f) / f.w;
+        }
+
+        const glm::vec3 dir = glm::normalize(getObject()->getGlobalFront());
+        const glm::mat4 lightView = glm::lookAt(glm::vec3(0.f), dir, std::abs(dir.y) > 0.99f ? glm::vec3(0.f, 0.f, 1.f) : glm::vec3(0.f, 1.f, 0.f));
+
+        const float resolution = static_cast<float>(m_shadowMap.getSize().y);
+        const std::size_t cascades = m_lightSpaceMatrices.size();
+
+        float splitNear = clipNear;
+        m_cascadeSplits = glm::vec4(clipFar);
+
+        for (std::size_t c = 0; c < cascades; ++c)
+        {
+            // Blend between logarithmic and uniform splits
+            const float p = static_cast<float>(c + 1) / cascades;
+            const float splitFar = glm::mix(clipNear + (clipFar - clipNear) * p, clipNear * std::pow(clipFar / clipNear, p), splitLambda);
+
+            m_cascadeSplits[c] = splitFar;
+
+            // Bounding sphere of the frustum slice. The sphere doesn't change
+            // size when the camera rotates, which keeps the shadows stable
+            const float tNear = (splitNear - planes.first) / clipRange;
+            const float tFar = (splitFar - planes.first) / clipRange;
+
+            glm::vec3 corners[8];
+            glm::vec3 center(0.f);
+
+            for (int i = 0; i < 4; ++i)
             {
-                glCheck(glDrawArrays(GL_TRIANGLES, 0, mesh.getVertexAmount()));
+                corners[i] = glm::mix(nearCorners[i], farCorners[i], tNear);
+                corners[i + 4] = glm::mix(nearCorners[i], farCorners[i], tFar);
+
+                center += corners[i] + corners[i + 4];
             }
-        }*/
 
-        return drawn;
+            center /= 8.f;
+
+            float radius = 0.f;
+
+            for (auto& i : corners)
+                radius = std::max(radius, glm::length(i - center));
+
+            radius = std::ceil(radius * 16.f) / 16.f;
+
+            // Snap to whole texels to avoid shimmering when the camera moves
+            const float texel = radius * 2.f / resolution;
+            glm::vec3 lsCenter(lightView * glm::vec4(center, 1.f));
+            lsCenter = glm::floor(lsCenter / texel) * texel;
+
+            // Casters between the light and the slice are included by extending the near plane
+            m_lightSpaceMatrices[c] = glm::ortho(lsCenter.x - radius, lsCenter.x + radius,
+                                                 lsCenter.y - radius, lsCenter.y + radius,
+                                                -lsCenter.z - radius * 3.f, -lsCenter.z + radius) * lightView;
+
+            splitNear = splitFar;
+        }
     }
 
     //////////////////////////////////////////////
 
     const Texture* LightSource::getShadowMap() const
     {
-        return m_shadowMap.getTextureAttachment(RenderTexture::Slot::Depth);
+        auto map = m_shadowMap.getTextureAttachment(RenderTexture::Slot::Depth);
+
+        // Depth packed into a color texture
+        return map ? map : m_shadowMap.getTextureAttachment(RenderTexture::Slot::Color0);
     }
 
     ///////////////////////////////////////////
@@ -441,6 +792,13 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    unsigned int LightSource::getMaximumShadowCascades()
+    {
+        return ns_maxShadowCascades;
+    }
+
+    //////////////////////////////////////////////
+
     void LightSource::makeCubemapMatrices(const glm::mat4& projection, const glm::vec3& position, std::vector<glm::mat4>& viewMats)
     {
         viewMats[0] = projection * glm::lookAt(position, position + glm::vec3( 1.0,  0.0,  0.0), glm::vec3(0.0, -1.0,  0.0)); // Right
@@ -455,7 +813,7 @@ namespace jop
 
     Message::Result LightSource::receiveMessage(const Message& message)
     {
-        if (JOP_EXECUTE_COMMAND(LightSource, message.getString(), this) == Message::Result::Escape)
+        if (JOP_EXECUTE_COMMAND(LightSource, message, this) == Message::Result::Escape)
             return Message::Result::Escape;
 
         return Component::receiveMessage(message);
@@ -492,12 +850,24 @@ namespace jop
 
     //////////////////////////////////////////////
 
-    void LightContainer::sendToShader(ShaderProgram& shader, const Drawable& drawable, const glm::mat4& viewMatrix) const
+    void LightContainer::sendToShader(ShaderProgram& shader, const Drawable& drawable, const Drawable::ProjectionInfo& proj) const
     {
+        const glm::mat4& viewMatrix = proj.viewMatrix;
+
         const bool receiveLights = drawable.hasFlag(Drawable::ReceiveLights);
         const bool receiveShadows = drawable.hasFlag(Drawable::ReceiveShadows);
 
-        shader.setUniform("u_ReceiveLights", receiveLights);
+        static const UniformHandle receiveLightsHandle("u_ReceiveLights");
+        static const UniformHandle receiveShadowsHandle("u_ReceiveShadows");
+        static const UniformHandle invViewRotationHandle("u_InvViewRotation");
+        static const UniformHandle numLightsHandles[] =
+        {
+            UniformHandle("u_NumPointLights"),
+            UniformHandle("u_NumSpotLights"),
+            UniformHandle("u_NumDirectionalLights")
+        };
+
+        shader.setUniform(receiveLightsHandle, receiveLights);
 
     #if defined(JOP_OPENGL_ES) && JOP_MIN_OPENGL_ES_VERSION < 300
         if (gl::getGLSLVersion() >= 300)
@@ -511,7 +881,11 @@ namespace jop
         const bool shadows = (drawable.getMaterial()->getAttributes() & Material::FragLightingAttribs) != 0;
         
         if (shadows)
-            shader.setUniform("u_ReceiveShadows", receiveShadows);
+            shader.setUniform(receiveShadowsHandle, receiveShadows);
+
+        // The shadow map matrices transform from world space, while the shaders work in view space
+        if (receiveShadows && shadows && !(*this)[LightSource::Type::Point].empty())
+            shader.setUniform(invViewRotationHandle, glm::mat3(proj.getInverseViewMatrix()));
 
         typedef LightSource LS;
 
@@ -521,19 +895,19 @@ namespace jop
         static const unsigned int dirSpotShadowStartUnit = pointShadowStartUnit + LS::getMaximumLights(LS::Type::Point);
         unsigned int currentDirSpotShadowUnit = dirSpotShadowStartUnit;
         
-        static std::array<std::vector<std::vector<std::string>>, 3> strCache;
+        static std::array<std::vector<std::vector<UniformHandle>>, 3> handleCache;
         static bool cacheInit = false;
 
         if (!cacheInit)
         {
-            strCache[0].resize(LS::getMaximumLights(LS::Type::Point));
-            strCache[1].resize(LS::getMaximumLights(LS::Type::Spot));
-            strCache[2].resize(LS::getMaximumLights(LS::Type::Directional));
+            handleCache[0].resize(LS::getMaximumLights(LS::Type::Point));
+            handleCache[1].resize(LS::getMaximumLights(LS::Type::Spot));
+            handleCache[2].resize(LS::getMaximumLights(LS::Type::Directional));
 
             for (std::size_t i = 0; i < LS::getMaximumLights(LS::Type::Point); ++i)
             {
-                auto& cache = strCache[static_cast<int>(LS::Type::Point)][i];
-                cache.reserve(8);
+                auto& cache = handleCache[static_cast<int>(LS::Type::Point)][i];
+                cache.reserve(9);
                 const std::string indexed = "u_PointLights[" + std::to_string(i) + "].";
 
                 /* 0 */ cache.emplace_back(indexed + "position");
@@ -547,12 +921,14 @@ namespace jop
                 /* 5 */ cache.emplace_back(indexed + "castShadow");
                 /* 6 */ cache.emplace_back("u_PointLightShadowMaps[" + std::to_string(i) + "]");
                 /* 7 */ cache.emplace_back(indexed + "farPlane");
+
+                /* 8 */ cache.emplace_back(indexed + "enabled");
             }
 
             for (std::size_t i = 0; i < LS::getMaximumLights(LS::Type::Spot); ++i)
             {
-                auto& cache = strCache[static_cast<int>(LS::Type::Spot)][i];
-                cache.reserve(10);
+                auto& cache = handleCache[static_cast<int>(LS::Type::Spot)][i];
+                cache.reserve(11);
                 const std::string indexed = "u_SpotLights[" + std::to_string(i) + "].";
 
                 /* 0 */ cache.emplace_back(indexed + "position");
@@ -570,12 +946,14 @@ namespace jop
                 /* 7 */ cache.emplace_back(indexed + "castShadow");
                 /* 8 */ cache.emplace_back(indexed + "lsMatrix");
                 /* 9 */ cache.emplace_back("u_SpotLightShadowMaps[" + std::to_string(i) + "]");
+
+                /* 10 */ cache.emplace_back(indexed + "enabled");
             }
 
             for (std::size_t i = 0; i < LS::getMaximumLights(LS::Type::Directional); ++i)
             {
-                auto& cache = strCache[static_cast<int>(LS::Type::Directional)][i];
-                cache.reserve(7);
+                auto& cache = handleCache[static_cast<int>(LS::Type::Directional)][i];
+                cache.reserve(10);
                 const std::string indexed = "u_DirectionalLights[" + std::to_string(i) + "].";
 
                 /* 0 */ cache.emplace_back(indexed + "direction");
@@ -585,13 +963,51 @@ namespace jop
                 /* 3 */ cache.emplace_back(indexed + "specular");
 
                 /* 4 */ cache.emplace_back(indexed + "castShadow");
-                /* 5 */ cache.emplace_back(indexed + "lsMatrix");
+                /* 5 */ cache.emplace_back(indexed + "lsMatrices[0]");
                 /* 6 */ cache.emplace_back("u_DirectionalLightShadowMaps[" + std::to_string(i) + "]");
+
+                /* 7 */ cache.emplace_back(indexed + "enabled");
+
+                /* 8 */ cache.emplace_back(indexed + "cascadeSplits");
+                /* 9 */ cache.emplace_back(indexed + "cascades");
             }
 
             cacheInit = true;
         }
 
+        // The light data has already been sent by sendToBlock(), only the shadow maps are left
+        if (usesUniformBlock())
+        {
+            if (!receiveShadows || !shadows)
+                return;
+
+            for (std::size_t i = 0; i < (*this)[LS::Type::Point].size(); ++i)
+            {
+                auto& li = *(*this)[LS::Type::Point][i];
+
+                if (li.castsShadows())
+                    shader.setUniform(handleCache[static_cast<int>(LS::Type::Point)][i][6], *li.getShadowMap(), currentPointShadowUnit++);
+            }
+
+            for (std::size_t i = 0; i < (*this)[LS::Type::Spot].size(); ++i)
+            {
+                auto& li = *(*this)[LS::Type::Spot][i];
+
+                if (li.castsShadows())
+                    shader.setUniform(handleCache[static_cast<int>(LS::Type::Spot)][i][9], *li.getShadowMap(), currentDirSpotShadowUnit++);
+            }
+
+            for (std::size_t i = 0; i < (*this)[LS::Type::Directional].size(); ++i)
+            {
+                auto& li = *(*this)[LS::Type::Directional][i];
+
+                if (li.castsShadows())
+                    shader.setUniform(handleCache[static_cast<int>(LS::Type::Directional)][i][6], *li.getShadowMap(), currentDirSpotShadowUnit++);
+            }
+
+            return;
+        }
+
         // Point lights
         {
             auto& points = (*this)[LS::Type::Point];
@@ -601,7 +1017,7 @@ namespace jop
         #endif
             if (!points.empty())
             {
-                shader.setUniform("u_NumPointLights", static_cast<int>(points.size()));
+                shader.setUniform(numLightsHandles[0], static_cast<int>(points.size()));
             }
 
             for (std::size_t i = 0; i < points.size(); ++i)
@@ -612,13 +1028,13 @@ namespace jop
                 {
                     const bool enabled = receiveLights && !empty();
 
-                    shader.setUniform("u_PointLights[" + std::to_string(i) + "].enabled", enabled);
+                    shader.setUniform(handleCache[static_cast<int>(LS::Type::Point)][i][8], enabled);
                 }
 
             #endif
 
                 auto& li = *points[i];
-                auto& cache = strCache[static_cast<int>(LS::Type::Point)][i];
+                auto& cache = handleCache[static_cast<int>(LS::Type::Point)][i];
 
                 // Position
                 shader.setUniform(cache[0], glm::vec3(viewMatrix * glm::vec4(li.getObject()->getGlobalPosition(), 1.f)));
@@ -654,7 +1070,7 @@ namespace jop
         #endif
             if (!spots.empty())
             {
-                shader.setUniform("u_NumSpotLights", static_cast<int>(spots.size()));
+                shader.setUniform(numLightsHandles[1], static_cast<int>(spots.size()));
             }
 
             for (std::size_t i = 0; i < spots.size(); ++i)
@@ -665,13 +1081,13 @@ namespace jop
                 {
                     const bool enabled = receiveLights && !empty();
 
-                    shader.setUniform("u_SpotLights[" + std::to_string(i) + "].enabled", enabled);
+                    shader.setUniform(handleCache[static_cast<int>(LS::Type::Spot)][i][10], enabled);
                 }
 
             #endif
 
                 auto& li = *spots[i];
-                auto& cache = strCache[static_cast<int>(LS::Type::Spot)][i];
+                auto& cache = handleCache[static_cast<int>(LS::Type::Spot)][i];
 
                 // Position
                 shader.setUniform(cache[0], glm::vec3(viewMatrix * glm::vec4(li.getObject()->getGlobalPosition(), 1.f)));
@@ -697,7 +1113,7 @@ namespace jop
 
                     if (li.castsShadows())
                     {
-                        shader.setUniform(cache[8], li.getLightspaceMatrix());
+                        shader.setUniform(cache[8], li.getLightspaceMatrix() * proj.getInverseViewMatrix());
                         shader.setUniform(cache[9], *li.getShadowMap(), currentDirSpotShadowUnit++);
                     }
                 }
@@ -713,7 +1129,7 @@ namespace jop
         #endif
             if (!dirs.empty())
             {
-                shader.setUniform("u_NumDirectionalLights", static_cast<int>(dirs.size()));
+                shader.setUniform(numLightsHandles[2], static_cast<int>(dirs.size()));
             }
 
             for (std::size_t i = 0; i < dirs.size(); ++i)
@@ -724,13 +1140,13 @@ namespace jop
                 {
                     const bool enabled = receiveLights && !empty();
 
-                    shader.setUniform("u_DirectionalLights[" + std::to_string(i) + "].enabled", enabled);
+                    shader.setUniform(handleCache[static_cast<int>(LS::Type::Directional)][i][7], enabled);
                 }
 
             #endif
 
                 auto& li = *dirs[i];
-                auto& cache = strCache[static_cast<int>(LS::Type::Directional)][i];
+                auto& cache = handleCache[static_cast<int>(LS::Type::Directional)][i];
 
                 // Direction
                 shader.setUniform(cache[0], glm::normalize(li.getObject()->getGlobalFront()));
@@ -747,8 +1163,15 @@ namespace jop
 
                     if (li.castsShadows())
                     {
-                        shader.setUniform(cache[5], li.getLightspaceMatrix());
+                        glm::mat4 lsMatrices[ns_maxShadowCascades];
+
+                        for (unsigned int c = 0; c < li.getShadowCascades(); ++c)
+                            lsMatrices[c] = li.getLightspaceMatrix(static_cast<Cubemap::Face>(c)) * proj.getInverseViewMatrix();
+
+                        shader.setUniform(cache[5], glm::value_ptr(lsMatrices[0]), li.getShadowCascades());
                         shader.setUniform(cache[6], *li.getShadowMap(), currentDirSpotShadowUnit++);
+                        shader.setUniform(cache[8], li.getCascadeSplits());
+                        shader.setUniform(cache[9], static_cast<int>(li.getShadowCascades()));
                     }
                 }
             }
@@ -757,6 +1180,106 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    void LightContainer::sendToBlock(UniformBuffer& buffer, const Drawable::ProjectionInfo& proj) const
+    {
+        const glm::mat4& viewMatrix = proj.viewMatrix;
+
+        typedef LightSource LS;
+
+        const std::size_t maxPoints = LS::getMaximumLights(LS::Type::Point);
+        const std::size_t maxSpots = LS::getMaximumLights(LS::Type::Spot);
+        const std::size_t maxDirs = LS::getMaximumLights(LS::Type::Directional);
+
+        const std::size_t pointOffset = ns_lightBlockHeaderSize;
+        const std::size_t spotOffset = pointOffset + maxPoints * sizeof(PointLightBlock);
+        const std::size_t dirOffset = spotOffset + maxSpots * sizeof(SpotLightBlock);
+        const std::size_t totalSize = dirOffset + maxDirs * sizeof(DirectionalLightBlock);
+
+        // Reused between calls to avoid allocating every frame
+        static std::vector<unsigned char> data;
+        data.assign(totalSize, 0);
+
+        auto& points = (*this)[LS::Type::Point];
+        auto& spots = (*this)[LS::Type::Spot];
+        auto& dirs = (*this)[LS::Type::Directional];
+
+        // Light counts
+        {
+            const int32 counts[] =
+            {
+                static_cast<int32>(std::min(points.size(), maxPoints)),
+                static_cast<int32>(std::min(spots.size(), maxSpots)),
+                static_cast<int32>(std::min(dirs.size(), maxDirs))
+            };
+
+            std::memcpy(data.data(), counts, sizeof(counts));
+        }
+
+        // Point lights
+        for (std::size_t i = 0; i < points.size() && i < maxPoints; ++i)
+        {
+            auto& li = *points[i];
+            auto& block = reinterpret_cast<PointLightBlock*>(data.data() + pointOffset)[i];
+
+            block.position      = glm::vec3(viewMatrix * glm::vec4(li.getObject()->getGlobalPosition(), 1.f));
+            block.enabled       = 1;
+            block.ambient       = li.getIntensity(LS::Intensity::Ambient).colors;
+            block.diffuse       = li.getIntensity(LS::Intensity::Diffuse).colors;
+            block.specular      = li.getIntensity(LS::Intensity::Specular).colors;
+            block.attenuation   = li.getAttenuation();
+            block.castShadow    = li.castsShadows();
+            block.farPlane      = li.getRange() * 10.f;
+        }
+
+        // Spot lights
+        for (std::size_t i = 0; i < spots.size() && i < maxSpots; ++i)
+        {
+            auto& li = *spots[i];
+            auto& block = reinterpret_cast<SpotLightBlock*>(data.data() + spotOffset)[i];
+
+            block.position      = glm::vec3(viewMatrix * glm::vec4(li.getObject()->getGlobalPosition(), 1.f));
+            block.direction     = glm::normalize(li.getObject()->getGlobalFront());
+            block.enabled       = 1;
+            block.ambient       = li.getIntensity(LS::Intensity::Ambient).colors;
+            block.diffuse       = li.getIntensity(LS::Intensity::Diffuse).colors;
+            block.specular      = li.getIntensity(LS::Intensity::Specular).colors;
+            block.attenuation   = li.getAttenuation();
+            block.cutoff        = glm::vec2(std::cos(li.getCutoff().x), std::cos(li.getCutoff().y));
+            block.castShadow    = li.castsShadows();
+
+            if (li.castsShadows())
+                block.lsMatrix = li.getLightspaceMatrix() * proj.getInverseViewMatrix();
+        }
+
+        // Directional lights
+        for (std::size_t i = 0; i < dirs.size() && i < maxDirs; ++i)
+        {
+            auto& li = *dirs[i];
+            auto& block = reinterpret_cast<DirectionalLightBlock*>(data.data() + dirOffset)[i];
+
+            block.direction     = glm::normalize(li.getObject()->getGlobalFront());
+            block.enabled       = 1;
+            block.ambient       = li.getIntensity(LS::Intensity::Ambient).colors;
+            block.diffuse       = li.getIntensity(LS::Intensity::Diffuse).colors;
+            block.specular      = li.getIntensity(LS::Intensity::Specular).colors;
+            block.castShadow    = li.castsShadows();
+
+            if (li.castsShadows())
+            {
+                for (unsigned int c = 0; c < li.getShadowCascades(); ++c)
+                    block.lsMatrices[c] = li.getLightspaceMatrix(static_cast<Cubemap::Face>(c)) * proj.getInverseViewMatrix();
+
+                block.cascadeSplits = li.getCascadeSplits();
+                block.cascades      = static_cast<int32>(li.getShadowCascades());
+            }
+        }
+
+        buffer.setData(data.data(), data.size());
+        buffer.bindBase(UniformBuffer::LightBlock);
+    }
+
+    //////////////////////////////////////////////
+
     LightContainer::ContainerType& LightContainer::operator[](const LightSource::Type type)
     {
         return m_container[static_cast<int>(type)];
@@ -768,4 +1291,13 @@ namespace jop
     {
         return m_container[static_cast<int>(type)];
     }
+
+    //////////////////////////////////////////////
+
+    bool LightContainer::usesUniformBlock()
+    {
+        static const bool use = UniformBuffer::isSupported() && SettingManager::get<bool>("engine@Graphics|Shading|bUniformBlockLights", true);
+
+        return use;
+    }
 }
\ No newline at end of file
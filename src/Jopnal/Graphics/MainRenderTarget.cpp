@@ -42,6 +42,8 @@ namespace jop
           Subsystem     (0),
           m_windowRef   (window)
     {
+        setAffinity(Stage::PreUpdate, Affinity::Render);
+
         const glm::uvec2 scaledRes(SettingManager::get<float>("engine@Graphics|MainRenderTarget|fResolutionScale", 1.f) * glm::vec2(window.getSize()));
 
         const bool hdr = SettingManager::get<bool>("engine@Graphics|MainRenderTarget|bHDR", !gl::es || JOP_CHECK_EGL_EXTENSION(GL_EXT_color_buffer_half_float));
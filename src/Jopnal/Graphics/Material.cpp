@@ -34,6 +34,7 @@
     #include <Jopnal/Graphics/ShaderAssembler.hpp>
     #include <Jopnal/Graphics/ShaderProgram.hpp>
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
+    #include <Jopnal/Graphics/Culling/LightClusterer.hpp>
     #include <typeinfo>
 
 #endif
@@ -108,57 +109,57 @@ namespace jop
     {
         if (shader.bind())
         {
-            static const std::string strCache[] =
+            static const UniformHandle handles[] =
             {
-                /* 0 */  "u_CameraPosition",
-                /* 1 */  "u_Material.ambient",
-                /* 2 */  "u_Material.diffuse",
-                /* 3 */  "u_Material.specular",
-                /* 4 */  "u_Material.emission",
-                /* 5 */  "u_Material.shininess",
-                /* 6 */  "u_Material.reflectivity",
-                /* 7 */  "u_DiffuseMap",
-                /* 8 */  "u_SpecularMap",
-                /* 9 */  "u_EmissionMap",
-                /* 10 */ "u_OpacityMap",
-                /* 11 */ "u_GlossMap",
-                /* 12 */ "u_EnvironmentMap",
-                /* 13 */ "u_ReflectionMap"
+                /* 0 */  UniformHandle("u_CameraPosition"),
+                /* 1 */  UniformHandle("u_Material.ambient"),
+                /* 2 */  UniformHandle("u_Material.diffuse"),
+                /* 3 */  UniformHandle("u_Material.specular"),
+                /* 4 */  UniformHandle("u_Material.emission"),
+                /* 5 */  UniformHandle("u_Material.shininess"),
+                /* 6 */  UniformHandle("u_Material.reflectivity"),
+                /* 7 */  UniformHandle("u_DiffuseMap"),
+                /* 8 */  UniformHandle("u_SpecularMap"),
+                /* 9 */  UniformHandle("u_EmissionMap"),
+                /* 10 */ UniformHandle("u_OpacityMap"),
+                /* 11 */ UniformHandle("u_GlossMap"),
+                /* 12 */ UniformHandle("u_EnvironmentMap"),
+                /* 13 */ UniformHandle("u_ReflectionMap")
             };
 
             if (m_attributes & LightingAttribs)
             {
-                shader.setUniform(strCache[1], m_reflection[castEnum(Reflection::Ambient)].asRGBAVector());
-                shader.setUniform(strCache[2], m_reflection[castEnum(Reflection::Diffuse)].asRGBAVector());
-                shader.setUniform(strCache[3], m_reflection[castEnum(Reflection::Specular)].asRGBAVector());
-                shader.setUniform(strCache[4], m_reflection[castEnum(Reflection::Emission)].asRGBAVector());
-                shader.setUniform(strCache[5], m_shininess);
+                shader.setUniform(handles[1], m_reflection[castEnum(Reflection::Ambient)].asRGBAVector());
+                shader.setUniform(handles[2], m_reflection[castEnum(Reflection::Diffuse)].asRGBAVector());
+                shader.setUniform(handles[3], m_reflection[castEnum(Reflection::Specular)].asRGBAVector());
+                shader.setUniform(handles[4], m_reflection[castEnum(Reflection::Emission)].asRGBAVector());
+                shader.setUniform(handles[5], m_shininess);
 
                 if (checkMap(m_attributes, Map::Environment))
-                    shader.setUniform(strCache[6], m_reflectivity);
+                    shader.setUniform(handles[6], m_reflectivity);
 
                 if (checkMap(m_attributes, Map::Gloss) && getMap(Map::Gloss))
-                    shader.setUniform(strCache[11], *getMap(Map::Gloss), castEnum<Map, unsigned int>(Map::Gloss));
+                    shader.setUniform(handles[11], *getMap(Map::Gloss), castEnum<Map, unsigned int>(Map::Gloss));
 
                 if (checkMap(m_attributes, Map::Specular) && getMap(Map::Specular))
-                    shader.setUniform(strCache[8], *getMap(Map::Specular), castEnum<Map, unsigned int>(Map::Specular));
+                    shader.setUniform(handles[8], *getMap(Map::Specular), castEnum<Map, unsigned int>(Map::Specular));
 
                 if (checkMap(m_attributes, Map::Emission) && getMap(Map::Emission))
-                    shader.setUniform(strCache[9], *getMap(Map::Emission), castEnum<Map, unsigned int>(Map::Emission));
+                    shader.setUniform(handles[9], *getMap(Map::Emission), castEnum<Map, unsigned int>(Map::Emission));
             }
 
             if (checkMap(m_attributes, Map::Diffuse0) && getMap(Map::Diffuse0))
-                shader.setUniform(strCache[7], *getMap(Material::Map::Diffuse0), castEnum<Map, unsigned int>(Map::Diffuse0));
+                shader.setUniform(handles[7], *getMap(Material::Map::Diffuse0), castEnum<Map, unsigned int>(Map::Diffuse0));
 
             if (checkMap(m_attributes, Map::Opacity) && getMap(Map::Opacity))
-                shader.setUniform(strCache[10], *getMap(Map::Opacity), castEnum<Map, unsigned int>(Map::Opacity));
+                shader.setUniform(handles[10], *getMap(Map::Opacity), castEnum<Map, unsigned int>(Map::Opacity));
 
             if (checkMap(m_attributes, Map::Environment) && getMap(Map::Environment))
             {
-                shader.setUniform(strCache[12], *getMap(Map::Environment), castEnum<Map, unsigned int>(Map::Environment));
+                shader.setUniform(handles[12], *getMap(Map::Environment), castEnum<Map, unsigned int>(Map::Environment));
 
                 if (checkMap(m_attributes, Map::Reflection) && getMap(Map::Reflection))
-                    shader.setUniform(strCache[13], *getMap(Map::Reflection), castEnum<Map, unsigned int>(Map::Reflection));
+                    shader.setUniform(handles[13], *getMap(Map::Reflection), castEnum<Map, unsigned int>(Map::Reflection));
             }
         }
     }
@@ -347,6 +348,14 @@ namespace jop
 
             str += maxLights;
 
+            // Lights are read from jop_LightBlock
+            if (LightContainer::usesUniformBlock())
+                str += "#define JOP_LIGHT_BLOCK\n";
+
+            // Point & spot lights without shadows are read from the light clusters
+            if (detail::LightClusterer::isEnabled())
+                str += detail::LightClusterer::getShaderDefines();
+
             // Phong model
             if (attributes & castEnum(LightingModel::Phong))
             {
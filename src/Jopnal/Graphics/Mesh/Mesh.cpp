@@ -42,33 +42,56 @@
 namespace jop
 {
     Mesh::Mesh(const std::string& name)
-        : Resource              (name),
-          m_vertexbuffer        (Buffer::Type::ArrayBuffer),
-          m_indexbuffer         (Buffer::Type::ElementArrayBuffer),
-          m_shape               (""),
-          m_bounds              (),
-          m_vertexComponents    (0),
-          m_elementSize         (0),
-          m_vertexSize          (0)
+        : Resource                  (name),
+          m_vertexbuffer            (Buffer::Type::ArrayBuffer),
+          m_indexbuffer             (Buffer::Type::ElementArrayBuffer),
+          m_shape                   (""),
+          m_bounds                  (),
+          m_vertexComponents        (0),
+          m_vertexArrayComponents   (0),
+          m_vertexArray             (0),
+          m_elementSize             (0),
+          m_vertexSize              (0)
     {
         m_shape.load(glm::vec3(1.f));
     }
 
     Mesh::Mesh(const Mesh& other, const std::string& newName)
-        : Resource              (other, newName),
-          m_vertexbuffer        (other.m_vertexbuffer),
-          m_indexbuffer         (other.m_indexbuffer),
-          m_shape               (other.m_shape, ""),
-          m_bounds              (other.m_bounds),
-          m_vertexComponents    (other.m_vertexComponents),
-          m_elementSize         (other.m_elementSize),
-          m_vertexSize          (other.m_vertexSize)
-    {}
+        : Resource                  (other, newName),
+          m_vertexbuffer            (other.m_vertexbuffer),
+          m_indexbuffer             (Buffer::Type::ElementArrayBuffer),
+          m_shape                   (other.m_shape, ""),
+          m_bounds                  (other.m_bounds),
+          m_vertexComponents        (other.m_vertexComponents),
+          m_vertexArrayComponents   (0),
+          m_vertexArray             (0),
+          m_elementSize             (other.m_elementSize),
+          m_vertexSize              (other.m_vertexSize)
+    {
+        // The default vertex array is bound before copying the index buffer,
+        // since its binding would otherwise end up in another mesh's vertex array
+        GlState::setVertexArray(0);
+
+        m_indexbuffer = VertexBuffer(other.m_indexbuffer);
+    }
+
+    Mesh::~Mesh()
+    {
+        destroyVertexArray();
+
+        // The index buffer is bound when destroyed, which mustn't affect another mesh's vertex array
+        GlState::setVertexArray(0);
+    }
 
     //////////////////////////////////////////////
 
     bool Mesh::load(const void* vertexData, const unsigned int vertexBytes, const uint32 vertexComponents, const void* indexData, const unsigned short indexSize, const unsigned int indexAmount, const bool calculateBounds)
     {
+        destroyVertexArray();
+
+        // Binding the index buffer is recorded by the bound vertex array
+        GlState::setVertexArray(0);
+
         m_vertexbuffer.destroy();
         m_indexbuffer.destroy();
 
@@ -111,7 +134,10 @@ namespace jop
         {
             if (getElementAmount())
             {
-                getIndexBuffer().bind();
+                // The vertex array already holds the index buffer binding
+                if (!m_vertexArray)
+                    getIndexBuffer().bind();
+
                 glCheck(glDrawElements(GL_TRIANGLES, getElementAmount(), getElementEnum(), 0));
             }
             else
@@ -123,8 +149,89 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    void Mesh::drawInstanced(const unsigned int instances, const VertexBuffer& instanceBuffer) const
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        if (!instances || !isInstancingSupported() || !updateVertexAttributes())
+            return;
+
+        // Per-instance data: mat4 model matrix + vec4 color
+        const GLsizei stride = sizeof(glm::mat4) + sizeof(glm::vec4);
+        const bool instanceColor = (m_vertexComponents & Color) == 0;
+
+        // When drawing through this mesh's vertex array, the instance attributes
+        // are toggled on it directly, GlState only tracks the default array
+        auto setAttribute = [this](const bool enable, const unsigned int index)
+        {
+            if (!m_vertexArray)
+                GlState::setVertexAttribute(enable, index);
+            else if (enable)
+            {
+                glCheck(glEnableVertexAttribArray(index));
+            }
+            else
+            {
+                glCheck(glDisableVertexAttribArray(index));
+            }
+        };
+
+        instanceBuffer.bind();
+
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            setAttribute(true, VertexIndex::ModelMatrix + i);
+            glCheck(glVertexAttribPointer(VertexIndex::ModelMatrix + i, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(sizeof(glm::vec4) * i)));
+            glCheck(glVertexAttribDivisor(VertexIndex::ModelMatrix + i, 1));
+        }
+
+        if (instanceColor)
+        {
+            setAttribute(true, VertexIndex::Color);
+            glCheck(glVertexAttribPointer(VertexIndex::Color, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(sizeof(glm::mat4))));
+            glCheck(glVertexAttribDivisor(VertexIndex::Color, 1));
+        }
+
+        if (getElementAmount())
+        {
+            if (!m_vertexArray)
+                getIndexBuffer().bind();
+
+            glCheck(glDrawElementsInstanced(GL_TRIANGLES, getElementAmount(), getElementEnum(), 0, instances));
+        }
+        else
+        {
+            glCheck(glDrawArraysInstanced(GL_TRIANGLES, 0, getVertexAmount(), instances));
+        }
+
+        // Restore the divisors so that regular draws aren't affected
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            glCheck(glVertexAttribDivisor(VertexIndex::ModelMatrix + i, 0));
+            setAttribute(false, VertexIndex::ModelMatrix + i);
+        }
+
+        if (instanceColor)
+        {
+            glCheck(glVertexAttribDivisor(VertexIndex::Color, 0));
+            setAttribute(false, VertexIndex::Color);
+        }
+
+    #else
+
+        static_cast<void>(instances);
+        static_cast<void>(instanceBuffer);
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
     void Mesh::destroy()
     {
+        destroyVertexArray();
+        GlState::setVertexArray(0);
+
         m_vertexbuffer.destroy();
         m_indexbuffer.destroy();
 
@@ -271,46 +378,129 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    bool Mesh::isInstancingSupported()
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        static const bool supported = gl::es ? gl::getVersionMajor() >= 3 :
+                                               (gl::getVersionMajor() > 3 || (gl::getVersionMajor() == 3 && gl::getVersionMinor() >= 3));
+
+        return supported;
+
+    #else
+
+        return false;
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
     bool Mesh::updateVertexAttributes() const
     {
         if (!getVertexAmount())
             return false;
 
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        if (gl::getVersionMajor() >= 3)
+        {
+            // The vertex array is built lazily and rebuilt if the vertex layout changes
+            if (!m_vertexArray || m_vertexArrayComponents != m_vertexComponents)
+            {
+                destroyVertexArray();
+
+                glCheck(glGenVertexArrays(1, &m_vertexArray));
+                GlState::setVertexArray(m_vertexArray);
+
+                setVertexAttributes();
+
+                if (getElementAmount())
+                    getIndexBuffer().bind();
+
+                m_vertexArrayComponents = m_vertexComponents;
+            }
+            else
+                GlState::setVertexArray(m_vertexArray);
+
+            return true;
+        }
+
+    #endif
+
+        // GLES 2.0 fallback
+        setVertexAttributes();
+
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
+    void Mesh::setVertexAttributes() const
+    {
+        // Enables the attributes on the bound vertex array. A newly created
+        // vertex array has all of them disabled
+        auto setAttribute = [this](const bool enable, const unsigned int index)
+        {
+            if (!m_vertexArray)
+                GlState::setVertexAttribute(enable, index);
+            else if (enable)
+            {
+                glCheck(glEnableVertexAttribArray(index));
+            }
+        };
+
         m_vertexbuffer.bind();
 
         const auto vertSize = getVertexSize();
 
         // Positions (should always be present)
-        GlState::setVertexAttribute(true, VertexIndex::Position);
+        setAttribute(true, VertexIndex::Position);
         glCheck(glVertexAttribPointer(VertexIndex::Position, 3, GL_FLOAT, GL_FALSE, vertSize, getVertexOffset(Position)));
 
         // Texture coordinates
         if ((m_vertexComponents & TexCoords))
         {
-            GlState::setVertexAttribute(true, VertexIndex::TexCoords);
+            setAttribute(true, VertexIndex::TexCoords);
             glCheck(glVertexAttribPointer(VertexIndex::TexCoords, 2, GL_FLOAT, GL_FALSE, vertSize, getVertexOffset(TexCoords)));
         }
         else
-            GlState::setVertexAttribute(false, VertexIndex::TexCoords);
+            setAttribute(false, VertexIndex::TexCoords);
 
         // Normals
         if (m_vertexComponents & Normal)
         {
-            GlState::setVertexAttribute(true, VertexIndex::Normal);
+            setAttribute(true, VertexIndex::Normal);
             glCheck(glVertexAttribPointer(VertexIndex::Normal, 3, GL_FLOAT, GL_FALSE, vertSize, getVertexOffset(Normal)));
         }
         else
-            GlState::setVertexAttribute(false, VertexIndex::Normal);
+            setAttribute(false, VertexIndex::Normal);
 
         // Colors
         if (m_vertexComponents & Color)
         {
-            GlState::setVertexAttribute(true, VertexIndex::Color);
+            setAttribute(true, VertexIndex::Color);
             glCheck(glVertexAttribPointer(VertexIndex::Color, 4, GL_FLOAT, GL_FALSE, vertSize, getVertexOffset(Color)));
         }
         else
-            GlState::setVertexAttribute(false, VertexIndex::Color);
+            setAttribute(false, VertexIndex::Color);
+    }
 
-        return true;
+    //////////////////////////////////////////////
+
+    void Mesh::destroyVertexArray() const
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        if (m_vertexArray)
+        {
+            // Make sure GlState doesn't keep a deleted array bound
+            GlState::setVertexArray(0);
+
+            glCheck(glDeleteVertexArrays(1, &m_vertexArray));
+            m_vertexArray = 0;
+        }
+
+    #endif
     }
 }
\ No newline at end of file
@@ -29,6 +29,7 @@
 #ifndef JOP_PRECOMPILED_HEADER
 
     #include <Jopnal/Core/DebugHandler.hpp>
+    #include <Jopnal/Core/Engine.hpp>
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
 
 #endif
@@ -45,6 +46,8 @@ namespace jop { namespace detail
 {
     void openGlCheck(const char* func, const char* file, const unsigned int line)
     {
+        JOP_ASSERT(!Engine::isSimulationThread(), "An OpenGL function was called from the simulation thread, which has no graphics context. See Engine::pipelinedSimulationEnabled()");
+
     #if JOP_CONSOLE_VERBOSITY < 0
 
         func;
@@ -60,6 +60,8 @@ namespace
     std::pair<bool, float> ns_line;
     jop::GlState::PolygonMode ns_polygonMode;
     std::vector<bool> ns_vertexAttribs;
+    unsigned int ns_vertexArray;
+    unsigned int ns_defaultVertexArray;
     bool ns_depthMask;
 
     void enableDisable(const bool enable, GLenum enum_)
@@ -106,6 +108,10 @@ namespace jop
         // All vertex attributes are disabled by default
         ns_vertexAttribs.clear();
 
+        // No vertex array is bound by default
+        ns_vertexArray = 0;
+        ns_defaultVertexArray = 0;
+
         // Depth mask is enabled by default
         ns_depthMask = true;
 
@@ -294,6 +300,9 @@ namespace jop
     {
         static int attribLocs = 0;
 
+        // The cached attribute states are only valid for the default vertex array
+        setVertexArray(0);
+
         if (ns_vertexAttribs.empty())
         {
             glCheck(glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &attribLocs));
@@ -318,6 +327,37 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    void GlState::setVertexArray(const unsigned int array)
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        const unsigned int target = array ? array : ns_defaultVertexArray;
+
+        if (ns_vertexArray != target)
+        {
+            glCheck(glBindVertexArray(target));
+
+            ns_vertexArray = target;
+        }
+
+    #else
+
+        static_cast<void>(array);
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
+    void GlState::setDefaultVertexArray(const unsigned int array)
+    {
+        ns_defaultVertexArray = array;
+
+        setVertexArray(0);
+    }
+
+    //////////////////////////////////////////////
+
     void GlState::setDepthWrite(const bool enable)
     {
         if (ns_depthMask != enable)
@@ -26,6 +26,7 @@
 
     #include <Jopnal/Graphics/PostProcessor.hpp>
 
+    #include <Jopnal/Core/Profiler.hpp>
     #include <Jopnal/Graphics/Mesh/RectangleMesh.hpp>
     #include <Jopnal/Graphics/Shader.hpp>
     #include <Jopnal/Graphics/ShaderProgram.hpp>
@@ -212,6 +213,8 @@ namespace jop
 
     void PostProcessor::draw()
     {
+        JOP_PROFILE_DYNAMIC_SCOPE("PostProcessor", "render", Profiler::Type::GPU);
+
         if (m_shaders.find(m_functions) == m_shaders.end())
         {
             std::string pp;
@@ -29,20 +29,53 @@
     #include <Jopnal/Core/Engine.hpp>
     #include <Jopnal/Core/Object.hpp>
     #include <Jopnal/Core/Scene.hpp>
+    #include <Jopnal/Core/SettingManager.hpp>
     #include <Jopnal/Graphics/Camera.hpp>
     #include <Jopnal/Graphics/Drawable.hpp>
     #include <Jopnal/Graphics/LightSource.hpp>
     #include <Jopnal/Graphics/Material.hpp>
     #include <Jopnal/Graphics/Renderer.hpp>
     #include <Jopnal/Graphics/RenderTarget.hpp>
+    #include <Jopnal/Graphics/UniformBuffer.hpp>
+    #include <Jopnal/Graphics/Mesh/Mesh.hpp>
     #include <Jopnal/Graphics/OpenGL/GlState.hpp>
-    #include <glm/gtx/norm.hpp>
+    #include <Jopnal/Graphics/Culling/LightClusterer.hpp>
+    #include <Jopnal/Utility/ThreadPool.hpp>
+    #include <glm/geometric.hpp>
+    #include <algorithm>
+    #include <typeinfo>
 
 #endif
 
 //////////////////////////////////////////////
 
 
+namespace
+{
+    // Counts the shader, material & mesh switches when drawing in the given order
+    template<typename T>
+    unsigned int countChanges(const std::vector<T>& items, unsigned int* changes)
+    {
+        unsigned int total = 0;
+
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                if (i == 0 || items[i].state[j] != items[i - 1].state[j])
+                {
+                    ++total;
+
+                    if (changes)
+                        ++changes[j];
+                }
+            }
+        }
+
+        return total;
+    }
+}
+
 namespace jop
 {
     const uint32 RenderPass::DefaultWeight = 0x88888888;
@@ -122,112 +155,435 @@ namespace jop
     //////////////////////////////////////////////
 
 
+    struct SortedRenderPass::DrawItem
+    {
+        uint64 key;                 ///< The sort key
+        const Drawable* drawable;   ///< The drawable
+        const void* state[3];       ///< Shader, material & mesh
+        uint32 index;               ///< Index of the drawable, used to find its matrices
+    };
+
+    struct SortedRenderPass::View
+    {
+        const Camera* camera;                           ///< The camera
+        glm::mat4 viewMatrix;                           ///< The camera's view matrix
+        glm::mat4 inverseViewMatrix;                    ///< Inverse of the view matrix, i.e. the camera transformation
+        glm::mat4 projectionMatrix;                     ///< The camera's projection matrix
+        glm::vec3 cameraPosition;                       ///< The camera's global position
+        std::vector<std::vector<DrawItem>> chunks;      ///< Draw items gathered by each chunk
+        std::vector<DrawItem> items;                    ///< Merged & sorted draw items
+        std::vector<DrawItem> sortBuffer;               ///< Radix sort scratch buffer
+        std::vector<Drawable::DrawMatrices> matrices;   ///< Matrices of each drawable, by index
+        unsigned int changes[3];                        ///< Shader, material & mesh switches in the sorted order
+        unsigned int avoidedChanges;                    ///< Switches avoided compared to the unsorted order
+    };
+
+    //////////////////////////////////////////////
+
     SortedRenderPass::SortedRenderPass(Renderer& renderer, const RenderTarget& target, const Pass pass, const uint32 weight)
-        : RenderPass(renderer, target, pass, weight)
+        : RenderPass        (renderer, target, pass, weight),
+          m_drawables       (),
+          m_indices         (),
+          m_shaders         (),
+          m_stateKeys       (),
+          m_stateIds        (),
+          m_views           (),
+          m_chunkCount      (1),
+          m_instances       (),
+          m_clusteredLights (),
+          m_lights          (std::make_unique<LightContainer>()),
+          m_instanceBuffer  (Buffer::Type::ArrayBuffer, Buffer::StreamDraw),
+          m_stats           ()
     {}
 
+    SortedRenderPass::~SortedRenderPass()
+    {}
+
+    //////////////////////////////////////////////
+
+    const SortedRenderPass::Statistics& SortedRenderPass::getStatistics() const
+    {
+        return m_stats;
+    }
+
     //////////////////////////////////////////////
 
     const LightContainer ns_dummyLightCont;
 
+    // Sort key layout
+    //
+    // Opaque & sky:  [bucket:2][shader:14][material:14][mesh:14][depth:20]
+    // Translucent:   [bucket:2][inverted depth:20][shader:14][material:14][mesh:14]
+    //
+    const uint64 ns_stateBits = 14;
+    const uint64 ns_stateMask = (1ull << ns_stateBits) - 1;
+    const uint64 ns_depthBits = 20;
+    const uint64 ns_depthMask = (1ull << ns_depthBits) - 1;
+    const uint64 ns_skyAttribs = Drawable::Attribute::__SkyBox | Drawable::Attribute::__SkySphere;
+
+    // Minimum amount of drawables per prepare chunk
+    const std::size_t ns_prepareChunkSize = 256;
+
     void SortedRenderPass::draw()
     {
+        m_stats = Statistics();
+
         if (!isActive() || m_drawables.empty())
             return;
 
-        const auto& rend = getRenderer();
+        auto& rend = getRenderer();
 
-        const auto& target = rend.getRenderTarget();
         const auto& cameras = rend.getCameras();
         const auto& lights = rend.getLights();
 
+        // The same lights are used for every drawable, so they only need to be gathered once.
+        // The container is kept between frames to reuse its memory
+        auto& lightCont = *m_lights;
+        lightCont.clear();
+
+        const bool clustered = detail::LightClusterer::isEnabled();
+        m_clusteredLights.clear();
+
+        for (auto l : lights)
+        {
+            if (clustered && detail::LightClusterer::isClustered(*l))
+                m_clusteredLights.push_back(l);
+
+            else if (lightCont[l->getType()].size() < LightSource::getMaximumLights(l->getType()))
+                lightCont[l->getType()].push_back(l);
+        }
+
+        // Transformations & shaders are evaluated lazily, and shaders may need
+        // to be compiled. That must happen here, the prepare phase only reads them.
+        // The state ids are shared by every view, so they're assigned here as well
+        m_shaders.resize(m_drawables.size());
+        m_stateKeys.resize(m_drawables.size());
+
+        for (auto& i : m_stateIds)
+            i.clear();
+
+        for (std::size_t i = 0; i < m_drawables.size(); ++i)
+        {
+            auto d = m_drawables[i];
+
+            if (d->isActive())
+            {
+                d->getObject()->getTransform();
+                m_shaders[i] = &d->getShader();
+
+                m_stateKeys[i] = (static_cast<uint64>(getStateId(0, m_shaders[i])) << (ns_stateBits * 2)) |
+                                 (static_cast<uint64>(getStateId(1, d->getMaterial())) << ns_stateBits) |
+                                  static_cast<uint64>(getStateId(2, d->getMesh()));
+            }
+        }
+
+        auto& pool = ThreadPool::getDefault();
+
+        m_chunkCount = std::max(std::size_t(1), std::min((m_drawables.size() + ns_prepareChunkSize - 1) / ns_prepareChunkSize,
+                                                         std::size_t(pool.getThreadCount() + 1) * 4));
+
+        std::size_t viewCount = 0;
+
         for (auto cam : cameras)
         {
             if (!cam->isActive() || !cam->getRenderMask())
                 continue;
 
-            const Drawable::ProjectionInfo projInfo(cam->getViewMatrix(), cam->getProjectionMatrix(), cam->getObject()->getGlobalPosition());
+            if (viewCount == m_views.size())
+                m_views.emplace_back(std::make_unique<View>());
 
-            if (!cam->getRenderTexture().bind())
-                target.bind();
+            auto& view = *m_views[viewCount++];
 
-            cam->applyViewport(target);
+            view.camera = cam;
+            view.viewMatrix = cam->getViewMatrix();
+            view.inverseViewMatrix = cam->getObject()->getTransform().getMatrix();
+            view.projectionMatrix = cam->getProjectionMatrix();
+            view.cameraPosition = cam->getObject()->getGlobalPosition();
+            view.chunks.resize(m_chunkCount);
+            view.matrices.resize(m_drawables.size());
+        }
+
+        // Prepare
+        pool.parallelFor(viewCount * m_chunkCount, 1, [this](const std::size_t begin, const std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+                prepareChunk(*m_views[i / m_chunkCount], i % m_chunkCount);
+        });
+
+        pool.parallelFor(viewCount, 1, [this](const std::size_t begin, const std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+                sortView(*m_views[i]);
+        });
+
+        // Submit
+        for (std::size_t i = 0; i < viewCount; ++i)
+            submitView(*m_views[i], lightCont, clustered);
+    }
+
+    //////////////////////////////////////////////
+
+    void SortedRenderPass::bind(const Drawable* drawable)
+    {
+        // A drawable bound twice would be drawn twice
+        if (m_indices.emplace(drawable, m_drawables.size()).second)
+            m_drawables.push_back(drawable);
+    }
+
+    //////////////////////////////////////////////
+
+    void SortedRenderPass::unbind(const Drawable* drawable)
+    {
+        auto itr = m_indices.find(drawable);
+
+        if (itr == m_indices.end())
+            return;
+
+        const std::size_t index = itr->second;
+        m_indices.erase(itr);
+
+        if (index != m_drawables.size() - 1)
+        {
+            m_drawables[index] = m_drawables.back();
+            m_indices[m_drawables[index]] = index;
+        }
+
+        m_drawables.pop_back();
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 SortedRenderPass::getStateId(const unsigned int type, const void* object)
+    {
+        auto& ids = m_stateIds[type];
+        auto itr = ids.find(object);
+
+        if (itr != ids.end())
+            return itr->second;
+
+        // Ids wrap around if there are more objects than fit in the key.
+        // The drawing order stays valid, grouping just becomes less effective
+        const uint32 id = static_cast<uint32>(ids.size() & ns_stateMask);
+        ids[object] = id;
+
+        return id;
+    }
+
+    //////////////////////////////////////////////
+
+    void SortedRenderPass::prepareChunk(View& view, const std::size_t chunk) const
+    {
+        const std::size_t chunkSize = (m_drawables.size() + m_chunkCount - 1) / m_chunkCount;
+        const std::size_t begin = std::min(chunk * chunkSize, m_drawables.size());
+        const std::size_t end = std::min(begin + chunkSize, m_drawables.size());
+
+        auto& items = view.chunks[chunk];
+        items.clear();
+
+        const auto& cam = *view.camera;
+        const Drawable::ProjectionInfo projInfo(view.viewMatrix, view.projectionMatrix, view.cameraPosition, view.inverseViewMatrix);
+
+        const float invFar = 1.f / std::max(cam.getClippingPlanes().second, 1.f);
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            auto d = m_drawables[i];
+
+            if (!d->isActive() || !cam.inView(*d))
+                continue;
 
             // 0 - Opaque
-            // 1 - Translucent
-            // 2 - Skybox & skysphere
+            // 1 - Skybox & skysphere
+            // 2 - Translucent
             //
-            std::vector<const Drawable*> sorted[3];
-            sorted[0].reserve(m_drawables.size());
+            const uint64 bucket = (d->getAttributes() & ns_skyAttribs) != 0 ? 1 : (d->hasAlpha() ? 2 : 0);
 
-            for (auto d : m_drawables)
-            {
-                if (!d->isActive() || !cam->inView(*d))
-                    continue;
+            DrawItem item;
+            item.drawable = d;
+            item.state[0] = m_shaders[i];
+            item.state[1] = d->getMaterial();
+            item.state[2] = d->getMesh();
+            item.index = static_cast<uint32>(i);
 
-                static const uint64 skyAttrib = Drawable::Attribute::__SkyBox | Drawable::Attribute::__SkySphere;
+            const auto& modelMat = d->getObject()->getTransform().getMatrix();
 
-                sorted[std::min(2, d->hasAlpha() + ((d->getAttributes() & skyAttrib) != 0) * 2)].push_back(d);
-            }
+            const float dist = glm::distance(glm::vec3(modelMat[3]), view.cameraPosition) * invFar;
+            const uint64 depth = static_cast<uint64>(glm::clamp(dist, 0.f, 1.f) * ns_depthMask);
 
-            std::sort(sorted[0].begin(), sorted[0].end(), [&projInfo](const Drawable* left, const Drawable* right) -> bool
-            {
-                return glm::distance2(left->getObject()->getGlobalPosition(), projInfo.cameraPosition) <
-                       glm::distance2(right->getObject()->getGlobalPosition(), projInfo.cameraPosition);
-            });
+            const uint64 state = m_stateKeys[i];
 
-            std::sort(sorted[1].begin(), sorted[1].end(), [&projInfo](const Drawable* left, const Drawable* right) -> bool
-            {
-                return glm::distance2(left->getObject()->getGlobalPosition(), projInfo.cameraPosition) >
-                       glm::distance2(right->getObject()->getGlobalPosition(), projInfo.cameraPosition);
-            });
+            if (bucket == 2)
+                item.key = (bucket << 62) | ((ns_depthMask - depth) << (ns_stateBits * 3)) | state;
+            else
+                item.key = (bucket << 62) | (state << ns_depthBits) | depth;
 
-            auto drawSet = [&projInfo, &lights](const std::vector<const Drawable*>& set) -> void
-            {
-                for (auto d : set)
-                {
-                    if (d->hasFlag(Drawable::ReceiveLights))
-                    {
-                        LightContainer lightCont;
-
-                        for (auto l : lights)
-                        {
-                            if (lightCont[l->getType()].size() < LightSource::getMaximumLights(l->getType()))
-                                lightCont[l->getType()].push_back(l);
-                        }
-
-                        d->draw(projInfo, lightCont);
-                    }
-                    else
-                        d->draw(projInfo, ns_dummyLightCont);
-                }
-            };
-
-            GlState::setDepthTest(true);
-            GlState::setDepthWrite(true);
-            GlState::setBlendFunc(false);
-            drawSet(sorted[0]);
-            drawSet(sorted[2]);
-
-            GlState::setBlendFunc(true);
-            GlState::setDepthWrite(false);
-            drawSet(sorted[1]);
-            GlState::setDepthWrite(true);
+            items.push_back(item);
+
+            // Derived drawables calculate their own matrices
+            if (typeid(*d) == typeid(Drawable))
+                d->calculateMatrices(projInfo, view.matrices[i]);
         }
     }
 
     //////////////////////////////////////////////
 
-    void SortedRenderPass::bind(const Drawable* drawable)
+    void SortedRenderPass::sortView(View& view) const
     {
-        m_drawables.insert(drawable);
+        auto& items = view.items;
+        items.clear();
+
+        for (auto& chunk : view.chunks)
+            items.insert(items.end(), chunk.begin(), chunk.end());
+
+        const unsigned int unsortedChanges = countChanges(items, nullptr);
+
+        // LSD radix sort, 8 bits per pass. Passes where every
+        // key has the same byte are skipped
+        if (items.size() > 1)
+        {
+            view.sortBuffer.resize(items.size());
+
+            for (unsigned int shift = 0; shift < 64; shift += 8)
+            {
+                std::size_t counts[256] = {0};
+
+                for (auto& i : items)
+                    ++counts[(i.key >> shift) & 0xFF];
+
+                if (counts[(items.front().key >> shift) & 0xFF] == items.size())
+                    continue;
+
+                std::size_t offset = 0;
+
+                for (auto& c : counts)
+                {
+                    const std::size_t count = c;
+                    c = offset;
+                    offset += count;
+                }
+
+                for (auto& i : items)
+                    view.sortBuffer[counts[(i.key >> shift) & 0xFF]++] = i;
+
+                items.swap(view.sortBuffer);
+            }
+        }
+
+        std::fill(std::begin(view.changes), std::end(view.changes), 0);
+        const unsigned int sortedChanges = countChanges(items, view.changes);
+
+        view.avoidedChanges = unsortedChanges > sortedChanges ? unsortedChanges - sortedChanges : 0;
     }
 
     //////////////////////////////////////////////
 
-    void SortedRenderPass::unbind(const Drawable* drawable)
+    void SortedRenderPass::submitView(View& view, const LightContainer& lights, const bool clustered)
     {
-        m_drawables.erase(drawable);
+        auto& rend = getRenderer();
+
+        const auto& target = rend.getRenderTarget();
+        const auto& cam = *view.camera;
+        const auto& items = view.items;
+
+        const Drawable::ProjectionInfo projInfo(view.viewMatrix, view.projectionMatrix, view.cameraPosition, view.inverseViewMatrix);
+
+        static const DynamicSetting<bool> instancingSetting("engine@Graphics|Instancing|bEnabled", true);
+        static const DynamicSetting<unsigned int> minInstancesSetting("engine@Graphics|Instancing|uMinInstances", 2);
+
+        const bool instancing = instancingSetting.value && Mesh::isInstancingSupported();
+        const std::size_t minInstances = std::max(2u, minInstancesSetting.value);
+
+        // Only plain drawables can be instanced, derived types may draw differently
+        auto canInstance = [](const DrawItem& item) -> bool
+        {
+            auto d = item.drawable;
+
+            return (item.key >> 62) == 0 && typeid(*d) == typeid(Drawable) && !d->hasOverrideShader() && d->getMaterial() && d->getMesh();
+        };
+
+        if (!cam.getRenderTexture().bind())
+            target.bind();
+
+        cam.applyViewport(target);
+
+        if (UniformBuffer::isSupported())
+        {
+            projInfo.sendToBlock(rend.m_cameraBlock);
+
+            if (LightContainer::usesUniformBlock())
+                lights.sendToBlock(rend.m_lightBlock, projInfo);
+
+            if (clustered)
+                m_stats.clusteredLights += rend.m_clusterer->build(cam, target, m_clusteredLights);
+        }
+
+        m_stats.drawCalls += static_cast<unsigned int>(items.size());
+        m_stats.shaderChanges += view.changes[0];
+        m_stats.materialChanges += view.changes[1];
+        m_stats.meshChanges += view.changes[2];
+        m_stats.avoidedChanges += view.avoidedChanges;
+
+        uint64 currentBucket = 0;
+
+        GlState::setDepthTest(true);
+        GlState::setDepthWrite(true);
+        GlState::setBlendFunc(false);
+
+        for (std::size_t i = 0; i < items.size();)
+        {
+            auto& item = items[i];
+            const uint64 bucket = item.key >> 62;
+
+            if (bucket == 2 && currentBucket != 2)
+            {
+                GlState::setBlendFunc(true);
+                GlState::setDepthWrite(false);
+            }
+
+            currentBucket = bucket;
+
+            const auto& itemLights = item.drawable->hasFlag(Drawable::ReceiveLights) ? lights : ns_dummyLightCont;
+
+            // Gather a group of consecutive drawables with identical state
+            if (instancing && canInstance(item))
+            {
+                std::size_t end = i + 1;
+
+                while (end < items.size() &&
+                       std::equal(std::begin(item.state), std::end(item.state), std::begin(items[end].state)) &&
+                       item.drawable->hasFlag(Drawable::ReceiveLights) == items[end].drawable->hasFlag(Drawable::ReceiveLights) &&
+                       item.drawable->hasFlag(Drawable::ReceiveShadows) == items[end].drawable->hasFlag(Drawable::ReceiveShadows) &&
+                       canInstance(items[end]))
+                {
+                    ++end;
+                }
+
+                if (end - i >= minInstances)
+                {
+                    m_instances.clear();
+
+                    for (std::size_t j = i; j < end; ++j)
+                        m_instances.push_back(items[j].drawable);
+
+                    Drawable::drawInstanced(projInfo, itemLights, m_instances, m_instanceBuffer);
+
+                    m_stats.instancedDraws += static_cast<unsigned int>(end - i);
+                    ++m_stats.instanceBatches;
+
+                    i = end;
+                    continue;
+                }
+            }
+
+            if (typeid(*item.drawable) == typeid(Drawable))
+                item.drawable->drawPrepared(projInfo, itemLights, view.matrices[item.index]);
+            else
+                item.drawable->draw(projInfo, itemLights);
+
+            ++i;
+        }
+
+        GlState::setDepthWrite(true);
     }
 
     //////////////////////////////////////////////
@@ -243,7 +599,7 @@ namespace jop
         if (!isActive() || m_drawables.empty())
             return;
 
-        const auto& rend = getRenderer();
+        auto& rend = getRenderer();
 
         const auto& target = m_target;
         const auto& cameras = rend.getCameras();
@@ -258,7 +614,8 @@ namespace jop
             if (!cam->isActive() || !cam->getRenderMask())
                 continue;
 
-            const Drawable::ProjectionInfo projInfo(cam->getViewMatrix(), cam->getProjectionMatrix(), cam->getObject()->getGlobalPosition());
+            // The view matrix is the inverse of the camera transformation
+            const Drawable::ProjectionInfo projInfo(cam->getViewMatrix(), cam->getProjectionMatrix(), cam->getObject()->getGlobalPosition(), cam->getObject()->getTransform().getMatrix());
 
             if (!cam->getRenderTexture().bind())
                 target.bind();
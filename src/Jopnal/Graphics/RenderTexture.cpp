@@ -537,6 +537,55 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    bool RenderTexture::bindLayered(const Slot slot) const
+    {
+    #ifndef JOP_OPENGL_ES
+
+        if (isLayeredSupported() && bindDraw())
+        {
+            const auto s = static_cast<int>(slot);
+
+            auto& tex = std::get<1>(m_attachments[s]);
+
+            if (!tex || !tex->isValid())
+            {
+                JOP_DEBUG_ERROR("Failed to bind layered texture to frame buffer, no texture exists");
+                return false;
+            }
+
+            glCheck(glFramebufferTexture(GL_FRAMEBUFFER, ns_attachmentPoint[s], tex->getHandle(), 0));
+
+            return detail::checkFrameBufferStatus();
+        }
+
+    #else
+
+        static_cast<void>(slot);
+
+    #endif
+
+        return false;
+    }
+
+    //////////////////////////////////////////////
+
+    bool RenderTexture::isLayeredSupported()
+    {
+    #ifndef JOP_OPENGL_ES
+
+        static const bool supported = gl::getVersionMajor() > 3 || (gl::getVersionMajor() == 3 && gl::getVersionMinor() >= 2);
+
+        return supported;
+
+    #else
+
+        return false;
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
     void RenderTexture::setSize(const glm::uvec2& size)
     {
         if (!m_size.x && !m_size.y)
@@ -28,10 +28,13 @@
 
     #include <Jopnal/Core/Engine.hpp>
     #include <Jopnal/Core/Object.hpp>
+    #include <Jopnal/Core/Profiler.hpp>
     #include <Jopnal/Core/Scene.hpp>
     #include <Jopnal/Graphics/Camera.hpp>
     #include <Jopnal/Graphics/LightSource.hpp>
     #include <Jopnal/Graphics/EnvironmentRecorder.hpp>
+    #include <Jopnal/Graphics/Culling/FrustumCuller.hpp>
+    #include <Jopnal/Graphics/Culling/LightClusterer.hpp>
 
 #endif
 
@@ -43,15 +46,24 @@ namespace jop
     Renderer::Renderer(const RenderTarget& mainTarget, Scene& sceneRef)
         : m_lights              (),
           m_cameras             (),
+          m_shadowCamera        (nullptr),
+          m_drawables           (),
           m_passes              (),
           m_envRecorders        (),
           m_target              (mainTarget),
-          m_sceneRef            (sceneRef)
+          m_sceneRef            (sceneRef),
+          m_cameraBlock         (),
+          m_lightBlock          (),
+          m_culler              (std::make_unique<detail::FrustumCuller>()),
+          m_clusterer           (std::make_unique<detail::LightClusterer>())
     {
         createRenderPass<SortedRenderPass>(RenderPass::Pass::BeforePost, RenderPass::DefaultWeight);
         createRenderPass<OrderedRenderPass>(RenderPass::Pass::AfterPost, RenderPass::DefaultWeight);
     }
 
+    Renderer::~Renderer()
+    {}
+
     //////////////////////////////////////////////
 
     const RenderTarget& Renderer::getRenderTarget() const
@@ -75,6 +87,29 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    void Renderer::setShadowCamera(const Camera* camera)
+    {
+        m_shadowCamera = camera;
+    }
+
+    //////////////////////////////////////////////
+
+    const Camera* Renderer::getShadowCamera() const
+    {
+        if (m_shadowCamera && m_cameras.count(m_shadowCamera) && m_shadowCamera->isActive() && m_shadowCamera->getRenderMask())
+            return m_shadowCamera;
+
+        for (auto cam : m_cameras)
+        {
+            if (cam->isActive() && cam->getRenderMask())
+                return cam;
+        }
+
+        return nullptr;
+    }
+
+    //////////////////////////////////////////////
+
     void Renderer::bind(const LightSource* light)
     {
         m_lights.insert(light);
@@ -91,6 +126,8 @@ namespace jop
 
     void Renderer::bind(const Drawable* drawable, const RenderPass::Pass pass, const uint32 weight)
     {
+        m_drawables.insert(drawable);
+
         auto& passArr = m_passes[static_cast<int>(pass)];
         auto passItr = passArr.find(weight);
 
@@ -119,12 +156,17 @@ namespace jop
     void Renderer::unbind(const Camera* camera)
     {
         m_cameras.erase(camera);
+
+        if (camera == m_shadowCamera)
+            m_shadowCamera = nullptr;
     }
 
     //////////////////////////////////////////////
 
     void Renderer::unbind(const Drawable* drawable, const RenderPass::Pass pass, const uint32 weight)
     {
+        m_drawables.erase(drawable);
+
         auto& passArr = m_passes[static_cast<int>(pass)];
         auto passItr = passArr.find(weight);
         
@@ -160,9 +202,30 @@ namespace jop
     {
         if (pass == RenderPass::Pass::BeforePost)
         {
+            // Directional light shadow cascades are fitted to a single camera
+            const Camera* mainCamera = getShadowCamera();
+
             // Render shadow maps
             for (auto light : m_lights)
-                light->drawShadowMap();
+            {
+                if (!light->castsShadows() || !light->isActive())
+                    continue;
+
+                JOP_PROFILE_DYNAMIC_SCOPE(Profiler::isEnabled() ? "Shadow map " + light->getObject()->getID() : std::string(), "shadow", Profiler::Type::GPU);
+                light->drawShadowMap(m_drawables, mainCamera);
+            }
+
+            // Find the visible drawables for each camera
+            if (detail::FrustumCuller::cullingEnabled())
+            {
+                m_culler->update();
+
+                for (auto cam : m_cameras)
+                {
+                    if (cam->isActive() && cam->getRenderMask())
+                        m_culler->cull(*cam);
+                }
+            }
 
             // Render environment maps
             /*for (auto envmap : m_envRecorders)
@@ -174,13 +237,9 @@ namespace jop
 
         // Render objects
         for (auto& i : m_passes[static_cast<int>(pass)])
+        {
+            JOP_PROFILE_DYNAMIC_SCOPE(Profiler::isEnabled() ? "RenderPass " + std::to_string(i.first) : std::string(), "render", Profiler::Type::GPU);
             i.second->draw();
-    }
-
-    //////////////////////////////////////////////
-
-    World& Renderer::getCullingWorld()
-    {
-        return m_sceneRef.m_cullingWorld;
+        }
     }
 }
\ No newline at end of file
@@ -97,6 +97,8 @@ namespace jop
                 return *itr->second;
         }
 
+        JOP_PROFILE_SCOPE_CATEGORY("Shader assembly", "resource");
+
         const auto& uber = m_instance->m_uber;
         const std::string shaderName = "jop_shader_" + std::to_string(combinedAttribs);
 
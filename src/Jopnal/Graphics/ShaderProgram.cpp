@@ -36,7 +36,10 @@
     #include <Jopnal/Graphics/ShaderAssembler.hpp>
     #include <Jopnal/Graphics/Texture/Texture.hpp>
     #include <Jopnal/Graphics/Shader.hpp>
+    #include <Jopnal/Graphics/UniformBuffer.hpp>
     #include <glm/gtc/type_ptr.hpp>
+    #include <deque>
+    #include <mutex>
     #include <vector>
 
 #endif
@@ -49,6 +52,22 @@
 namespace
 {
     unsigned int ns_currentProgram = 0;
+
+    // Handle location that hasn't been queried yet
+    const int ns_unresolvedLocation = -2;
+
+    struct UniformNameTable
+    {
+        std::recursive_mutex mutex;
+        std::deque<std::string> names;
+        std::unordered_map<std::string, unsigned int> indices;
+    };
+
+    UniformNameTable& getNameTable()
+    {
+        static UniformNameTable table;
+        return table;
+    }
 }
 
 namespace jop
@@ -74,11 +93,50 @@ namespace jop
         }
     }
 
+    UniformHandle::UniformHandle(const std::string& name)
+        : m_index(0)
+    {
+        auto& table = getNameTable();
+        std::lock_guard<std::recursive_mutex> lock(table.mutex);
+
+        auto itr = table.indices.find(name);
+
+        if (itr == table.indices.end())
+        {
+            itr = table.indices.emplace(name, static_cast<unsigned int>(table.names.size())).first;
+            table.names.push_back(name);
+        }
+
+        m_index = itr->second;
+    }
+
+    //////////////////////////////////////////////
+
+    const std::string& UniformHandle::getName() const
+    {
+        auto& table = getNameTable();
+        std::lock_guard<std::recursive_mutex> lock(table.mutex);
+
+        return table.names[m_index];
+    }
+
+    //////////////////////////////////////////////
+
+    unsigned int UniformHandle::getIndex() const
+    {
+        return m_index;
+    }
+
+
+    //////////////////////////////////////////////
+
+
     ShaderProgram::ShaderProgram(const std::string& name)
-        : Resource      (name),
-          m_shaders     (),
-          m_unifMap     (),
-          m_programID   (0)
+        : Resource          (name),
+          m_shaders         (),
+          m_unifMap         (),
+          m_handleLocations (),
+          m_programID       (0)
     {}
 
     ShaderProgram::~ShaderProgram()
@@ -178,6 +236,14 @@ namespace jop
 
         m_shaders.clear();
 
+        reflectUniforms();
+
+        setUniformBlockBinding("jop_CameraBlock", UniformBuffer::CameraBlock);
+        setUniformBlockBinding("jop_LightBlock", UniformBuffer::LightBlock);
+        setUniformBlockBinding("jop_ClusterLightBlock", UniformBuffer::ClusterLightBlock);
+        setUniformBlockBinding("jop_ClusterGridBlock", UniformBuffer::ClusterGridBlock);
+        setUniformBlockBinding("jop_ClusterIndexBlock", UniformBuffer::ClusterIndexBlock);
+
         return true;
     }
 
@@ -194,6 +260,7 @@ namespace jop
         }
 
         m_unifMap.clear();
+        m_handleLocations.clear();
         m_programID = 0;
     }
 
@@ -384,6 +451,179 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    bool ShaderProgram::setUniform(const UniformHandle& handle, const glm::mat4& matrix)
+    {
+        return setUniform(handle, glm::value_ptr(matrix), 1);
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const UniformHandle& handle, const float* matrices, const unsigned int amount)
+    {
+        const int loc = getUniformLocation(handle);
+
+        if (loc != -1)
+        {
+            glCheck(glUniformMatrix4fv(loc, amount, GL_FALSE, matrices));
+        }
+
+        return loc != -1;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const UniformHandle& handle, const glm::mat3& matrix)
+    {
+        const int loc = getUniformLocation(handle);
+
+        if (loc != -1)
+        {
+            glCheck(glUniformMatrix3fv(loc, 1, GL_FALSE, glm::value_ptr(matrix)));
+        }
+
+        return loc != -1;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const UniformHandle& handle, const glm::vec2& vector)
+    {
+        const int loc = getUniformLocation(handle);
+
+        if (loc != -1)
+        {
+            glCheck(glUniform2f(loc, vector.x, vector.y));
+        }
+
+        return loc != -1;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const UniformHandle& handle, const glm::vec3& vector)
+    {
+        const int loc = getUniformLocation(handle);
+
+        if (loc != -1)
+        {
+            glCheck(glUniform3f(loc, vector.x, vector.y, vector.z));
+        }
+
+        return loc != -1;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const UniformHandle& handle, const glm::vec4& vector)
+    {
+        const int loc = getUniformLocation(handle);
+
+        if (loc != -1)
+        {
+            glCheck(glUniform4f(loc, vector.x, vector.y, vector.z, vector.w));
+        }
+
+        return loc != -1;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const UniformHandle& handle, const Texture& texture, const unsigned int unit)
+    {
+        const int loc = getUniformLocation(handle);
+
+        if (loc != -1)
+        {
+            texture.bind(unit);
+            glCheck(glUniform1i(loc, static_cast<int>(unit)));
+        }
+
+        return loc != -1;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const UniformHandle& handle, const float value)
+    {
+        const int loc = getUniformLocation(handle);
+
+        if (loc != -1)
+        {
+            glCheck(glUniform1f(loc, value));
+        }
+
+        return loc != -1;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const UniformHandle& handle, const int value)
+    {
+        const int loc = getUniformLocation(handle);
+
+        if (loc != -1)
+        {
+            glCheck(glUniform1i(loc, value));
+        }
+
+        return loc != -1;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniform(const UniformHandle& handle, const bool value)
+    {
+        return setUniform(handle, value ? 1 : 0);
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::hasUniform(const UniformHandle& handle)
+    {
+        if (!isValid())
+            return false;
+
+        const unsigned int index = handle.getIndex();
+
+        if (index >= m_handleLocations.size() || m_handleLocations[index] == ns_unresolvedLocation)
+        {
+            auto itr = m_unifMap.find(handle.getName());
+            return itr != m_unifMap.end() && itr->second != -1;
+        }
+
+        return m_handleLocations[index] != -1;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ShaderProgram::setUniformBlockBinding(const std::string& blockName, const unsigned int binding)
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        if (!isValid() || !UniformBuffer::isSupported())
+            return false;
+
+        const GLuint index = glCheck(glGetUniformBlockIndex(m_programID, blockName.c_str()));
+
+        if (index == GL_INVALID_INDEX)
+            return false;
+
+        glCheck(glUniformBlockBinding(m_programID, index, binding));
+
+        return true;
+
+    #else
+
+        static_cast<void>(blockName);
+        static_cast<void>(binding);
+
+        return false;
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
     ShaderProgram& ShaderProgram::getDefault()
     {
         static WeakReference<ShaderProgram> defShader;
@@ -464,4 +704,76 @@ namespace jop
 
         return -1;
     }
+
+    //////////////////////////////////////////////
+
+    int ShaderProgram::getUniformLocation(const UniformHandle& handle)
+    {
+        if (bind())
+        {
+            const unsigned int index = handle.getIndex();
+
+            if (index >= m_handleLocations.size())
+                m_handleLocations.resize(index + 1, ns_unresolvedLocation);
+
+            int& location = m_handleLocations[index];
+
+            // Resolved only once per program. Missing uniforms get cached
+            // as well, so that they don't get queried again on every draw
+            if (location == ns_unresolvedLocation)
+                location = getUniformLocation(handle.getName());
+
+            return location;
+        }
+
+        return -1;
+    }
+
+    //////////////////////////////////////////////
+
+    void ShaderProgram::reflectUniforms()
+    {
+        GLint count = 0, maxLength = 0;
+        glCheck(glGetProgramiv(m_programID, GL_ACTIVE_UNIFORMS, &count));
+        glCheck(glGetProgramiv(m_programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength));
+
+        if (count <= 0 || maxLength <= 0)
+            return;
+
+        std::vector<GLchar> nameBuffer(maxLength);
+
+        for (GLint i = 0; i < count; ++i)
+        {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glCheck(glGetActiveUniform(m_programID, static_cast<GLuint>(i), maxLength, &length, &size, &type, nameBuffer.data()));
+
+            std::string name(nameBuffer.data(), length);
+
+            // Uniforms inside blocks don't have a location
+            const int location = glCheck(glGetUniformLocation(m_programID, name.c_str()));
+
+            if (location == -1)
+                continue;
+
+            m_unifMap[name] = location;
+
+            // Arrays of basic types are only reported by their first element,
+            // so the rest need to be queried separately
+            const std::size_t bracket = name.rfind("[0]");
+
+            if (bracket != std::string::npos && bracket + 3 == name.length())
+            {
+                const std::string base = name.substr(0, bracket);
+                m_unifMap[base] = location;
+
+                for (GLint j = 1; j < size; ++j)
+                {
+                    const std::string element = base + "[" + std::to_string(j) + "]";
+                    m_unifMap[element] = glCheck(glGetUniformLocation(m_programID, element.c_str()));
+                }
+            }
+        }
+    }
 }
\ No newline at end of file
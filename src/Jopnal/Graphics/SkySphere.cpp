@@ -70,7 +70,9 @@ namespace jop
 
         // Uniforms
         {
-            shdr.setUniform("u_PVMMatrix", proj.projectionMatrix * glm::mat4(glm::mat3(proj.viewMatrix)));
+            static const UniformHandle pvmHandle("u_PVMMatrix");
+
+            shdr.setUniform(pvmHandle, proj.projectionMatrix * glm::mat4(glm::mat3(proj.viewMatrix)));
 
             m_material.sendToShader(shdr);
 
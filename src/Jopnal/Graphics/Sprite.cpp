@@ -69,13 +69,16 @@ namespace jop
     {
         // Uniforms
         {
+            static const UniformHandle pvmHandle("u_PVMMatrix");
+            static const UniformHandle diffuseHandle("u_DiffuseMap");
+
             auto& tex = getTexture();
 
             auto& shdr = getShader();
             auto& modelMat = getObject()->getTransform().getMatrix();
 
-            shdr.setUniform("u_PVMMatrix", proj.projectionMatrix * proj.viewMatrix * modelMat);
-            shdr.setUniform("u_DiffuseMap", tex, static_cast<unsigned int>(Material::Map::Diffuse0));
+            shdr.setUniform(pvmHandle, proj.projectionMatrix * proj.viewMatrix * modelMat);
+            shdr.setUniform(diffuseHandle, tex, static_cast<unsigned int>(Material::Map::Diffuse0));
 
             glCheck(glVertexAttrib4fv(Mesh::VertexIndex::Color, &getColor().colors[0]));
         }
@@ -0,0 +1,146 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Graphics/UniformBuffer.hpp>
+
+    #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
+    #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    UniformBuffer::UniformBuffer(const Usage usage)
+        : Buffer(Type::UniformBuffer, usage)
+    {}
+
+    //////////////////////////////////////////////
+
+    void UniformBuffer::setData(const void* data, const std::size_t bytes)
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        if (bytes && data)
+        {
+            bind();
+
+            // Orphan the old storage
+            glCheck(glBufferData(m_bufferType, bytes, NULL, m_usage));
+            glCheck(glBufferSubData(m_bufferType, 0, bytes, data));
+
+            m_bytesAllocated = bytes;
+        }
+
+    #else
+
+        static_cast<void>(data);
+        static_cast<void>(bytes);
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
+    void UniformBuffer::setSubData(const void* data, const std::size_t offset, const std::size_t size)
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        if (data && size && (offset + size) <= m_bytesAllocated)
+        {
+            bind();
+            glCheck(glBufferSubData(m_bufferType, offset, size, data));
+        }
+
+    #else
+
+        static_cast<void>(data);
+        static_cast<void>(offset);
+        static_cast<void>(size);
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
+    void UniformBuffer::bindBase(const unsigned int binding) const
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        if (m_buffer)
+        {
+            glCheck(glBindBufferBase(m_bufferType, binding, m_buffer));
+        }
+
+    #else
+
+        static_cast<void>(binding);
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
+    bool UniformBuffer::isSupported()
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        static const bool supported = gl::es ? gl::getVersionMajor() >= 3 :
+                                               (gl::getVersionMajor() > 3 || (gl::getVersionMajor() == 3 && gl::getVersionMinor() >= 1));
+
+        return supported;
+
+    #else
+
+        return false;
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
+    unsigned int UniformBuffer::getMaximumSize()
+    {
+    #if !defined(JOP_OPENGL_ES) || defined(JOP_OPENGL_ES3)
+
+        static unsigned int size = 0;
+
+        if (!size && isSupported())
+        {
+            glCheck(glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, reinterpret_cast<GLint*>(&size)));
+        }
+
+        return size;
+
+    #else
+
+        return 0;
+
+    #endif
+    }
+}
\ No newline at end of file
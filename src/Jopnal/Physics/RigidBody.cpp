@@ -381,7 +381,7 @@ namespace jop
 
     Message::Result RigidBody::receiveMessage(const Message& message)
     {
-        if (JOP_EXECUTE_COMMAND(RigidBody, message.getString(), this) == Message::Result::Escape)
+        if (JOP_EXECUTE_COMMAND(RigidBody, message, this) == Message::Result::Escape)
             return Message::Result::Escape;
 
         return Component::receiveMessage(message);
@@ -27,6 +27,7 @@
     #include <Jopnal/Physics/World.hpp>
 
     #include <Jopnal/Core/Object.hpp>   
+    #include <Jopnal/Core/Engine.hpp>
     #include <Jopnal/Core/SettingManager.hpp>
     #include <Jopnal/Core/DebugHandler.hpp>
     #include <Jopnal/Core/ResourceManager.hpp>
@@ -369,8 +370,12 @@ namespace jop
             {*val = 1.f / value;}
 
         } cb(&timeStep, str);
-        
-        m_worldData->world->stepSimulation(deltaTime, 10, timeStep);
+
+        // The engine already updates at a fixed rate, no need to sub-step
+        if (Engine::fixedTimestepEnabled())
+            m_worldData->world->stepSimulation(deltaTime, 0);
+        else
+            m_worldData->world->stepSimulation(deltaTime, 10, timeStep);
     }
 
     //////////////////////////////////////////////
@@ -533,7 +538,7 @@ namespace jop
 
     Message::Result World::receiveMessage(const Message& message)
     {
-        if (JOP_EXECUTE_COMMAND(World, message.getString(), this) == Message::Result::Escape)
+        if (JOP_EXECUTE_COMMAND(World, message, this) == Message::Result::Escape)
             return Message::Result::Escape;
 
         return Component::receiveMessage(message);
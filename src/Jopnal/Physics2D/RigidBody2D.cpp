@@ -329,7 +329,7 @@ namespace jop
 
     Message::Result RigidBody2D::receiveMessage(const Message& message)
     {
-        if (JOP_EXECUTE_COMMAND(RigidBody2D, message.getString(), this) == Message::Result::Escape)
+        if (JOP_EXECUTE_COMMAND(RigidBody2D, message, this) == Message::Result::Escape)
             return Message::Result::Escape;
 
         return Component::receiveMessage(message);
@@ -26,6 +26,7 @@
 
     #include <Jopnal/Physics2D/World2D.hpp>
 
+    #include <Jopnal/Core/Engine.hpp>
     #include <Jopnal/Core/ResourceManager.hpp>
     #include <Jopnal/Core/SettingManager.hpp>
     #include <Jopnal/Graphics/Camera.hpp>
@@ -279,6 +280,15 @@ namespace jop
             }
         } cb(&timeStep, str);
 
+        // The engine already updates at a fixed rate, no need to sub-step
+        if (Engine::fixedTimestepEnabled())
+        {
+            m_worldData2D->Step(deltaTime, 8, 3);
+            m_worldData2D->ClearForces();
+
+            return;
+        }
+
         m_step = std::min(0.1f, m_step + deltaTime);
 
         while (m_step >= timeStep)
@@ -441,7 +451,7 @@ namespace jop
 
     Message::Result World2D::receiveMessage(const Message& message)
     {
-        if (JOP_EXECUTE_COMMAND(World2D, message.getString(), this) == Message::Result::Escape)
+        if (JOP_EXECUTE_COMMAND(World2D, message, this) == Message::Result::Escape)
             return Message::Result::Escape;
 
         return Component::receiveMessage(message);
@@ -109,6 +109,12 @@
 #include <cstring>
 #include <set>
 #include <queue>
+#include <iomanip>
+#include <typeindex>
+
+#if defined(__GNUG__)
+    #include <cxxabi.h>
+#endif
 
 // Additional STL header
 #include <Jopnal/STL.hpp>
@@ -117,11 +123,14 @@
 #include <Jopnal/Jopnal.hpp>
 
 // Implementation classes
+#include <Jopnal/Core/ObjectPool.hpp>
+#include <Jopnal/Core/TransformHierarchy.hpp>
 #include <Jopnal/Physics/Detail/WorldImpl.hpp>
 #include <Jopnal/Audio/AlTry.hpp>
 #include <Jopnal/Audio/AudioReader.hpp>
 #include <Jopnal/Window/SensorManager.hpp>
 #include <Jopnal/Window/InputEnumsImpl.hpp>
-#include <Jopnal/Graphics/Culling/CullerComponent.hpp>
+#include <Jopnal/Graphics/Culling/FrustumCuller.hpp>
+#include <Jopnal/Graphics/Culling/LightClusterer.hpp>
 
 #endif
\ No newline at end of file
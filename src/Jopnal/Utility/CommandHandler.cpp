@@ -27,6 +27,7 @@
     #include <Jopnal/Utility/CommandHandler.hpp>
 
     #include <Jopnal/Core/DebugHandler.hpp>
+    #include <Jopnal/Utility/Interner.hpp>
     #include <cctype>
 
 #endif
@@ -36,7 +37,17 @@
 
 namespace
 {
-    void handleCommand(const std::string& orig, std::string& command, std::string& args)
+    jop::Interner& getCommands()
+    {
+        // Leaked on purpose, command handlers are registered during static initialization
+        static jop::Interner* commands = new jop::Interner;
+        return *commands;
+    }
+}
+
+namespace jop
+{
+    void detail::splitCommand(const std::string& orig, std::string& command, std::string& args)
     {
         std::size_t commandStart = orig.find_first_not_of("     \r\n");
         std::size_t commandEnd = orig.find_first_of("     \r\n", commandStart);
@@ -50,10 +61,9 @@ namespace
         command = (commandLen > 0) ? orig.substr(commandStart, commandLen) : "";
         args = (commandLen > 0) ? orig.substr(argStart, argLen) : "";
     }
-}
 
-namespace jop
-{
+    //////////////////////////////////////////////
+
     std::tuple<std::string, std::string> detail::splitFirstArguments(const std::string& args)
     {
         std::size_t pos1 = 0, pos2 = 0, pos3;
@@ -103,27 +113,92 @@ namespace jop
     Message::Result CommandHandler::execute(const std::string& command, void* instance)
     {
         std::string comm, args;
-        handleCommand(command, comm, args);
+        detail::splitCommand(command, comm, args);
+
+        const uint32 ID = findCommandID(comm);
+
+        if (!ID)
+            return Message::Result::Continue;
 
         {
-            auto itr = m_funcParsers.find(comm);
+            auto itr = m_funcParsers.find(ID);
             if (itr != m_funcParsers.end())
             {
-                itr->second.first(args);
-                return itr->second.second;
+                itr->second.parser(args);
+                return itr->second.result;
             }
         }
 
         if (instance)
         {
-            auto itr = m_memberParsers.find(comm);
+            auto itr = m_memberParsers.find(ID);
             if (itr != m_memberParsers.end())
             {
-                itr->second.first(args, instance);
-                itr->second.second;
+                itr->second.parser(args, instance);
+                return itr->second.result;
             }
         }
 
         return Message::Result::Continue;
     }
+
+    //////////////////////////////////////////////
+
+    Message::Result CommandHandler::execute(const Message& message, void* instance)
+    {
+        const uint32 ID = message.getCommandID();
+
+        if (!ID)
+            return Message::Result::Continue;
+
+        auto typeMismatch = [&message]()
+        {
+            JOP_DEBUG_WARNING("Typed arguments of message \"" << message.getString() << "\" don't match the bound function, the command was not executed");
+        };
+
+        {
+            auto itr = m_funcParsers.find(ID);
+            if (itr != m_funcParsers.end())
+            {
+                if (!message.hasTypedArguments())
+                    itr->second.parser(message.getArguments());
+
+                else if (!itr->second.invoker || !itr->second.invoker(message))
+                    typeMismatch();
+
+                return itr->second.result;
+            }
+        }
+
+        if (instance)
+        {
+            auto itr = m_memberParsers.find(ID);
+            if (itr != m_memberParsers.end())
+            {
+                if (!message.hasTypedArguments())
+                    itr->second.parser(message.getArguments(), instance);
+
+                else if (!itr->second.invoker || !itr->second.invoker(message, instance))
+                    typeMismatch();
+
+                return itr->second.result;
+            }
+        }
+
+        return Message::Result::Continue;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 CommandHandler::getCommandID(const std::string& command)
+    {
+        return getCommands().intern(command);
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 CommandHandler::findCommandID(const std::string& command)
+    {
+        return getCommands().find(command);
+    }
 }
\ No newline at end of file
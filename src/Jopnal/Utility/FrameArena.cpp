@@ -0,0 +1,320 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Utility/FrameArena.hpp>
+
+    #include <algorithm>
+    #include <atomic>
+    #include <cstdlib>
+    #include <mutex>
+    #include <new>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    const std::size_t ns_alignment = alignof(std::max_align_t);
+    const std::size_t ns_minBlockSize = 64 * 1024;
+
+    // Constant initialized, so that it's valid before any allocations are made
+    std::atomic<jop::uint64> ns_heapAllocations(0);
+
+    struct Block
+    {
+        char* data;
+        std::size_t size;
+        std::atomic<std::size_t> offset;
+
+        explicit Block(const std::size_t blockSize)
+            : data      (static_cast<char*>(::operator new(blockSize))),
+              size      (blockSize),
+              offset    (0)
+        {}
+
+        ~Block()
+        {
+            ::operator delete(data);
+        }
+
+        std::size_t getUsed() const
+        {
+            return std::min(size, offset.load(std::memory_order_relaxed));
+        }
+    };
+
+    struct ArenaState
+    {
+        std::atomic<Block*> current;
+        std::vector<Block*> full;
+        std::mutex mutex;
+        jop::uint64 lastHeapAllocations;
+
+        ArenaState()
+            : current               (nullptr),
+              full                  (),
+              mutex                 (),
+              lastHeapAllocations   (0)
+        {}
+
+        ~ArenaState()
+        {
+            for (auto i : full)
+                delete i;
+
+            delete current.load();
+        }
+    };
+
+    ArenaState& getState()
+    {
+        static ArenaState state;
+        return state;
+    }
+}
+
+namespace jop
+{
+    void* FrameArena::allocate(const std::size_t size)
+    {
+        // Every allocation is rounded up, which keeps the offsets aligned
+        const std::size_t alignedSize = std::max(ns_alignment, (size + ns_alignment - 1) & ~(ns_alignment - 1));
+
+        auto& s = getState();
+
+        for (;;)
+        {
+            Block* block = s.current.load(std::memory_order_acquire);
+
+            if (block)
+            {
+                const std::size_t offset = block->offset.fetch_add(alignedSize, std::memory_order_relaxed);
+
+                if (offset + alignedSize <= block->size)
+                    return block->data + offset;
+            }
+
+            std::lock_guard<std::mutex> lock(s.mutex);
+
+            // Another thread may have replaced the block already
+            if (s.current.load(std::memory_order_relaxed) != block)
+                continue;
+
+            std::size_t blockSize = ns_minBlockSize;
+
+            if (block)
+            {
+                s.full.push_back(block);
+                blockSize = block->size * 2;
+            }
+
+            s.current.store(new Block(std::max(blockSize, alignedSize)), std::memory_order_release);
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void FrameArena::reset()
+    {
+        auto& s = getState();
+        Block* block = s.current.load(std::memory_order_relaxed);
+
+        if (!s.full.empty())
+        {
+            // Merge the blocks, so that the next frame fits in one
+            std::size_t size = block->size;
+
+            for (auto i : s.full)
+            {
+                size += i->size;
+                delete i;
+            }
+
+            s.full.clear();
+            delete block;
+
+            s.current.store(new Block(size), std::memory_order_release);
+        }
+        else if (block)
+            block->offset.store(0, std::memory_order_relaxed);
+
+        s.lastHeapAllocations = ns_heapAllocations.exchange(0, std::memory_order_relaxed);
+    }
+
+    //////////////////////////////////////////////
+
+    std::size_t FrameArena::getUsedSize()
+    {
+        auto& s = getState();
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        std::size_t used = 0;
+
+        for (auto i : s.full)
+            used += i->getUsed();
+
+        if (auto block = s.current.load(std::memory_order_acquire))
+            used += block->getUsed();
+
+        return used;
+    }
+
+    //////////////////////////////////////////////
+
+    std::size_t FrameArena::getCapacity()
+    {
+        auto& s = getState();
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        std::size_t capacity = 0;
+
+        for (auto i : s.full)
+            capacity += i->size;
+
+        if (auto block = s.current.load(std::memory_order_acquire))
+            capacity += block->size;
+
+        return capacity;
+    }
+
+    //////////////////////////////////////////////
+
+    uint64 FrameArena::getHeapAllocations()
+    {
+        return getState().lastHeapAllocations;
+    }
+}
+
+#ifdef JOP_TRACK_HEAP_ALLOCATIONS
+
+    namespace
+    {
+        void* trackedAllocate(std::size_t size)
+        {
+            ns_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+
+            if (size == 0)
+                size = 1;
+
+            void* ptr = nullptr;
+
+            while (!(ptr = std::malloc(size)))
+            {
+                auto handler = std::get_new_handler();
+
+                if (!handler)
+                    return nullptr;
+
+                handler();
+            }
+
+            return ptr;
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void* operator new(std::size_t size)
+    {
+        if (void* ptr = trackedAllocate(size))
+            return ptr;
+
+        throw std::bad_alloc();
+    }
+
+    //////////////////////////////////////////////
+
+    void* operator new[](std::size_t size)
+    {
+        return ::operator new(size);
+    }
+
+    //////////////////////////////////////////////
+
+    void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+    {
+        try
+        {
+            return trackedAllocate(size);
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+    {
+        return ::operator new(size, tag);
+    }
+
+    //////////////////////////////////////////////
+
+    void operator delete(void* ptr) noexcept
+    {
+        std::free(ptr);
+    }
+
+    //////////////////////////////////////////////
+
+    void operator delete[](void* ptr) noexcept
+    {
+        std::free(ptr);
+    }
+
+    //////////////////////////////////////////////
+
+    void operator delete(void* ptr, std::size_t) noexcept
+    {
+        std::free(ptr);
+    }
+
+    //////////////////////////////////////////////
+
+    void operator delete[](void* ptr, std::size_t) noexcept
+    {
+        std::free(ptr);
+    }
+
+    //////////////////////////////////////////////
+
+    void operator delete(void* ptr, const std::nothrow_t&) noexcept
+    {
+        std::free(ptr);
+    }
+
+    //////////////////////////////////////////////
+
+    void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+    {
+        std::free(ptr);
+    }
+
+#endif
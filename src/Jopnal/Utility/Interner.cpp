@@ -0,0 +1,106 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Utility/Interner.hpp>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace jop
+{
+    Interner::Interner()
+        : m_mutex   (),
+          m_IDs     (),
+          m_strings ()
+    {}
+
+    //////////////////////////////////////////////
+
+    uint32 Interner::intern(const std::string& str)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto itr = m_IDs.find(str);
+
+        if (itr != m_IDs.end())
+            return itr->second;
+
+        itr = m_IDs.emplace(str, static_cast<uint32>(m_strings.size() + 1)).first;
+        m_strings.push_back(&itr->first);
+
+        return itr->second;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 Interner::find(const std::string& str) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto itr = m_IDs.find(str);
+
+        return itr != m_IDs.end() ? itr->second : 0;
+    }
+
+    //////////////////////////////////////////////
+
+    const std::string& Interner::getString(const uint32 ID) const
+    {
+        static const std::string empty;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return ID > 0 && ID <= m_strings.size() ? *m_strings[ID - 1] : empty;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 Interner::getSize() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return static_cast<uint32>(m_strings.size());
+    }
+
+    //////////////////////////////////////////////
+
+    Interner& Interner::getTags()
+    {
+        // Leaked on purpose, objects may be destroyed during static destruction
+        static Interner* tags = new Interner;
+        return *tags;
+    }
+
+    //////////////////////////////////////////////
+
+    Interner& Interner::getIDs()
+    {
+        static Interner* IDs = new Interner;
+        return *IDs;
+    }
+}
\ No newline at end of file
@@ -27,6 +27,8 @@
     #include <Jopnal/Utility/Message.hpp>
 
     #include <Jopnal/Core/DebugHandler.hpp>
+    #include <Jopnal/Utility/CommandHandler.hpp>
+    #include <Jopnal/Utility/Interner.hpp>
 
 #endif
 
@@ -39,9 +41,17 @@ namespace jop
         : m_command         (),
           m_commandStr      (),
           m_idPattern       (),
+          m_tags            (),
+          m_idKey           (0),
+          m_allTags         (false),
           m_filterBits      (Filter::Global),
           m_idMatchMethod   (nullptr),
-          m_tagMatchMethod  (nullptr)
+          m_tagMatchMethod  (nullptr),
+          m_typedArgs       (),
+          m_typedArgsType   (nullptr),
+          m_args            (),
+          m_commandID       (0),
+          m_parsed          (false)
     {
         if (!message.empty())
         {
@@ -91,6 +101,29 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    bool Message::hasTypedArguments() const
+    {
+        return m_typedArgsType != nullptr;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32 Message::getCommandID() const
+    {
+        parseCommand();
+        return m_commandID;
+    }
+
+    //////////////////////////////////////////////
+
+    const std::string& Message::getArguments() const
+    {
+        parseCommand();
+        return m_args;
+    }
+
+    //////////////////////////////////////////////
+
     bool Message::passFilter(const unsigned short filter) const
     {
         return (m_filterBits & filter) != 0;
@@ -108,7 +141,7 @@ namespace jop
 
     //////////////////////////////////////////////
 
-    bool Message::passFilter(const std::unordered_set<std::string>& tags) const
+    bool Message::passFilter(const std::vector<uint32>& tags) const
     {
         if (!m_tagMatchMethod)
             return true;
@@ -118,10 +151,34 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    uint32 Message::getIDKey() const
+    {
+        return m_idKey;
+    }
+
+    //////////////////////////////////////////////
+
+    const std::vector<uint32>& Message::getTagFilter() const
+    {
+        static const std::vector<uint32> empty;
+
+        return m_tagMatchMethod ? m_tags : empty;
+    }
+
+    //////////////////////////////////////////////
+
+    bool Message::requiresAllTags() const
+    {
+        return m_allTags;
+    }
+
+    //////////////////////////////////////////////
+
     Message& Message::setFilter(const std::string& filter)
     {
         m_filterBits = Filter::Global;
         m_idPattern = "";
+        m_idKey = 0;
 
         if (filter.empty() || filter[0] != '[')
             return *this;
@@ -143,40 +200,47 @@ namespace jop
             {
                 if (filter[nextPos] == ',')
                 {
-                    m_tags.insert(filter.substr(nextPos + 1, fBegin - nextPos - 1));
+                    m_tags.push_back(Interner::getTags().intern(filter.substr(nextPos + 1, fBegin - nextPos - 1)));
                     fBegin = nextPos;
                 }
                 else if (filter[nextPos] == '(' || filter[nextPos] == '<')
                 {
-                    m_tags.insert(filter.substr(nextPos + 1, fBegin - nextPos - 1));
+                    m_tags.push_back(Interner::getTags().intern(filter.substr(nextPos + 1, fBegin - nextPos - 1)));
 
                     if (filter[nextPos] == '(')
-                        m_tagMatchMethod = [](const std::unordered_set<std::string>& objTags, const std::unordered_set<std::string>& tags) -> bool
+                        m_tagMatchMethod = [](const std::vector<uint32>& objTags, const std::vector<uint32>& tags) -> bool
                         {
-                            for (auto& i : tags)
+                            for (auto i : tags)
                             {
-                                if (objTags.find(i) != objTags.end())
+                                if (std::binary_search(objTags.begin(), objTags.end(), i))
                                     return true;
                             }
 
                             return false;
                         };
                     else
-                        m_tagMatchMethod = [](const std::unordered_set<std::string>& objTags, const std::unordered_set<std::string>& tags) -> bool
+                    {
+                        m_tagMatchMethod = [](const std::vector<uint32>& objTags, const std::vector<uint32>& tags) -> bool
                         {
-                            for (auto& i : tags)
+                            for (auto i : tags)
                             {
-                                if (objTags.find(i) == objTags.end())
+                                if (!std::binary_search(objTags.begin(), objTags.end(), i))
                                     return false;
                             }
 
                             return true;
                         };
 
+                        m_allTags = true;
+                    }
+
                     break;
                 }
             }
 
+            std::sort(m_tags.begin(), m_tags.end());
+            m_tags.erase(std::unique(m_tags.begin(), m_tags.end()), m_tags.end());
+
             if (nextPos == std::string::npos)
             {
                 JOP_DEBUG_ERROR("Message filter tag brackets unmatched. Message: \"" << m_command.str() << "\"");
@@ -200,6 +264,10 @@ namespace jop
                 };
 
             m_idPattern = filter.substr(fBegin + 1, endPos - fBegin - 1);
+
+            // Exact ids can be compared & looked up by their keys
+            if (filter[fBegin] == '=')
+                m_idKey = Interner::getIDs().intern(m_idPattern);
         }
 
         // System filters
@@ -234,4 +302,18 @@ namespace jop
     {
         return m_command.rdbuf()->in_avail() > 0;
     }
+
+    //////////////////////////////////////////////
+
+    void Message::parseCommand() const
+    {
+        if (!m_parsed)
+        {
+            std::string command;
+            detail::splitCommand(getString(), command, m_args);
+
+            m_commandID = CommandHandler::findCommandID(command);
+            m_parsed = true;
+        }
+    }
 }
\ No newline at end of file
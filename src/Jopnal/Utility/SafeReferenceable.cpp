@@ -0,0 +1,102 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Utility/SafeReferenceable.hpp>
+
+    #include <Jopnal/Core/DebugHandler.hpp>
+    #include <mutex>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    // Never destroyed, objects may still be released during static destruction
+    std::mutex& getMutex()
+    {
+        static std::mutex* mutex = new std::mutex;
+        return *mutex;
+    }
+
+    jop::uint32 ns_size = 0;
+    jop::uint32 ns_freeHead = jop::detail::HandleTable::InvalidIndex;
+}
+
+namespace jop { namespace detail
+{
+    std::atomic<HandleTable::Slot*> HandleTable::ms_pages[HandleTable::PageCount];
+
+    //////////////////////////////////////////////
+
+    uint32 HandleTable::allocate(void* object)
+    {
+        std::lock_guard<std::mutex> lock(getMutex());
+
+        uint32 index = ns_freeHead;
+
+        if (index != InvalidIndex)
+            ns_freeHead = find(index)->nextFree;
+        else
+        {
+            if (ns_size == PageSize * PageCount)
+            {
+                JOP_DEBUG_ERROR("Handle table is full, object will not be referenceable");
+                return InvalidIndex;
+            }
+
+            index = ns_size++;
+
+            // Pages are never freed, so that slots can be looked up without locking
+            if ((index & (PageSize - 1)) == 0)
+                ms_pages[index >> PageShift].store(new Slot[PageSize](), std::memory_order_release);
+        }
+
+        // A reader that sees the new object must also see the generation
+        // that was bumped when the slot was last released
+        auto& slot = *find(index);
+        slot.object.store(object, std::memory_order_release);
+        slot.generation.store(slot.generation.load(std::memory_order_relaxed), std::memory_order_release);
+        slot.nextFree = InvalidIndex;
+
+        return index;
+    }
+
+    //////////////////////////////////////////////
+
+    void HandleTable::release(const uint32 index)
+    {
+        std::lock_guard<std::mutex> lock(getMutex());
+
+        auto& slot = *find(index);
+        slot.generation.fetch_add(1, std::memory_order_release);
+        slot.object.store(nullptr, std::memory_order_relaxed);
+        slot.nextFree = ns_freeHead;
+
+        ns_freeHead = index;
+    }
+}}
\ No newline at end of file
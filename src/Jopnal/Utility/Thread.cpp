@@ -109,6 +109,13 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    bool Thread::setAffinity(const uint64 mask)
+    {
+        return detail::ThreadDetail::setAffinity(m_thread, mask);
+    }
+
+    //////////////////////////////////////////////
+
     void Thread::terminate()
     {
         detail::ThreadDetail::terminate(m_thread);
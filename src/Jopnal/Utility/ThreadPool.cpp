@@ -0,0 +1,509 @@
+// Jopnal Engine C++ Library
+// Copyright (c) 2016 Team Jopnal
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+//////////////////////////////////////////////
+
+// Headers
+#include JOP_PRECOMPILED_HEADER_FILE
+
+#ifndef JOP_PRECOMPILED_HEADER
+
+    #include <Jopnal/Utility/ThreadPool.hpp>
+
+    #include <Jopnal/Core/DebugHandler.hpp>
+    #include <Jopnal/Core/SettingManager.hpp>
+    #include <Jopnal/STL.hpp>
+    #include <algorithm>
+
+#endif
+
+//////////////////////////////////////////////
+
+
+namespace
+{
+    // The pool & deque index of the calling worker thread
+    thread_local const void* ns_pool = nullptr;
+    thread_local std::size_t ns_worker = 0;
+
+    // Single object allocations are recycled through a free list, so that
+    // tasks don't go to the heap once the pool has warmed up
+    template<typename T>
+    struct TaskAllocator
+    {
+        typedef T value_type;
+
+        struct FreeList
+        {
+            std::mutex mutex;
+            std::vector<void*> blocks;
+        };
+
+        TaskAllocator() = default;
+
+        template<typename U>
+        TaskAllocator(const TaskAllocator<U>&)
+        {}
+
+        T* allocate(const std::size_t count)
+        {
+            if (count == 1)
+            {
+                auto& list = getFreeList();
+                std::lock_guard<std::mutex> lock(list.mutex);
+
+                if (!list.blocks.empty())
+                {
+                    void* block = list.blocks.back();
+                    list.blocks.pop_back();
+
+                    return static_cast<T*>(block);
+                }
+            }
+
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, const std::size_t count)
+        {
+            if (count == 1)
+            {
+                auto& list = getFreeList();
+                std::lock_guard<std::mutex> lock(list.mutex);
+
+                list.blocks.push_back(ptr);
+                return;
+            }
+
+            ::operator delete(ptr);
+        }
+
+        static FreeList& getFreeList()
+        {
+            // Never destroyed, tasks may be released during static destruction
+            static FreeList* list = new FreeList();
+            return *list;
+        }
+    };
+
+    template<typename T, typename U>
+    bool operator ==(const TaskAllocator<T>&, const TaskAllocator<U>&)
+    {
+        return true;
+    }
+
+    template<typename T, typename U>
+    bool operator !=(const TaskAllocator<T>&, const TaskAllocator<U>&)
+    {
+        return false;
+    }
+}
+
+namespace jop
+{
+    struct ThreadPool::Task
+    {
+        Task(TaskFunc&& taskFunc)
+            : func          (std::move(taskFunc)),
+              rangeFunc     (nullptr),
+              rangeInvoker  (nullptr),
+              begin         (0),
+              end           (0),
+              remaining     (nullptr),
+              dependencies  (1),
+              done          (false),
+              mutex         (),
+              dependents    ()
+        {}
+
+        Task(const void* range, RangeInvoker invoker, const std::size_t rangeBegin, const std::size_t rangeEnd, std::atomic<std::size_t>& remainingChunks)
+            : func          (),
+              rangeFunc     (range),
+              rangeInvoker  (invoker),
+              begin         (rangeBegin),
+              end           (rangeEnd),
+              remaining     (&remainingChunks),
+              dependencies  (1),
+              done          (false),
+              mutex         (),
+              dependents    ()
+        {}
+
+        TaskFunc func;                          ///< The task function. Empty for parallelFor() chunks
+        const void* rangeFunc;                  ///< parallelFor() function
+        RangeInvoker rangeInvoker;              ///< Calls rangeFunc
+        std::size_t begin;                      ///< First index of the chunk
+        std::size_t end;                        ///< One-past-last index of the chunk
+        std::atomic<std::size_t>* remaining;    ///< Counter of unfinished chunks
+        std::atomic<unsigned int> dependencies; ///< Unfinished dependencies, plus one until submitted
+        std::atomic<bool> done;                 ///< Has the task finished?
+        std::mutex mutex;                       ///< Mutex for the dependents
+        std::vector<TaskHandle> dependents;     ///< Tasks waiting for this one
+    };
+
+    // Double-ended task queue on a ring buffer. Only allocates when it grows
+    struct ThreadPool::TaskQueue
+    {
+        TaskQueue()
+            : tasks (),
+              head  (0),
+              count (0)
+        {}
+
+        bool empty() const
+        {
+            return count == 0;
+        }
+
+        void pushBack(TaskHandle task)
+        {
+            if (count == tasks.size())
+            {
+                std::vector<TaskHandle> grown(std::max(std::size_t(16), tasks.size() * 2));
+
+                for (std::size_t i = 0; i < count; ++i)
+                    grown[i] = std::move(tasks[(head + i) % tasks.size()]);
+
+                tasks.swap(grown);
+                head = 0;
+            }
+
+            tasks[(head + count++) % tasks.size()] = std::move(task);
+        }
+
+        TaskHandle popBack()
+        {
+            return std::move(tasks[(head + --count) % tasks.size()]);
+        }
+
+        TaskHandle popFront()
+        {
+            TaskHandle task = std::move(tasks[head]);
+
+            head = (head + 1) % tasks.size();
+            --count;
+
+            return task;
+        }
+
+        std::vector<TaskHandle> tasks;  ///< Ring buffer
+        std::size_t head;               ///< Index of the first task
+        std::size_t count;              ///< Amount of queued tasks
+    };
+
+    struct ThreadPool::Worker
+    {
+        TaskQueue tasks;    ///< Task deque. The owner uses the back, thieves the front
+        std::mutex mutex;   ///< Mutex for the deque
+    };
+
+    //////////////////////////////////////////////
+
+    ThreadPool::ThreadPool(const unsigned int threads, const Thread::Priority priority, const bool pinThreads)
+        : m_workers     (),
+          m_threads     (),
+          m_shared      (std::make_unique<TaskQueue>()),
+          m_sharedMutex (),
+          m_sleepMutex  (),
+          m_wakeCond    (),
+          m_queued      (0),
+          m_quit        (false)
+    {
+        // Every deque must exist before the first worker starts stealing
+        m_workers.reserve(threads);
+
+        for (unsigned int i = 0; i < threads; ++i)
+            m_workers.emplace_back(std::make_unique<Worker>());
+
+        const unsigned int cores = std::min(std::max(std::thread::hardware_concurrency(), 1u), 64u);
+
+        m_threads.reserve(threads);
+
+        for (unsigned int i = 0; i < threads; ++i)
+        {
+            m_threads.emplace_back(&ThreadPool::work, this, static_cast<std::size_t>(i));
+
+            if (priority != Thread::Priority::Normal && !m_threads.back().setPriority(priority))
+                JOP_DEBUG_WARNING("Failed to set the priority of worker thread " << i);
+
+            // The first processor is left for the thread that created the pool
+            if (pinThreads && !m_threads.back().setAffinity(uint64(1) << ((i + 1) % cores)))
+                JOP_DEBUG_WARNING("Failed to set the processor affinity of worker thread " << i);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        m_quit = true;
+
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+
+        m_wakeCond.notify_all();
+        m_threads.clear();
+    }
+
+    //////////////////////////////////////////////
+
+    ThreadPool::TaskHandle ThreadPool::submit(TaskFunc func, const std::vector<TaskHandle>& dependencies)
+    {
+        auto task = std::allocate_shared<Task>(TaskAllocator<Task>(), std::move(func));
+
+        for (auto& i : dependencies)
+        {
+            if (!i)
+                continue;
+
+            std::lock_guard<std::mutex> lock(i->mutex);
+
+            if (!i->done)
+            {
+                ++task->dependencies;
+                i->dependents.push_back(task);
+            }
+        }
+
+        if (--task->dependencies == 0)
+            schedule(task);
+
+        return task;
+    }
+
+    //////////////////////////////////////////////
+
+    void ThreadPool::wait(const TaskHandle& task)
+    {
+        if (!task)
+            return;
+
+        while (!task->done)
+        {
+            if (!runOne())
+                std::this_thread::yield();
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    bool ThreadPool::isDone(const TaskHandle& task)
+    {
+        return !task || task->done;
+    }
+
+    //////////////////////////////////////////////
+
+    void ThreadPool::parallelForImpl(const std::size_t count, const std::size_t grain, const void* func, RangeInvoker invoker)
+    {
+        if (!count)
+            return;
+
+        // A few chunks per thread, so that uneven chunks balance out
+        const std::size_t parts = (m_workers.size() + 1) * 4;
+        const std::size_t chunkSize = std::max(std::max(grain, std::size_t(1)), (count + parts - 1) / parts);
+        const std::size_t chunks = (count + chunkSize - 1) / chunkSize;
+
+        if (m_workers.empty() || chunks < 2)
+        {
+            invoker(func, 0, count);
+            return;
+        }
+
+        std::atomic<std::size_t> remaining(chunks - 1);
+
+        for (std::size_t i = 1; i < chunks; ++i)
+        {
+            const std::size_t begin = i * chunkSize;
+            const std::size_t end = std::min(begin + chunkSize, count);
+
+            schedule(std::allocate_shared<Task>(TaskAllocator<Task>(), func, invoker, begin, end, remaining));
+        }
+
+        // The first chunk is processed right away. Stolen chunks may still be
+        // running after this, so keep helping until they're done
+        invoker(func, 0, std::min(chunkSize, count));
+
+        while (remaining > 0)
+        {
+            if (!runOne())
+                std::this_thread::yield();
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    unsigned int ThreadPool::getThreadCount() const
+    {
+        return static_cast<unsigned int>(m_threads.size());
+    }
+
+    //////////////////////////////////////////////
+
+    ThreadPool& ThreadPool::getDefault()
+    {
+        static ThreadPool pool([]() -> unsigned int
+        {
+            const unsigned int threads = SettingManager::get<unsigned int>("engine@Threading|uWorkerThreads", 0);
+
+            return threads ? threads : std::max(std::thread::hardware_concurrency(), 1u) - 1;
+        }(),
+        static_cast<Thread::Priority>(std::min(SettingManager::get<unsigned int>("engine@Threading|uWorkerPriority", 2), 4u)),
+        SettingManager::get<bool>("engine@Threading|bPinWorkerThreads", false));
+
+        return pool;
+    }
+
+    //////////////////////////////////////////////
+
+    void ThreadPool::work(const std::size_t index)
+    {
+        ns_pool = this;
+        ns_worker = index;
+
+        while (!m_quit)
+        {
+            if (runOne())
+                continue;
+
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wakeCond.wait(lock, [this]() { return m_quit || m_queued > 0; });
+        }
+    }
+
+    //////////////////////////////////////////////
+
+    void ThreadPool::schedule(TaskHandle task)
+    {
+        // Without workers there's nobody to pick the task up later
+        if (m_workers.empty())
+        {
+            run(task);
+            return;
+        }
+
+        // Counted before the task becomes visible, so that a thief can't decrement first
+        if (ns_pool == this)
+        {
+            auto& worker = *m_workers[ns_worker];
+
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            ++m_queued;
+            worker.tasks.pushBack(std::move(task));
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_sharedMutex);
+            ++m_queued;
+            m_shared->pushBack(std::move(task));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+
+        m_wakeCond.notify_one();
+    }
+
+    //////////////////////////////////////////////
+
+    bool ThreadPool::runOne()
+    {
+        auto task = findTask();
+
+        if (!task)
+            return false;
+
+        --m_queued;
+        run(task);
+
+        return true;
+    }
+
+    //////////////////////////////////////////////
+
+    ThreadPool::TaskHandle ThreadPool::findTask()
+    {
+        TaskHandle task;
+        const bool isWorker = ns_pool == this;
+
+        // Own deque, newest first
+        if (isWorker)
+        {
+            auto& worker = *m_workers[ns_worker];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+
+            if (!worker.tasks.empty())
+                return worker.tasks.popBack();
+        }
+
+        // Tasks from outside the pool
+        {
+            std::lock_guard<std::mutex> lock(m_sharedMutex);
+
+            if (!m_shared->empty())
+                return m_shared->popFront();
+        }
+
+        // Steal the oldest task of another worker, starting from the next one
+        const std::size_t start = isWorker ? ns_worker + 1 : 0;
+
+        for (std::size_t i = 0; i < m_workers.size(); ++i)
+        {
+            auto& victim = *m_workers[(start + i) % m_workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+
+            if (!victim.tasks.empty())
+                return victim.tasks.popFront();
+        }
+
+        return task;
+    }
+
+    //////////////////////////////////////////////
+
+    void ThreadPool::run(const TaskHandle& task)
+    {
+        if (task->rangeInvoker)
+        {
+            // Nothing can depend on a chunk
+            task->rangeInvoker(task->rangeFunc, task->begin, task->end);
+            --*task->remaining;
+
+            return;
+        }
+
+        task->func();
+        task->func = nullptr;
+
+        std::vector<TaskHandle> dependents;
+
+        {
+            std::lock_guard<std::mutex> lock(task->mutex);
+
+            task->done = true;
+            dependents.swap(task->dependents);
+        }
+
+        for (auto& i : dependents)
+        {
+            if (--i->dependencies == 0)
+                schedule(std::move(i));
+        }
+    }
+}
\ No newline at end of file
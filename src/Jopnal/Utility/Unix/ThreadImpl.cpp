@@ -28,29 +28,81 @@
 
 #include <Jopnal/Utility/Unix/ThreadImpl.hpp>
 #include <pthread.h>
+#include <sched.h>
 
 //////////////////////////////////////////////
 
 
-namespace
+namespace jop { namespace detail
 {
-    const int ns_enums[] =
+    bool ThreadDetail::setPriority(std::thread& thread, const unsigned int priority)
     {
-        10,
-        5,
-        0,
-        -5,
-        -10
-    };
-}
+        sched_param param = {};
 
-namespace jop { namespace detail
-{
-    bool ThreadDetail::setPriority(std::thread& /*thread*/, const unsigned int /*priority*/)
+    #if defined(SCHED_IDLE) && defined(SCHED_BATCH)
+
+        // Linux ignores the priority value with SCHED_OTHER, so the policy is changed instead
+        static const int policies[] =
+        {
+            SCHED_IDLE,
+            SCHED_BATCH,
+            SCHED_OTHER,
+            SCHED_RR,
+            SCHED_RR
+        };
+
+        const int policy = policies[priority];
+
+        if (policy == SCHED_RR)
+        {
+            const int min = sched_get_priority_min(SCHED_RR);
+            param.sched_priority = priority == 3 ? min : (min + sched_get_priority_max(SCHED_RR)) / 2;
+        }
+
+    #else
+
+        int policy = SCHED_OTHER;
+
+        if (pthread_getschedparam(thread.native_handle(), &policy, &param) != 0)
+            return false;
+
+        const int min = sched_get_priority_min(policy);
+        param.sched_priority = min + (sched_get_priority_max(policy) - min) * static_cast<int>(priority) / 4;
+
+    #endif
+
+        return pthread_setschedparam(thread.native_handle(), policy, &param) == 0;
+    }
+
+    //////////////////////////////////////////////
+
+    bool ThreadDetail::setAffinity(std::thread& thread, const uint64 mask)
     {
-        //return pthread_setschedprio(thread.native_handle(), ns_enums[priority]) == 0;
+    #if defined(JOP_OS_LINUX) || defined(JOP_OS_ANDROID)
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+
+        for (unsigned int i = 0; i < 64 && i < CPU_SETSIZE; ++i)
+        {
+            if ((mask >> i) & 1)
+                CPU_SET(i, &set);
+        }
+
+        #ifdef JOP_OS_ANDROID
+            return sched_setaffinity(pthread_gettid_np(thread.native_handle()), sizeof(set), &set) == 0;
+        #else
+            return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+        #endif
+
+    #else
+
+        static_cast<void>(thread);
+        static_cast<void>(mask);
 
         return false;
+
+    #endif
     }
     
     //////////////////////////////////////////////
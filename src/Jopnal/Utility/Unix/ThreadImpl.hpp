@@ -40,6 +40,8 @@ namespace jop { namespace detail
     
         static bool setPriority(std::thread& thread, const unsigned int priority);
 
+        static bool setAffinity(std::thread& thread, const uint64 mask);
+
         static void terminate(std::thread& thread);
     };
 }}
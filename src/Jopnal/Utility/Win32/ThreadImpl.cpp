@@ -57,6 +57,13 @@ namespace jop { namespace detail
     
     //////////////////////////////////////////////
 
+    bool ThreadDetail::setAffinity(std::thread& thread, const uint64 mask)
+    {
+        return SetThreadAffinityMask(thread.native_handle(), static_cast<DWORD_PTR>(mask)) != 0;
+    }
+
+    //////////////////////////////////////////////
+
     void ThreadDetail::terminate(std::thread& thread)
     {
         TerminateThread(thread.native_handle(), 0);
@@ -42,6 +42,7 @@
     #include <jni.h>
     #include <EGL/eglext.h>
     #include <unordered_map>
+    #include <thread>
     #include <glm/vec2.hpp>
 
 #endif
@@ -337,6 +338,23 @@ namespace jop { namespace detail
 
     //////////////////////////////////////////////
 
+    void WindowImpl::waitEvents(const float timeout)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<long long>(timeout * 1000000.f)));
+        pollEvents();
+    }
+
+    //////////////////////////////////////////////
+
+    bool WindowImpl::hasFocus() const
+    {
+        auto state = ActivityState::get();
+
+        return state && state->fullFocus;
+    }
+
+    //////////////////////////////////////////////
+
     void WindowImpl::setMouseMode(const Mouse::Mode)
     {}
 
@@ -33,6 +33,7 @@
     #include <Jopnal/Graphics/OpenGL/OpenGL.hpp>
     #include <Jopnal/Graphics/OpenGL/GlCheck.hpp>
     #include <GLFW/glfw3.h>
+    #include <thread>
 
     #define GLFW_EXPOSE_NATIVE_WIN32
     #include <GLFW/glfw3native.h>
@@ -228,6 +229,31 @@ namespace jop { namespace detail
         glfwPollEvents();
     }
 
+    //////////////////////////////////////////////
+
+    void WindowImpl::waitEvents(const float timeout)
+    {
+    #if GLFW_VERSION_MAJOR > 3 || (GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR >= 2)
+
+        glfwWaitEventsTimeout(static_cast<double>(timeout));
+
+    #else
+
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<long long>(timeout * 1000000.f)));
+        glfwPollEvents();
+
+    #endif
+    }
+
+    //////////////////////////////////////////////
+
+    bool WindowImpl::hasFocus() const
+    {
+        return glfwGetWindowAttrib(m_window, GLFW_FOCUSED) != 0 && glfwGetWindowAttrib(m_window, GLFW_ICONIFIED) == 0;
+    }
+
+    //////////////////////////////////////////////
+
     void WindowImpl::setMouseMode(const Mouse::Mode mode)
     {
         static const int modes[] = 
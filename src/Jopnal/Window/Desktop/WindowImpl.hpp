@@ -56,6 +56,10 @@ namespace jop { namespace detail
 
         static void pollEvents();
 
+        static void waitEvents(const float timeout);
+
+        bool hasFocus() const;
+
         void setMouseMode(const Mouse::Mode mode);
 
         void setPosition(const int x, const int y);
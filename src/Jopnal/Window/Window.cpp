@@ -103,19 +103,17 @@ namespace jop
     {
         BufferSwapper::BufferSwapper(Window& window)
             : Subsystem     (0),
-              m_frameClock  (),
               m_windowRef   (window)
-        {}
+        {
+            // Swapping only waits for the graphics driver, the next frame can be simulated meanwhile
+            setAffinity(Stage::Draw, Affinity::Concurrent);
+        }
 
         //////////////////////////////////////////////
 
         void BufferSwapper::draw()
         {
-            static const DynamicSetting<unsigned int> frameLimit("engine@DefaultWindow|uFrameLimit", 0);
-
-            if (frameLimit.value > 0)
-                std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<long long>((1.f / frameLimit.value - m_frameClock.reset().asSeconds()) * 1000.f)));
-
+            // The frame rate is limited by the engine
             if (m_windowRef.isOpen())
             {
                 if (Engine::getState() != Engine::State::Frozen)
@@ -125,8 +123,6 @@ namespace jop
                 {
                     if (ActivityState::get()->fullFocus)
                         m_windowRef.m_impl->swapBuffers();
-                    else
-                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
                 }
 
             #else
@@ -178,7 +174,10 @@ namespace jop
           m_impl            (),
           m_eventHandler    (),
           m_vertexArray     (0)
-    {}
+    {
+        setAffinity(Stage::PreUpdate, Affinity::Render);
+        setAffinity(Stage::PostUpdate, Affinity::Render);
+    }
 
     Window::Window(const Settings& settings)
         : RenderTarget      (),
@@ -187,6 +186,9 @@ namespace jop
           m_eventHandler    (),
           m_vertexArray     (0)
     {
+        setAffinity(Stage::PreUpdate, Affinity::Render);
+        setAffinity(Stage::PostUpdate, Affinity::Render);
+
         open(settings);
         setDefaultEventHandler();
 
@@ -313,7 +315,7 @@ namespace jop
         if (gl::getVersionMajor() >= 3)
         {
             glCheck(glGenVertexArrays(1, &m_vertexArray));
-            glCheck(glBindVertexArray(m_vertexArray));
+            GlState::setDefaultVertexArray(m_vertexArray);
         }
 
     #endif
@@ -333,7 +335,7 @@ namespace jop
 
         if (gl::getVersionMajor() >= 3)
         {
-            glCheck(glBindVertexArray(0));
+            GlState::setDefaultVertexArray(0);
             glCheck(glDeleteVertexArrays(1, &m_vertexArray));
         }
 
@@ -353,6 +355,15 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    bool Window::hasFocus() const
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+        return isOpen() && m_impl->hasFocus();
+    }
+
+    //////////////////////////////////////////////
+
     void Window::setDefaultEventHandler()
     {
         setEventHandler<jop_DefaultEventHandler>();
@@ -409,6 +420,13 @@ namespace jop
 
     //////////////////////////////////////////////
 
+    void Window::waitEvents(const float timeout)
+    {
+        detail::WindowImpl::waitEvents(timeout);
+    }
+
+    //////////////////////////////////////////////
+
     void Window::setMouseMode(const Mouse::Mode mode)
     {
         std::lock_guard<std::recursive_mutex> lock(m_mutex);
@@ -465,7 +483,7 @@ namespace jop
 
     Message::Result Window::receiveMessage(const Message& message)
     {
-        if (JOP_EXECUTE_COMMAND(Window, message.getString(), this) == Message::Result::Escape)
+        if (JOP_EXECUTE_COMMAND(Window, message, this) == Message::Result::Escape)
             return Message::Result::Escape;
 
         return Subsystem::receiveMessage(message);
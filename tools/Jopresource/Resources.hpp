@@ -18,13 +18,15 @@ extern const unsigned char defaultShaderFrag[266];
 
 extern const unsigned char defaultShaderVert[466];
 
-extern const unsigned char defaultUberShaderFrag[6147];
+extern const unsigned char defaultUberShaderFrag[6724];
 
-extern const unsigned char defaultUberShaderVert[2845];
+extern const unsigned char defaultUberShaderVert[4230];
 
-extern const unsigned char depthRecordShaderFrag[811];
+extern const unsigned char depthRecordShaderFrag[1419];
 
-extern const unsigned char depthRecordShaderVert[627];
+extern const unsigned char depthRecordShaderVert[1143];
+
+extern const unsigned char depthRecordShaderGeom[810];
 
 extern const unsigned char gaussianBlurShaderFrag[1354];
 
@@ -40,11 +42,11 @@ extern const unsigned char brightFilter[1632];
 
 extern const unsigned char compatibilityPlugins[2059];
 
-extern const unsigned char lightingPlugins[6920];
+extern const unsigned char lightingPlugins[11827];
 
-extern const unsigned char structurePlugins[1640];
+extern const unsigned char structurePlugins[4418];
 
-extern const unsigned char shadowPlugins[4319];
+extern const unsigned char shadowPlugins[6363];
 
 }
 #endif
\ No newline at end of file
@@ -133,7 +133,7 @@ void main()
                     // Shadow calculation
                     float shadow = 1.0;
                     if (u_PointLights[i].castShadow && u_ReceiveShadows)
-                        shadow -= jop_CalculatePointShadow(u_PointLights[i].position - vf_Position, u_PointLights[i].farPlane, u_PointLightShadowMaps[i]);
+                        shadow -= jop_CalculatePointShadow(u_InvViewRotation * (vf_Position - u_PointLights[i].position), u_PointLights[i].farPlane, u_PointLightShadowMaps[i]);
 
                     tempLight[0] += light[0];
                     tempLight[1] += light[1] * shadow;
@@ -152,7 +152,7 @@ void main()
                     // Shadow calculation
                     float shadow = 1.0;
                     if (u_DirectionalLights[i].castShadow && u_ReceiveShadows)
-                        shadow -= jop_CalculateDirSpotShadow(vec3(u_DirectionalLights[i].lsMatrix * vec4(vf_Position, 1.0)) * 0.5 + 0.5, vf_Normal, -u_DirectionalLights[i].direction,  u_DirectionalLightShadowMaps[i]);
+                        shadow -= jop_CalculateCascadedShadow(u_DirectionalLights[i], vf_Normal, u_DirectionalLightShadowMaps[i]);
 
                     tempLight[0] += light[0];
                     tempLight[1] += light[1] * shadow;
@@ -173,7 +173,7 @@ void main()
                     if (u_SpotLights[i].castShadow && u_ReceiveShadows)
                     {
                         vec4 tempCoords = u_SpotLights[i].lsMatrix * vec4(vf_Position, 1.0);
-                        shadow -= jop_CalculateDirSpotShadow((tempCoords.xyz / tempCoords.w) * 0.5 + 0.5, vf_Normal, u_SpotLights[i].position - vf_Position, u_SpotLightShadowMaps[i]);
+                        shadow -= jop_CalculateDirSpotShadow((tempCoords.xyz / tempCoords.w) * 0.5 + 0.5, vf_Normal, u_SpotLights[i].position - vf_Position, u_SpotLightShadowMaps[i], vec2(0.0, 1.0));
                     }
                     
                     tempLight[0] += light[0];
@@ -181,6 +181,22 @@ void main()
                     tempLight[2] += light[2] * shadow;
                 }
 
+            #endif
+
+            #ifdef JOP_CLUSTERED_LIGHTS
+
+                // Clustered point & spot lights
+                ivec2 cluster = jop_GetLightCluster((gl_FragCoord.xy - u_ClusterViewport.xy) * u_ClusterViewport.zw, -vf_Position.z);
+
+                for (int i = 0; i < cluster.y; ++i)
+                {
+                    jop_CalculateClusteredLight(jop_GetClusteredLightIndex(cluster.x + i), shininessMult, light[0], light[1], light[2]);
+
+                    tempLight[0] += light[0];
+                    tempLight[1] += light[1];
+                    tempLight[2] += light[2];
+                }
+
             #endif
             }
 
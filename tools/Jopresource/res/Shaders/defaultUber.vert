@@ -13,10 +13,32 @@ JOP_ATTRIBUTE(1) vec2 a_TexCoords;
 JOP_ATTRIBUTE(2) vec3 a_Normal;
 JOP_ATTRIBUTE(3) vec4 a_Color;
 
-// Matrices
-uniform mat4 u_VMMatrix;
-uniform mat4 u_PVMMatrix;
-uniform mat3 u_NMatrix;
+#ifdef JDRW_INSTANCED
+
+    // Per-instance model matrix, occupies locations 4-7
+    JOP_ATTRIBUTE(4) mat4 a_MMatrix;
+
+    #ifdef JOP_CAMERA_BLOCK
+
+        // View & projection matrices are read from jop_CameraBlock
+        #include <Jopnal/Camera/Block>
+
+    #else
+
+        // Matrices
+        uniform mat4 u_VMatrix;
+        uniform mat4 u_PMatrix;
+
+    #endif
+
+#else
+
+    // Matrices
+    uniform mat4 u_VMMatrix;
+    uniform mat4 u_PVMMatrix;
+    uniform mat3 u_NMatrix;
+
+#endif
 
 // Vertex attributes to fragment shader
 JOP_VARYING_OUT vec3 vf_Position;
@@ -44,18 +66,33 @@ JOP_VARYING_OUT vec4 vf_Color;
 
 void main()
 {
+#ifdef JDRW_INSTANCED
+    #ifdef JOP_CAMERA_BLOCK
+        mat4 vmMatrix = u_ViewMatrix * a_MMatrix;
+        mat4 pvmMatrix = u_ProjectionMatrix * vmMatrix;
+    #else
+        mat4 vmMatrix = u_VMatrix * a_MMatrix;
+        mat4 pvmMatrix = u_PMatrix * vmMatrix;
+    #endif
+    mat3 nMatrix = transpose(inverse(mat3(vmMatrix)));
+#else
+    mat4 vmMatrix = u_VMMatrix;
+    mat4 pvmMatrix = u_PVMMatrix;
+    mat3 nMatrix = u_NMatrix;
+#endif
+
     // Assign attributes
     vf_Position     = (
     #if !defined(JDRW_SKYBOX) && !defined(JDRW_SKYSPHERE)
-        u_VMMatrix * 
+        vmMatrix * 
     #endif
                       a_Position).xyz;
     vf_TexCoords    = a_TexCoords;
-    vf_Normal       = normalize(u_NMatrix * a_Normal);
+    vf_Normal       = normalize(nMatrix * a_Normal);
     vf_Color        = a_Color;
 
     // Calculate and assign position
-    gl_Position = (u_PVMMatrix * a_Position)
+    gl_Position = (pvmMatrix * a_Position)
     
     #if (defined(JDRW_SKYBOX) || defined(JDRW_SKYSPHERE))
         .xyww
@@ -109,6 +146,21 @@ void main()
                 vf_SpecLight += light[2];
             }
 
+        #endif
+
+        #ifdef JOP_CLUSTERED_LIGHTS
+
+            // Clustered point & spot lights
+            ivec2 cluster = jop_GetLightCluster((gl_Position.xy / gl_Position.w) * 0.5 + 0.5, -vf_Position.z);
+
+            for (int i = 0; i < cluster.y; ++i)
+            {
+                jop_CalculateClusteredLight(jop_GetClusteredLightIndex(cluster.x + i), 1.0, light[0], light[1], light[2]);
+
+                vf_AmbDiffLight += light[0] + light[1];
+                vf_SpecLight += light[2];
+            }
+
         #endif
         }
 
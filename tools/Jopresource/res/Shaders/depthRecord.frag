@@ -4,6 +4,20 @@
 
 //////////////////////////////////////////////
 
+#include <Jopnal/Compat/Varyings>
+
+#ifdef JOP_LINEAR_DEPTH
+
+    // Light position in world space
+    uniform vec3 u_LightPosition;
+
+    // The light's far plane
+    uniform float u_FarClippingPlane;
+
+    JOP_VARYING_IN vec3 vf_WorldPosition;
+
+#endif
+
 #ifdef JOP_PACK_DEPTH
 
     varying vec4 vf_Position;
@@ -14,6 +28,18 @@ void main()
 {
     // Depth recording happens automatically, unless depth textures are unsupported,
     // in which case we'll need to pack the texture into a regular RGBA texture.
+    //
+    // Point lights store the linear distance to the light, mapped to [0,1]
+
+#if defined(JOP_LINEAR_DEPTH)
+
+    float depth = length(vf_WorldPosition - u_LightPosition) / u_FarClippingPlane;
+
+#elif defined(JOP_PACK_DEPTH)
+
+    float depth = (vf_Position.z / vf_Position.w + 1.0) * 0.5;
+
+#endif
 
 #ifdef JOP_PACK_DEPTH
         
@@ -32,10 +58,14 @@ void main()
         1.0 / 256.0
     );
 
-    vec4 comp = fract((vPosition.z / vPosition.w + 1.0) * 0.5 * bitShift);
+    vec4 comp = fract(depth * bitShift);
     comp -= comp.xxyz * bitMask;
     
     gl_FragColor = comp;
 
+#elif defined(JOP_LINEAR_DEPTH)
+
+    gl_FragDepth = depth;
+
 #endif
 }
\ No newline at end of file
@@ -5,27 +5,52 @@
 //////////////////////////////////////////////
 
 #include <Jopnal/Compat/Attributes>
+#include <Jopnal/Compat/Varyings>
 
 // Perspective-view (light space) matrix
 uniform mat4 u_PVMatrix;
 
 // Model matrix
-uniform mat4 a_MMatrix;
+uniform mat4 u_MMatrix;
 
 // Position attribute
 JOP_ATTRIBUTE(0) vec3 a_Position;
 
-// No need for compatibility layer, this will only happen
-// on GLES 2.0
-#ifdef JOP_PACK_DEPTH
-    varying vec4 vf_Position;
+#ifndef JOP_LAYERED
+
+    // World position, used for linear (point light) depth
+    #ifdef JOP_LINEAR_DEPTH
+        JOP_VARYING_OUT vec3 vf_WorldPosition;
+    #endif
+
+    // No need for compatibility layer, this will only happen
+    // on GLES 2.0
+    #ifdef JOP_PACK_DEPTH
+        varying vec4 vf_Position;
+    #endif
+
 #endif
 
 void main()
 {
-    gl_Position = u_PVMatrix * a_MMatrix * vec4(a_Position, 1.0);
+    vec4 worldPosition = u_MMatrix * vec4(a_Position, 1.0);
+
+#ifdef JOP_LAYERED
+
+    // The geometry shader does the projection for each cube face
+    gl_Position = worldPosition;
+
+#else
+
+    gl_Position = u_PVMatrix * worldPosition;
+
+    #ifdef JOP_LINEAR_DEPTH
+        vf_WorldPosition = worldPosition.xyz;
+    #endif
 
     #ifdef JOP_PACK_DEPTH
         vf_Position = gl_Position;
     #endif
+
+#endif
 }
\ No newline at end of file